@@ -29,8 +29,10 @@
 #include "BitmapImage.h"
 
 #include "CairoUtilities.h"
+#include "DisplayList.h"
 #include "ImageObserver.h"
 #include "PlatformContextCairo.h"
+#include "ScaledImageCache.h"
 #include <cairo.h>
 
 namespace WebCore {
@@ -45,11 +47,26 @@ BitmapImage::BitmapImage(PassRefPtr<cairo_surface_t> nativeImage, ImageObserver*
     , m_repetitionCountStatus(Unknown)
     , m_repetitionsComplete(0)
     , m_decodedSize(0)
+    , m_frameDecodeWallTime(0)
+    , m_timeToFirstPixels(0)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    , m_maxDecodedPixels(ImageSource::maxPixelsPerDecodedImage())
+#endif
+#if ENABLE(THREADED_IMAGE_DECODING)
+    , m_decoderGeneration(0)
+    , m_animationLookAhead(0)
+#endif
     , m_frameCount(1)
     , m_isSolidColor(false)
     , m_checkedForSolidColor(false)
     , m_animationFinished(true)
     , m_allDataReceived(true)
+#if ENABLE(THREADED_IMAGE_DECODING)
+    , m_asynchronousDecodePending(false)
+    , m_animationLookAheadPending(false)
+    , m_animationWaitingForFrame(false)
+    , m_animationLookAheadFailed(false)
+#endif
     , m_haveSize(true)
     , m_sizeAvailable(true)
     , m_haveFrameCount(true)
@@ -76,6 +93,11 @@ void BitmapImage::draw(GraphicsContext* context, const FloatRect& dst, const Flo
 
     startAnimation();
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    FloatRect deviceDst = context->getCTM().mapRect(dst);
+    updateDecodedResolution(static_cast<double>(deviceDst.width()) * deviceDst.height() * size().width() * size().height() / fabs(src.width() * src.height()));
+#endif
+
     RefPtr<cairo_surface_t> surface = frameAtIndex(m_currentFrame);
     if (!surface) // If it's too early we won't have an image yet.
         return;
@@ -118,6 +140,23 @@ void BitmapImage::draw(GraphicsContext* context, const FloatRect& dst, const Flo
         }
     }
 
+    // Decoded, complete frames never change, so a large image drawn much
+    // smaller can be drawn from a reduced copy. Animations would only churn
+    // the cache, and pixelated drawing wants the original pixels.
+    if (m_source.initialized() && frameCount() == 1 && frameIsCompleteAtIndex(m_currentFrame)
+        && context->imageInterpolationQuality() != InterpolationNone) {
+        AffineTransform ctm = context->getCTM();
+        float scale = std::min(ctm.xScale() * dstRect.width() / adjustedSrcRect.width(), ctm.yScale() * dstRect.height() / adjustedSrcRect.height());
+        if (RefPtr<cairo_surface_t> scaledSurface = ScaledImageCache::shared().scaledSurface(surface.get(), fabs(scale), context->imageInterpolationQuality(), adjustedSrcRect))
+            surface = scaledSurface.release();
+    }
+
+#if USE(DISPLAY_LISTS)
+    // The decoder keeps writing into the buffer of a partial frame.
+    if (!frameIsCompleteAtIndex(m_currentFrame) && DisplayList::isRecordingContext(context))
+        surface = copyCairoImageSurface(surface.get());
+#endif
+
     context->platformContext()->drawSurfaceToContext(surface.get(), dstRect, adjustedSrcRect, context);
 
     context->restore();
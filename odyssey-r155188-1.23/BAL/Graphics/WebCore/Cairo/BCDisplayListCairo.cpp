@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+#if USE(DISPLAY_LISTS)
+
+#include "GraphicsContext.h"
+#include "PlatformContextCairo.h"
+#include <cairo.h>
+#include <wtf/PassOwnPtr.h>
+
+namespace WebCore {
+
+PassRefPtr<DisplayList> DisplayList::create(const IntRect& bounds)
+{
+    return adoptRef(new DisplayList(bounds));
+}
+
+DisplayList::DisplayList(const IntRect& bounds)
+    : m_bounds(bounds)
+{
+    cairo_rectangle_t extents = { static_cast<double>(bounds.x()), static_cast<double>(bounds.y()),
+        static_cast<double>(bounds.width()), static_cast<double>(bounds.height()) };
+    m_recording = adoptRef(cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents));
+}
+
+DisplayList::~DisplayList()
+{
+    ASSERT(!isRecording());
+}
+
+GraphicsContext* DisplayList::beginRecording()
+{
+    ASSERT(!isRecording());
+    m_recordingContext = adoptRef(cairo_create(m_recording.get()));
+    m_context = adoptPtr(new GraphicsContext(m_recordingContext.get()));
+    return m_context.get();
+}
+
+void DisplayList::endRecording()
+{
+    ASSERT(isRecording());
+    m_context.clear();
+    // The recording surface only keeps the commands, not the context state.
+    m_recordingContext.clear();
+}
+
+void DisplayList::replay(GraphicsContext* context) const
+{
+    if (context->paintingDisabled())
+        return;
+
+    PlatformContextCairo* platformContext = context->platformContext();
+    cairo_t* cr = platformContext->cr();
+    cairo_save(cr);
+    cairo_set_source_surface(cr, m_recording.get(), 0, 0);
+    cairo_rectangle(cr, m_bounds.x(), m_bounds.y(), m_bounds.width(), m_bounds.height());
+    cairo_clip(cr);
+    cairo_paint_with_alpha(cr, platformContext->globalAlpha());
+    cairo_restore(cr);
+}
+
+void DisplayList::replay(cairo_t* cr) const
+{
+    ASSERT(!isRecording());
+    cairo_save(cr);
+    cairo_set_source_surface(cr, m_recording.get(), 0, 0);
+    cairo_rectangle(cr, m_bounds.x(), m_bounds.y(), m_bounds.width(), m_bounds.height());
+    cairo_clip(cr);
+    cairo_paint(cr);
+    cairo_restore(cr);
+}
+
+bool DisplayList::isRecordingContext(GraphicsContext* context)
+{
+    if (context->paintingDisabled())
+        return false;
+    return cairo_surface_get_type(cairo_get_target(context->platformContext()->cr())) == CAIRO_SURFACE_TYPE_RECORDING;
+}
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LISTS)
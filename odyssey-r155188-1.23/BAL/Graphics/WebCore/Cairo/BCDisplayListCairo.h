@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef DisplayList_h
+#define DisplayList_h
+
+#if USE(DISPLAY_LISTS)
+
+#include "IntRect.h"
+#include "RefPtrCairo.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+
+typedef struct _cairo cairo_t;
+typedef struct _cairo_surface cairo_surface_t;
+
+namespace WebCore {
+
+class GraphicsContext;
+
+// Drawing commands captured through a GraphicsContext, so that they can be
+// replayed later, under another transformation or on another thread,
+// without walking the render tree again.
+//
+// Every GraphicsContext operation of this port ends up as Cairo paths,
+// patterns, glyph runs, clips and transformations, which a Cairo recording
+// surface stores as they are; images drawn while recording are kept as
+// copy-on-write snapshots. Replaying goes through the vector commands, so
+// a list replayed at a larger scale stays sharp.
+//
+// Lists are created, recorded and destroyed on the main thread. Once
+// recording has ended, replay(cairo_t*) may be called on any thread as long
+// as the main thread holds a reference to the list.
+//
+// Cairo only snapshots images when they are modified through Cairo. Images
+// whose pixels are written to directly must not be modified while a list is
+// replayed on another thread, so they are copied when drawn into a list:
+// frames that are still being decoded share the decoder's buffer, and
+// ImageBuffers are written by putImageData() and filters.
+class DisplayList : public RefCounted<DisplayList> {
+public:
+    // Commands outside |bounds|, in the coordinates of the recording
+    // context, are dropped.
+    static PassRefPtr<DisplayList> create(const IntRect& bounds);
+    ~DisplayList();
+
+    const IntRect& bounds() const { return m_bounds; }
+
+    // Returns the context to paint into until endRecording() is called. It
+    // starts out with an identity transformation and no clip.
+    GraphicsContext* beginRecording();
+    void endRecording();
+    bool isRecording() const { return m_context; }
+
+    // Draws the commands with the transformation, clip, operator and alpha
+    // of the given context.
+    void replay(GraphicsContext*) const;
+    void replay(cairo_t*) const;
+
+    // Whether the context records into a display list, so that the images
+    // drawn into it must not change afterwards.
+    static bool isRecordingContext(GraphicsContext*);
+
+private:
+    explicit DisplayList(const IntRect&);
+
+    IntRect m_bounds;
+    RefPtr<cairo_surface_t> m_recording;
+    RefPtr<cairo_t> m_recordingContext;
+    OwnPtr<GraphicsContext> m_context;
+};
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LISTS)
+
+#endif // DisplayList_h
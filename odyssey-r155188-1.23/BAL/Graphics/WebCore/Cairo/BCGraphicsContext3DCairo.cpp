@@ -187,6 +187,10 @@ bool GraphicsContext3D::ImageExtractor::extractImage(bool premultiplyAlpha, bool
     if (!m_decoder)
         return false;
     ImageSource& decoder = *m_decoder;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Textures are uploaded at the image's full size.
+    decoder.setMaxDecodedPixels(0);
+#endif
 
     m_alphaOp = AlphaDoNothing;
     if (m_image->data()) {
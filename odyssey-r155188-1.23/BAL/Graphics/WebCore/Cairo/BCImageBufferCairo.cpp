@@ -32,6 +32,7 @@
 #include "BitmapImage.h"
 #include "CairoUtilities.h"
 #include "Color.h"
+#include "DisplayList.h"
 #include "GraphicsContext.h"
 #include "MIMETypeRegistry.h"
 #include "NotImplemented.h"
@@ -148,6 +149,10 @@ void ImageBuffer::draw(GraphicsContext* destinationContext, ColorSpace styleColo
     CompositeOperator op, BlendMode blendMode, bool useLowQualityScale)
 {
     BackingStoreCopy copyMode = destinationContext == context() ? CopyBackingStore : DontCopyBackingStore;
+#if USE(DISPLAY_LISTS)
+    if (DisplayList::isRecordingContext(destinationContext))
+        copyMode = CopyBackingStore;
+#endif
     RefPtr<Image> image = copyImage(copyMode);
     destinationContext->drawImage(image.get(), styleColorSpace, destRect, srcRect, op, blendMode, ImageOrientationDescription(), useLowQualityScale);
 }
@@ -155,7 +160,12 @@ void ImageBuffer::draw(GraphicsContext* destinationContext, ColorSpace styleColo
 void ImageBuffer::drawPattern(GraphicsContext* context, const FloatRect& srcRect, const AffineTransform& patternTransform,
                               const FloatPoint& phase, ColorSpace styleColorSpace, CompositeOperator op, const FloatRect& destRect)
 {
-    RefPtr<Image> image = copyImage(DontCopyBackingStore);
+    BackingStoreCopy copyMode = DontCopyBackingStore;
+#if USE(DISPLAY_LISTS)
+    if (DisplayList::isRecordingContext(context))
+        copyMode = CopyBackingStore;
+#endif
+    RefPtr<Image> image = copyImage(copyMode);
     image->drawPattern(context, srcRect, patternTransform, phase, styleColorSpace, op, destRect);
 }
 
@@ -33,6 +33,7 @@
 #include "AffineTransform.h"
 #include "CairoUtilities.h"
 #include "Color.h"
+#include "DisplayList.h"
 #include "GraphicsContext.h"
 #include "ImageObserver.h"
 #include "PlatformContextCairo.h"
@@ -44,12 +45,38 @@ namespace WebCore {
 void Image::drawPattern(GraphicsContext* context, const FloatRect& tileRect, const AffineTransform& patternTransform,
     const FloatPoint& phase, ColorSpace, CompositeOperator op, const FloatRect& destRect, BlendMode)
 {
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Backgrounds only need the image at the scale its tiles are drawn at on the device.
+    AffineTransform ctm = context->getCTM();
+    double scale = fabs(ctm.xScale() * ctm.yScale() * patternTransform.xScale() * patternTransform.yScale());
+    RefPtr<cairo_surface_t> surface = nativeImageForCurrentFrameAtResolution(static_cast<double>(size().width()) * size().height() * scale);
+#else
     RefPtr<cairo_surface_t> surface = nativeImageForCurrentFrame();
+#endif
     if (!surface) // If it's too early we won't have an image yet.
         return;
 
+#if USE(DISPLAY_LISTS)
+    // The decoder keeps writing into the buffer of a partial frame.
+    if (!currentFrameIsComplete() && DisplayList::isRecordingContext(context))
+        surface = copyCairoImageSurface(surface.get());
+#endif
+
+    IntSize imageSize = size();
+    FloatRect adjustedTileRect = tileRect;
+    AffineTransform adjustedPatternTransform = patternTransform;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    IntSize surfaceSize = cairoSurfaceSize(surface.get());
+    if (surfaceSize != imageSize && !imageSize.isEmpty()) {
+        // The frame was down-sampled, so map the tile into its pixels.
+        adjustedTileRect = adjustSourceRectForDownSampling(tileRect, surfaceSize);
+        adjustedPatternTransform.scaleNonUniform(static_cast<double>(imageSize.width()) / surfaceSize.width(), static_cast<double>(imageSize.height()) / surfaceSize.height());
+        imageSize = surfaceSize;
+    }
+#endif
+
     cairo_t* cr = context->platformContext()->cr();
-    drawPatternToCairoContext(cr, surface.get(), size(), tileRect, patternTransform, phase, toCairoOperator(op), destRect);
+    drawPatternToCairoContext(cr, surface.get(), imageSize, adjustedTileRect, adjustedPatternTransform, phase, toCairoOperator(op), destRect);
 
     if (imageObserver())
         imageObserver()->didDraw(this);
@@ -27,6 +27,7 @@
 #include "Pattern.h"
 
 #include "AffineTransform.h"
+#include "CairoUtilities.h"
 #include "GraphicsContext.h"
 #include <cairo.h>
 
@@ -38,6 +39,13 @@ cairo_pattern_t* Pattern::createPlatformPattern(const AffineTransform&) const
     if (!surface)
         return 0;
 
+#if USE(DISPLAY_LISTS)
+    // The pattern may be filled into a display list, while the decoder keeps
+    // writing into the buffer of a partial frame.
+    if (!tileImage()->currentFrameIsComplete())
+        surface = copyCairoImageSurface(surface.get());
+#endif
+
     cairo_pattern_t* pattern = cairo_pattern_create_for_surface(surface.get());
 
     // cairo merges patter space and user space itself
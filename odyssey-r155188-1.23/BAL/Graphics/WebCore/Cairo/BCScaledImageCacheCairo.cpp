@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "ScaledImageCache.h"
+
+#include "FloatRect.h"
+#include <cairo.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// Enough for the reduced copies of a page full of photos.
+static const size_t scaledImageCacheBudget = 16 * 1024 * 1024;
+// Smaller images are cheap enough to resample on every paint.
+static const int minimumSourcePixels = 256 * 256;
+static const unsigned maximumLevel = 8;
+
+static cairo_user_data_key_t scaledImageCacheKey;
+
+ScaledImageCache& ScaledImageCache::shared()
+{
+    DEFINE_STATIC_LOCAL(ScaledImageCache, cache, ());
+    return cache;
+}
+
+ScaledImageCache::ScaledImageCache()
+    : m_bytes(0)
+{
+}
+
+static PassRefPtr<cairo_surface_t> halveSurface(cairo_surface_t* surface, cairo_filter_t filter)
+{
+    int width = cairo_image_surface_get_width(surface);
+    int height = cairo_image_surface_get_height(surface);
+    RefPtr<cairo_surface_t> halved = adoptRef(cairo_image_surface_create(cairo_image_surface_get_format(surface), (width + 1) / 2, (height + 1) / 2));
+    if (cairo_surface_status(halved.get()) != CAIRO_STATUS_SUCCESS)
+        return 0;
+
+    // At exactly half size every destination pixel is sampled half way
+    // between four source pixels, so the bilinear filter averages them and
+    // the fast one picks one of them.
+    RefPtr<cairo_t> cr = adoptRef(cairo_create(halved.get()));
+    cairo_scale(cr.get(), 0.5, 0.5);
+    cairo_set_source_surface(cr.get(), surface, 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr.get()), filter);
+    cairo_pattern_set_extend(cairo_get_source(cr.get()), CAIRO_EXTEND_PAD);
+    cairo_set_operator(cr.get(), CAIRO_OPERATOR_SOURCE);
+    cairo_paint(cr.get());
+    return halved.release();
+}
+
+PassRefPtr<cairo_surface_t> ScaledImageCache::scaledSurface(cairo_surface_t* surface, float scale, InterpolationQuality quality, FloatRect& srcRect)
+{
+    if (scale <= 0 || scale > 0.5 || quality == InterpolationNone || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE)
+        return 0;
+
+    int width = cairo_image_surface_get_width(surface);
+    int height = cairo_image_surface_get_height(surface);
+    if (width * height < minimumSourcePixels)
+        return 0;
+
+    // The smallest level that still has at least one pixel per device pixel.
+    unsigned level = 0;
+    while (level < maximumLevel && scale * (2 << level) <= 1 && (width >> (level + 1)) && (height >> (level + 1)))
+        ++level;
+    if (!level)
+        return 0;
+
+    ++m_statistics.lookups;
+    float levelScale = 1.0f / (1 << level);
+
+    // The same filters PlatformContextCairo draws the level with.
+    cairo_filter_t filter = quality == InterpolationLow ? CAIRO_FILTER_FAST : CAIRO_FILTER_BILINEAR;
+    Key key(surface, std::make_pair(level, static_cast<int>(filter)));
+    HashMap<Key, Entry>::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++m_statistics.hits;
+        m_statistics.resampleTimeSaved += it->value.buildTime;
+        m_recentlyUsed.remove(key);
+        m_recentlyUsed.add(key);
+        srcRect.scale(levelScale);
+        return it->value.surface;
+    }
+
+    double startTime = monotonicallyIncreasingTime();
+    RefPtr<cairo_surface_t> scaled = surface;
+    for (unsigned i = 0; i < level && scaled; ++i)
+        scaled = halveSurface(scaled.get(), filter);
+    if (!scaled)
+        return 0;
+    srcRect.scale(levelScale);
+
+    // Entries must not outlive the surface they were made from, whose
+    // address may be reused.
+    if (!cairo_surface_get_user_data(surface, &scaledImageCacheKey)
+        && cairo_surface_set_user_data(surface, &scaledImageCacheKey, surface, sourceSurfaceDestroyed) != CAIRO_STATUS_SUCCESS)
+        return scaled.release();
+
+    Entry entry;
+    entry.surface = scaled;
+    entry.bytes = cairo_image_surface_get_stride(scaled.get()) * cairo_image_surface_get_height(scaled.get());
+    entry.buildTime = monotonicallyIncreasingTime() - startTime;
+    m_entries.add(key, entry);
+    m_recentlyUsed.add(key);
+    m_bytes += entry.bytes;
+    prune();
+
+    return scaled.release();
+}
+
+void ScaledImageCache::sourceSurfaceDestroyed(void* surface)
+{
+    shared().removeEntriesForSurface(static_cast<cairo_surface_t*>(surface));
+}
+
+void ScaledImageCache::removeEntriesForSurface(cairo_surface_t* surface)
+{
+    for (unsigned level = 1; level <= maximumLevel; ++level) {
+        removeEntry(Key(surface, std::make_pair(level, static_cast<int>(CAIRO_FILTER_FAST))));
+        removeEntry(Key(surface, std::make_pair(level, static_cast<int>(CAIRO_FILTER_BILINEAR))));
+    }
+}
+
+void ScaledImageCache::removeEntry(const Key& key)
+{
+    HashMap<Key, Entry>::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+    ASSERT(m_bytes >= it->value.bytes);
+    m_bytes -= it->value.bytes;
+    m_entries.remove(it);
+    m_recentlyUsed.remove(key);
+}
+
+void ScaledImageCache::prune()
+{
+    // The entry just added is last, so it survives even if it alone is over
+    // the budget.
+    while (m_bytes > scaledImageCacheBudget && m_recentlyUsed.size() > 1) {
+        Key leastRecentlyUsed = m_recentlyUsed.first();
+        removeEntry(leastRecentlyUsed);
+    }
+}
+
+} // namespace WebCore
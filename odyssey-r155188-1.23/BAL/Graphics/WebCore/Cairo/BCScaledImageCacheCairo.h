@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ScaledImageCache_h
+#define ScaledImageCache_h
+
+#include "GraphicsContext.h"
+#include "RefPtrCairo.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassRefPtr.h>
+
+typedef struct _cairo_surface cairo_surface_t;
+
+namespace WebCore {
+
+class FloatRect;
+
+// Keeps box filtered, power of two reductions (mipmap levels) of decoded
+// images that are drawn much smaller than their size, so that pixman only
+// resamples by less than a factor two on each paint. Low quality draws get
+// levels that keep every other pixel, which are cheaper to make, the other
+// qualities levels that average four pixels into one. Levels are dropped
+// together with the image surface they were made from, i.e. when the image
+// destroys its decoded data, and least recently used first once the cache
+// is over its budget.
+class ScaledImageCache {
+    WTF_MAKE_NONCOPYABLE(ScaledImageCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static ScaledImageCache& shared();
+
+    // Returns the level of |surface| to draw from when drawing it at |scale|
+    // device pixels per image pixel with |quality|, and maps |srcRect| into
+    // that level. Returns 0 if the surface should be drawn directly.
+    PassRefPtr<cairo_surface_t> scaledSurface(cairo_surface_t*, float scale, InterpolationQuality, FloatRect& srcRect);
+
+    struct Statistics {
+        Statistics() : lookups(0), hits(0), resampleTimeSaved(0) { }
+        unsigned lookups;
+        unsigned hits;
+        // Time it took to build the levels hits were served from, i.e. the
+        // resampling the hits did not have to repeat, in seconds.
+        double resampleTimeSaved;
+    };
+    const Statistics& statistics() const { return m_statistics; }
+
+private:
+    ScaledImageCache();
+
+    // The source surface, the number of halvings and the cairo filter they
+    // were made with.
+    typedef std::pair<cairo_surface_t*, std::pair<unsigned, int> > Key;
+    struct Entry {
+        RefPtr<cairo_surface_t> surface;
+        size_t bytes;
+        double buildTime;
+    };
+
+    static void sourceSurfaceDestroyed(void*);
+    void removeEntriesForSurface(cairo_surface_t*);
+    void removeEntry(const Key&);
+    void prune();
+
+    HashMap<Key, Entry> m_entries;
+    ListHashSet<Key> m_recentlyUsed; // Least recently used first.
+    size_t m_bytes;
+    Statistics m_statistics;
+};
+
+} // namespace WebCore
+
+#endif // ScaledImageCache_h
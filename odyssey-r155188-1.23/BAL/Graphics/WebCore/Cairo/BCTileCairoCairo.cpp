@@ -30,18 +30,53 @@
 
 #if USE(TILED_BACKING_STORE) && USE(CAIRO)
 #include "CairoUtilities.h"
+#include "DisplayList.h"
 #include "GraphicsContext.h"
 #include "PlatformContextCairo.h"
+#include "TileRasterizerThreadPool.h"
 #include "TiledBackingStore.h"
 #include "TiledBackingStoreClient.h"
 #include <RefPtrCairo.h>
+#include <wtf/MainThread.h>
 
 namespace WebCore {
 
+// Replaying on a worker thread while the main thread draws with the same
+// fonts and images relies on the snapshots and font face locking of Cairo
+// 1.12 and later. Images that are written outside of Cairo are copied while
+// recording, see DisplayList.
+static bool canRasterizeOnWorkerThreads()
+{
+#if USE(THREADED_TILE_RASTERIZATION)
+    static bool cairoIsThreadSafe = cairo_version() >= CAIRO_VERSION_ENCODE(1, 12, 0);
+    return cairoIsThreadSafe;
+#else
+    return false;
+#endif
+}
+
+// The paint commands recorded for the dirty rects of a tile, and the buffer
+// they are replayed into on a worker thread.
+struct TileCairo::RasterizationJob {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Only referenced and released on the main thread.
+    RefPtr<TileCairo> tile;
+    RefPtr<cairo_surface_t> frontBuffer;
+    RefPtr<DisplayList> displayList;
+
+    Vector<IntRect> rects;
+    IntPoint origin;
+    IntSize size;
+
+    RefPtr<cairo_surface_t> buffer;
+};
+
 TileCairo::TileCairo(TiledBackingStore* backingStore, const Coordinate& tileCoordinate)
     : m_backingStore(backingStore)
     , m_coordinate(tileCoordinate)
     , m_rect(m_backingStore->tileRectForCoordinate(tileCoordinate))
+    , m_isRasterizing(false)
 {
     cairo_rectangle_int_t rect = m_rect;
     m_dirtyRegion = adoptRef(cairo_region_create_rectangle(&rect));
@@ -73,18 +108,11 @@ void TileCairo::invalidate(const IntRect& dirtyRect)
 
 Vector<IntRect> TileCairo::updateBackBuffer()
 {
-    if (m_buffer && !isDirty())
+    // Invalidations that arrive while the tile is rasterized are kept for the
+    // next update, as they would otherwise be overwritten by the older buffer.
+    if (m_isRasterizing || (m_buffer && !isDirty()))
         return Vector<IntRect>();
 
-    if (!m_buffer)
-        m_buffer = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
-                                                       m_backingStore->tileSize().width(),
-                                                       m_backingStore->tileSize().height()));
-
-    RefPtr<cairo_t> cr = adoptRef(cairo_create(m_buffer.get()));
-    GraphicsContext context(cr.get());
-    context.translate(-m_rect.x(), -m_rect.y());
-
     Vector<IntRect> updateRects;
     cairo_rectangle_int_t rect;
 
@@ -92,22 +120,102 @@ Vector<IntRect> TileCairo::updateBackBuffer()
     for (int i = 0; i < rectCount; ++i) {
         cairo_region_get_rectangle(m_dirtyRegion.get(), i, &rect);
         updateRects.append(IntRect(rect));
-
-        context.save();
-        context.clip(FloatRect(rect));
-        context.scale(FloatSize(m_backingStore->contentsScale(), m_backingStore->contentsScale()));
-        m_backingStore->client()->tiledBackingStorePaint(&context, m_backingStore->mapToContents(rect));
-        context.restore();
     }
 
     m_dirtyRegion.clear();
     m_dirtyRegion = adoptRef(cairo_region_create());
 
-    return updateRects;
+    IntSize tileSize = m_backingStore->tileSize();
+
+    // A visible tile without content is painted right away, instead of
+    // showing the checker pattern until a worker thread gets to it.
+    if (!canRasterizeOnWorkerThreads() || !TileRasterizerThreadPool::shared()->hasThreads()
+        || (!m_buffer && m_backingStore->tileIntersectsVisibleRect(m_coordinate))) {
+        if (!m_buffer)
+            m_buffer = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, tileSize.width(), tileSize.height()));
+        RefPtr<cairo_t> cr = adoptRef(cairo_create(m_buffer.get()));
+        GraphicsContext context(cr.get());
+        paintRects(&context, updateRects);
+        return updateRects;
+    }
+
+    // Record the paint commands here, as the render tree may only be walked
+    // on the main thread, and replay them on a worker thread.
+    RefPtr<DisplayList> displayList = DisplayList::create(IntRect(IntPoint(), tileSize));
+    paintRects(displayList->beginRecording(), updateRects);
+    displayList->endRecording();
+
+    RasterizationJob* job = new RasterizationJob;
+    job->tile = this;
+    job->frontBuffer = m_buffer;
+    job->displayList = displayList.release();
+    job->rects = updateRects;
+    job->origin = m_rect.location();
+    job->size = tileSize;
+
+    m_isRasterizing = true;
+    TileRasterizerThreadPool::shared()->postTask(bind(&TileCairo::rasterizeOnWorkerThread, job));
+
+    return Vector<IntRect>();
+}
+
+void TileCairo::paintRects(GraphicsContext* context, const Vector<IntRect>& rects)
+{
+    context->translate(-m_rect.x(), -m_rect.y());
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        context->save();
+        context->clip(FloatRect(rects[i]));
+        context->scale(FloatSize(m_backingStore->contentsScale(), m_backingStore->contentsScale()));
+        m_backingStore->client()->tiledBackingStorePaint(context, m_backingStore->mapToContents(rects[i]));
+        context->restore();
+    }
+}
+
+void TileCairo::rasterizeOnWorkerThread(RasterizationJob* job)
+{
+    job->buffer = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, job->size.width(), job->size.height()));
+    {
+        RefPtr<cairo_t> cr = adoptRef(cairo_create(job->buffer.get()));
+        cairo_set_operator(cr.get(), CAIRO_OPERATOR_SOURCE);
+
+        // Start from the current content, then replace the dirty rects.
+        if (job->frontBuffer) {
+            cairo_set_source_surface(cr.get(), job->frontBuffer.get(), 0, 0);
+            cairo_paint(cr.get());
+        }
+
+        for (size_t i = 0; i < job->rects.size(); ++i) {
+            const IntRect& rect = job->rects[i];
+            cairo_rectangle(cr.get(), rect.x() - job->origin.x(), rect.y() - job->origin.y(), rect.width(), rect.height());
+        }
+        cairo_clip(cr.get());
+        job->displayList->replay(cr.get());
+    }
+    cairo_surface_flush(job->buffer.get());
+
+    callOnMainThread(didFinishRasterizing, job);
+}
+
+void TileCairo::didFinishRasterizing(void* context)
+{
+    OwnPtr<RasterizationJob> job = adoptPtr(static_cast<RasterizationJob*>(context));
+    RefPtr<TileCairo> tile = job->tile.release();
+    tile->m_isRasterizing = false;
+
+    // The backing store dropped the tile, or was destroyed, in the meantime.
+    if (tile->hasOneRef())
+        return;
+
+    tile->m_backBuffer = job->buffer.release();
+    tile->swapBackBufferToFront();
+    tile->m_backingStore->tileBufferUpdated(tile.get(), job->rects);
 }
 
 void TileCairo::swapBackBufferToFront()
 {
+    if (m_backBuffer)
+        m_buffer = m_backBuffer.release();
 }
 
 void TileCairo::paint(GraphicsContext* context, const IntRect& rect)
@@ -62,12 +62,22 @@ public:
 protected:
     TileCairo(TiledBackingStore*, const Coordinate&);
 
+    struct RasterizationJob;
+    static void rasterizeOnWorkerThread(RasterizationJob*);
+    static void didFinishRasterizing(void*);
+
+    void paintRects(GraphicsContext*, const Vector<IntRect>&);
+
     TiledBackingStore* m_backingStore;
     Coordinate m_coordinate;
     IntRect m_rect;
 
+    // Painted from on the main thread while the next version of the tile is
+    // rasterized into m_backBuffer on a worker thread.
     RefPtr<cairo_surface_t> m_buffer;
+    RefPtr<cairo_surface_t> m_backBuffer;
     RefPtr<cairo_region_t> m_dirtyRegion;
+    bool m_isRasterizing;
 };
 
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "BackgroundThreadPool.h"
+
+#include <wtf/NumberOfCores.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+#if OS(MORPHOS)
+#include <proto/exec.h>
+#endif
+
+namespace WebCore {
+
+BackgroundThreadPool::BackgroundThreadPool(const char* threadName, int maximumNumberOfThreads)
+{
+    MutexLocker lock(m_threadCreationMutex);
+    int numberOfThreads = std::max(1, std::min(WTF::numberOfProcessorCores() - 1, maximumNumberOfThreads));
+    for (int i = 0; i < numberOfThreads; ++i) {
+        if (ThreadIdentifier threadID = createThread(BackgroundThreadPool::threadStart, this, threadName))
+            m_threads.append(threadID);
+    }
+}
+
+BackgroundThreadPool::~BackgroundThreadPool()
+{
+    m_queue.kill();
+    for (size_t i = 0; i < m_threads.size(); ++i)
+        waitForThreadCompletion(m_threads[i]);
+}
+
+void BackgroundThreadPool::postTask(const Closure& task)
+{
+    m_queue.append(adoptPtr(new Closure(task)));
+}
+
+void BackgroundThreadPool::threadStart(void* arg)
+{
+    BackgroundThreadPool* pool = static_cast<BackgroundThreadPool*>(arg);
+    pool->runLoop();
+}
+
+void BackgroundThreadPool::runLoop()
+{
+    {
+        // Wait for the constructor to finish registering the threads.
+        MutexLocker lock(m_threadCreationMutex);
+    }
+#if OS(MORPHOS)
+    // Background work must never delay input handling or painting on single
+    // processor machines.
+    SetTaskPri(FindTask(0), -1);
+#endif
+    while (OwnPtr<Closure> task = m_queue.waitForMessage())
+        (*task)();
+
+    // The destructor will wait to join the threads, so we do not detach here.
+}
+
+} // namespace WebCore
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef BackgroundThreadPool_h
+#define BackgroundThreadPool_h
+
+#include <wtf/Functional.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Low priority threads that run tasks posted from the main thread, in the
+// order they were posted. Tasks must only touch objects handed over to
+// them, and report back with callOnMainThread().
+class BackgroundThreadPool {
+    WTF_MAKE_NONCOPYABLE(BackgroundThreadPool); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Starts one thread per processor core but one, at least one and at most
+    // |maximumNumberOfThreads|, all called |threadName|.
+    BackgroundThreadPool(const char* threadName, int maximumNumberOfThreads);
+    // Waits for the task each thread is running, and drops the others.
+    ~BackgroundThreadPool();
+
+    // False if no thread could be started.
+    bool hasThreads() const { return !m_threads.isEmpty(); }
+
+    typedef Function<void()> Closure;
+    void postTask(const Closure&);
+
+private:
+    static void threadStart(void*);
+    void runLoop();
+
+    Mutex m_threadCreationMutex;
+    MessageQueue<Closure> m_queue;
+    Vector<ThreadIdentifier> m_threads;
+};
+
+} // namespace WebCore
+
+#endif // BackgroundThreadPool_h
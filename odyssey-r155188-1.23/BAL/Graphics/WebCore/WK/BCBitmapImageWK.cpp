@@ -37,8 +37,55 @@
 #include <wtf/text/WTFString.h>
 #include "WebPreferences.h"
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+#include "GraphicsContext.h"
+#include "ImageDecoder.h"
+#include "ImageDecodingThreadPool.h"
+#include "SharedBuffer.h"
+#include <wtf/MainThread.h>
+#endif
+
 namespace WebCore {
 
+// Animated images with more decoded frames than this are considered large
+// enough that we'll only hang on to the frames around the current one.
+static const unsigned cLargeAnimationCutoff = 5242880;
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+// The decoder an animation decodes ahead with, and the frames it was last
+// asked for. Owned by the decoding thread while it runs, otherwise by the
+// image. Only the main thread touches |image|.
+struct BitmapImage::AnimationLookAhead {
+    WTF_MAKE_NONCOPYABLE(AnimationLookAhead); WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Frame {
+        size_t index;
+        NativeImagePtr frame;
+        ImageOrientation orientation;
+        float duration;
+        bool hasAlpha;
+        unsigned frameBytes;
+    };
+
+    AnimationLookAhead(NativeImageDecoderPtr decoder, PassRefPtr<SharedBuffer> data)
+        : data(data)
+        , generation(0)
+        , decodeWallTime(0)
+    {
+        source.setDecoder(decoder);
+        source.setData(this->data.get(), true);
+    }
+
+    RefPtr<BitmapImage> image;
+    RefPtr<SharedBuffer> data;
+    ImageSource source;
+    Vector<size_t> framesToDecode;
+    Vector<Frame> decodedFrames;
+    unsigned generation;
+    double decodeWallTime;
+};
+#endif
+
 BitmapImage::BitmapImage(ImageObserver* observer)
     : Image(observer)
     , m_currentFrame(0)
@@ -49,12 +96,27 @@ BitmapImage::BitmapImage(ImageObserver* observer)
     , m_repetitionsComplete(0)
     , m_desiredFrameStartTime(0)
     , m_decodedSize(0)
+    , m_frameDecodeWallTime(0)
+    , m_timeToFirstPixels(0)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    , m_maxDecodedPixels(ImageSource::maxPixelsPerDecodedImage())
+#endif
+#if ENABLE(THREADED_IMAGE_DECODING)
+    , m_decoderGeneration(0)
+    , m_animationLookAhead(0)
+#endif
     , m_decodedPropertiesSize(0)
     , m_frameCount(0)
     , m_isSolidColor(false)
     , m_checkedForSolidColor(false)
     , m_animationFinished(false)
     , m_allDataReceived(false)
+#if ENABLE(THREADED_IMAGE_DECODING)
+    , m_asynchronousDecodePending(false)
+    , m_animationLookAheadPending(false)
+    , m_animationWaitingForFrame(false)
+    , m_animationLookAheadFailed(false)
+#endif
     , m_haveSize(false)
     , m_sizeAvailable(false)
     , m_hasUniformFrameSize(true)
@@ -66,6 +128,9 @@ BitmapImage::~BitmapImage()
 {
     invalidatePlatformData();
     stopAnimation();
+#if ENABLE(THREADED_IMAGE_DECODING)
+    delete m_animationLookAhead;
+#endif
 }
 
 bool BitmapImage::isBitmapImage() const
@@ -94,21 +159,61 @@ void BitmapImage::destroyDecodedData(bool destroyAll)
 
     destroyMetadataAndNotify(frameBytesCleared);
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+    if (destroyAll) {
+        ++m_decoderGeneration;
+        m_pendingFrame = 0;
+        // The look-ahead decoder keeps its checkpoints, so that the animation
+        // doesn't have to be replayed from the start.
+        if (m_animationLookAhead)
+            m_animationLookAhead->source.clear(false, m_animationLookAhead->source.frameCount());
+    }
+#endif
     m_source.clear(destroyAll, clearBeforeFrame, data(), m_allDataReceived);
     return;
 }
 
 void BitmapImage::destroyDecodedDataIfNecessary(bool destroyAll)
 {
-    // Animated images >5MB are considered large enough that we'll only hang on
-    // to one frame at a time.
-    static const unsigned cLargeAnimationCutoff = 5242880;
     unsigned allFrameBytes = 0;
     for (size_t i = 0; i < m_frames.size(); ++i)
         allFrameBytes += m_frames[i].m_frameBytes;
 
-    if (allFrameBytes > cLargeAnimationCutoff)
-        destroyDecodedData(destroyAll);
+    if (allFrameBytes <= cLargeAnimationCutoff)
+        return;
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Keep the frames decoded ahead; they will be shown next, also when the
+    // animation starts over.
+    if (usesAnimationLookAhead()) {
+        destroyDecodedDataOutsideAnimationWindow();
+        return;
+    }
+#endif
+    destroyDecodedData(destroyAll);
+}
+
+void BitmapImage::destroyDecodedDataOutsideAnimationWindow()
+{
+    const size_t numFrames = frameCount();
+    const size_t windowSize = animationLookAheadFrameCount() + 1;
+    unsigned frameBytesCleared = 0;
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        if ((i + numFrames - m_currentFrame) % numFrames < windowSize)
+            continue;
+        unsigned frameBytes = m_frames[i].m_frameBytes;
+        if (m_frames[i].clear(false))
+            frameBytesCleared += frameBytes;
+    }
+
+    destroyMetadataAndNotify(frameBytesCleared);
+
+    // Frames the source decoded here may still be in use after the window
+    // wraps around, so it only clears up to the first one kept.
+    size_t clearBeforeFrame = 0;
+    while (clearBeforeFrame < m_frames.size() && !m_frames[clearBeforeFrame].m_frame)
+        ++clearBeforeFrame;
+    m_source.clear(false, clearBeforeFrame, data(), m_allDataReceived);
 }
 
 void BitmapImage::destroyMetadataAndNotify(unsigned frameBytesCleared)
@@ -135,7 +240,11 @@ void BitmapImage::cacheFrame(size_t index)
     if (m_frames.size() < numFrames)
         m_frames.grow(numFrames);
 
+    const double startTime = monotonicallyIncreasingTime();
     m_frames[index].m_frame = m_source.createFrameAtIndex(index);
+    m_frameDecodeWallTime += monotonicallyIncreasingTime() - startTime;
+    if (!m_timeToFirstPixels)
+        m_timeToFirstPixels = m_source.timeToFirstPixels();
     if (numFrames == 1 && m_frames[index].m_frame)
         checkForSolidColor();
 
@@ -146,6 +255,12 @@ void BitmapImage::cacheFrame(size_t index)
         m_frames[index].m_duration = m_source.frameDurationAtIndex(index);
     m_frames[index].m_hasAlpha = m_source.frameHasAlphaAtIndex(index);
     m_frames[index].m_frameBytes = m_source.frameBytesAtIndex(index);
+#if ENABLE(THREADED_IMAGE_DECODING)
+    if (!index && m_frames[index].m_frame)
+        m_pendingFrame = 0;
+    if (m_frames[index].m_frame && m_frames[index].m_isComplete)
+        ImageDecodingThreadPool::didDecodeFormatOnMainThread(m_source.filenameExtension());
+#endif
 
     const IntSize frameSize(index ? m_source.frameSizeAtIndex(index) : m_size);
     if (frameSize != m_size)
@@ -239,6 +354,12 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     // frame affected by appending new data here. Thus we have to clear all the
     // incomplete frames to be safe.
     unsigned frameBytesCleared = 0;
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // The last pass shows while the complete image is decoded on the image
+    // decoding threads.
+    if (allDataReceived && m_frames.size() == 1 && m_frames[0].m_frame && !m_frames[0].m_isComplete)
+        m_pendingFrame = m_frames[0].m_frame;
+#endif
     for (size_t i = 0; i < m_frames.size(); ++i) {
         // NOTE: Don't call frameIsCompleteAtIndex() here, that will try to
         // decode any uncached (i.e. never-decoded or
@@ -250,6 +371,9 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     destroyMetadataAndNotify(frameBytesCleared);
     
     // Feed all the data we've seen so far to the image decoder.
+#if ENABLE(THREADED_IMAGE_DECODING)
+    ++m_decoderGeneration;
+#endif
     m_allDataReceived = allDataReceived;
     m_source.setData(data(), allDataReceived);
     
@@ -311,6 +435,11 @@ bool BitmapImage::frameIsCompleteAtIndex(size_t index)
     return m_frames[index].m_isComplete;
 }
 
+bool BitmapImage::frameIsDecodedAtIndex(size_t index) const
+{
+    return index < m_frames.size() && m_frames[index].m_frame && m_frames[index].m_isComplete;
+}
+
 float BitmapImage::frameDurationAtIndex(size_t index)
 {
     if (!ensureFrameIsCached(index))
@@ -320,9 +449,315 @@ float BitmapImage::frameDurationAtIndex(size_t index)
 
 PassNativeImagePtr BitmapImage::nativeImageForCurrentFrame()
 {
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Canvas patterns, WebGL and the pasteboard may use the frame at any scale.
+    updateDecodedResolution(static_cast<double>(size().width()) * size().height());
+#endif
     return frameAtIndex(currentFrame());
 }
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+PassNativeImagePtr BitmapImage::nativeImageForCurrentFrameAtResolution(double neededPixels)
+{
+    updateDecodedResolution(neededPixels);
+    return frameAtIndex(currentFrame());
+}
+
+void BitmapImage::setMaxDecodedPixels(unsigned maxPixels)
+{
+    m_maxDecodedPixels = maxPixels;
+}
+
+void BitmapImage::updateDecodedResolution(double neededPixels)
+{
+    // Animation frames are composited onto one another, so they all keep the
+    // resolution the first one was decoded at.
+    if (!isSizeAvailable() || frameCount() > 1)
+        return;
+
+    // Don't bother re-decoding for tiny differences in small draws.
+    static const double minimumDecodedPixels = 256 * 256;
+
+    double imagePixels = static_cast<double>(size().width()) * size().height();
+    double maxPixels = m_maxDecodedPixels ? std::min<double>(m_maxDecodedPixels, imagePixels) : imagePixels;
+    double wantedPixels = std::min(std::max(neededPixels, minimumDecodedPixels), maxPixels);
+    double decodablePixels = m_source.maxDecodedPixels() ? std::min<double>(m_source.maxDecodedPixels(), imagePixels) : imagePixels;
+
+    if (!m_decodedSize) {
+        // Nothing is decoded yet, so decode no more than this use needs.
+        if (wantedPixels == decodablePixels)
+            return;
+        m_source.setMaxDecodedPixels(wantedPixels < imagePixels ? static_cast<unsigned>(wantedPixels) : 0);
+#if ENABLE(THREADED_IMAGE_DECODING)
+        ++m_decoderGeneration;
+#endif
+        m_source.clear(true, 0, data(), m_allDataReceived);
+        return;
+    }
+
+    if (wantedPixels <= decodablePixels)
+        return;
+
+    // Grow geometrically so that an image zoomed in steps is not re-decoded on
+    // every paint.
+    wantedPixels = std::min(std::max(wantedPixels, 2 * decodablePixels), maxPixels);
+    m_source.setMaxDecodedPixels(wantedPixels < imagePixels ? static_cast<unsigned>(wantedPixels) : 0);
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // The lower resolution frame shows, scaled up, until the new one is
+    // decoded on the image decoding threads.
+    NativeImagePtr previousFrame = m_frames.size() ? m_frames[0].m_frame : 0;
+    destroyDecodedData(true);
+    m_pendingFrame = previousFrame;
+#else
+    destroyDecodedData(true);
+#endif
+}
+#endif
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+// Owned by the decoding thread while it runs, then handed back to the main
+// thread. Only the main thread touches |image|.
+struct BitmapImage::AsynchronousDecode {
+    WTF_MAKE_NONCOPYABLE(AsynchronousDecode); WTF_MAKE_FAST_ALLOCATED;
+public:
+    AsynchronousDecode(BitmapImage* image, NativeImageDecoderPtr decoder, PassRefPtr<SharedBuffer> data, unsigned generation)
+        : image(image)
+        , decoder(decoder)
+        , data(data)
+        , generation(generation)
+    {
+    }
+
+    ~AsynchronousDecode()
+    {
+        delete decoder;
+    }
+
+    RefPtr<BitmapImage> image;
+    NativeImageDecoderPtr decoder;
+    RefPtr<SharedBuffer> data;
+    unsigned generation;
+};
+
+bool BitmapImage::canDecodeAsynchronously()
+{
+    if (m_asynchronousDecodePending)
+        return true;
+
+    // Animations need their frames in order, and partial data is decoded a
+    // pass at a time as it arrives.
+    if (!m_allDataReceived || !isSizeAvailable() || frameCount() != 1)
+        return false;
+    if (m_frames.size() && m_frames[0].m_frame)
+        return false;
+    if (!ImageDecodingThreadPool::canDecodeFormat(m_source.filenameExtension()))
+        return false;
+
+    // Below this, decoding is quicker than a round trip through the threads.
+    static const double minimumAsynchronousDecodePixels = 128 * 128;
+    return static_cast<double>(size().width()) * size().height() >= minimumAsynchronousDecodePixels;
+}
+
+bool BitmapImage::decodeAsynchronouslyIfNeeded(GraphicsContext* context, const FloatRect& destRect)
+{
+    FloatRect deviceRect = context->getCTM().mapRect(destRect);
+    return decodeAsynchronouslyIfNeeded(static_cast<double>(deviceRect.width()) * deviceRect.height());
+}
+
+bool BitmapImage::decodeAsynchronouslyIfNeeded(double neededPixels)
+{
+    ASSERT(isMainThread());
+    if (m_asynchronousDecodePending)
+        return true;
+
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Pick the resolution first, so that the decoding thread produces the
+    // frame this use needs.
+    updateDecodedResolution(neededPixels);
+#else
+    UNUSED_PARAM(neededPixels);
+#endif
+
+    if (!canDecodeAsynchronously())
+        return false;
+
+    // The decoding thread gets its own copy of the data and its own decoder,
+    // so that loading and painting can go on while it runs.
+    RefPtr<SharedBuffer> dataCopy = data()->copy();
+    NativeImageDecoderPtr decoder = m_source.createDecoder(*dataCopy);
+    if (!decoder)
+        return false;
+
+    AsynchronousDecode* decode = new AsynchronousDecode(this, decoder, dataCopy.release(), m_decoderGeneration);
+    m_asynchronousDecodePending = true;
+    ImageDecodingThreadPool::shared()->postTask(bind(&BitmapImage::decodeOnDecodingThread, decode));
+    return true;
+}
+
+void BitmapImage::drawPendingFrame(GraphicsContext* context, const FloatRect& dstRect, ColorSpace styleColorSpace, CompositeOperator compositeOp)
+{
+    // Until something is decoded the space stays empty, like that of an
+    // image whose data has not arrived yet; any fill would show through
+    // where the image turns out to be transparent.
+    if (!m_pendingFrame)
+        return;
+
+    RefPtr<BitmapImage> pendingImage = BitmapImage::create(m_pendingFrame);
+    context->drawImage(pendingImage.get(), styleColorSpace, dstRect, FloatRect(FloatPoint(), pendingImage->size()), compositeOp);
+}
+
+void BitmapImage::decodeOnDecodingThread(AsynchronousDecode* decode)
+{
+    decode->decoder->setData(decode->data.get(), true);
+    decode->decoder->frameBufferAtIndex(0);
+    callOnMainThread(BitmapImage::didFinishAsynchronousDecode, decode);
+}
+
+void BitmapImage::didFinishAsynchronousDecode(void* context)
+{
+    OwnPtr<AsynchronousDecode> decode = adoptPtr(static_cast<AsynchronousDecode*>(context));
+    BitmapImage* image = decode->image.get();
+    image->m_asynchronousDecodePending = false;
+
+    // The data, the resolution or the cached frame may have changed while
+    // the thread was busy; then the decode is dropped and the next paint
+    // starts over, still drawing the pending frame.
+    if (decode->generation == image->m_decoderGeneration && !(image->m_frames.size() && image->m_frames[0].m_frame)) {
+        image->m_source.setDecoder(decode->decoder);
+        decode->decoder = 0;
+        image->ensureFrameIsCached(0);
+    }
+
+    if (image->imageObserver())
+        image->imageObserver()->changedInRect(image, IntRect(IntPoint(), image->size()));
+}
+
+void BitmapImage::decodeAheadIfNeeded()
+{
+    ASSERT(isMainThread());
+    // Animations that are still loading are decoded here, a pass at a time
+    // as their data arrives.
+    if (m_animationLookAheadPending || !usesAnimationLookAhead() || frameCount() <= 1)
+        return;
+    if (!ImageDecodingThreadPool::canDecodeFormat(m_source.filenameExtension()))
+        return;
+
+    Vector<size_t> framesToDecode;
+    const size_t lookAheadFrames = std::min(animationLookAheadFrameCount(), frameCount() - 1);
+    for (size_t i = 1; i <= lookAheadFrames; ++i) {
+        size_t index = (m_currentFrame + i) % frameCount();
+        if (!frameIsDecodedAtIndex(index))
+            framesToDecode.append(index);
+    }
+    if (framesToDecode.isEmpty())
+        return;
+
+    if (!m_animationLookAhead) {
+        RefPtr<SharedBuffer> dataCopy = data()->copy();
+        NativeImageDecoderPtr decoder = m_source.createDecoder(*dataCopy);
+        if (!decoder) {
+            m_animationLookAheadFailed = true;
+            return;
+        }
+        m_animationLookAhead = new AnimationLookAhead(decoder, dataCopy.release());
+    }
+
+    AnimationLookAhead* lookAhead = m_animationLookAhead;
+    m_animationLookAhead = 0;
+    lookAhead->image = this;
+    lookAhead->framesToDecode.swap(framesToDecode);
+    lookAhead->generation = m_decoderGeneration;
+    m_animationLookAheadPending = true;
+    ImageDecodingThreadPool::shared()->postTask(bind(&BitmapImage::decodeAheadOnDecodingThread, lookAhead));
+}
+
+void BitmapImage::decodeAheadOnDecodingThread(AnimationLookAhead* lookAhead)
+{
+    const double startTime = monotonicallyIncreasingTime();
+    ImageSource& source = lookAhead->source;
+    for (size_t i = 0; i < lookAhead->framesToDecode.size(); ++i) {
+        AnimationLookAhead::Frame frame;
+        frame.index = lookAhead->framesToDecode[i];
+        frame.frame = source.createFrameCopyAtIndex(frame.index);
+        if (!frame.frame || !source.frameIsCompleteAtIndex(frame.index))
+            break;
+        frame.orientation = source.orientationAtIndex(frame.index);
+        frame.duration = source.frameDurationAtIndex(frame.index);
+        frame.hasAlpha = source.frameHasAlphaAtIndex(frame.index);
+        frame.frameBytes = source.frameBytesAtIndex(frame.index);
+        lookAhead->decodedFrames.append(frame);
+
+        // The frame has been copied out, so the decoder only needs to keep
+        // what the next one is composited onto, and its checkpoints.
+        source.clear(false, frame.index);
+    }
+    lookAhead->decodeWallTime = monotonicallyIncreasingTime() - startTime;
+    callOnMainThread(BitmapImage::didFinishDecodingAhead, lookAhead);
+}
+
+void BitmapImage::didFinishDecodingAhead(void* context)
+{
+    AnimationLookAhead* lookAhead = static_cast<AnimationLookAhead*>(context);
+    RefPtr<BitmapImage> image = lookAhead->image.release();
+    image->m_animationLookAheadPending = false;
+    image->m_frameDecodeWallTime += lookAhead->decodeWallTime;
+
+    // Frames decoded before the image threw its decoded data away are dropped
+    // with it.
+    if (lookAhead->generation == image->m_decoderGeneration) {
+        const size_t numFrames = image->frameCount();
+        if (image->m_frames.size() < numFrames)
+            image->m_frames.grow(numFrames);
+
+        int deltaBytes = 0;
+        for (size_t i = 0; i < lookAhead->decodedFrames.size(); ++i) {
+            const AnimationLookAhead::Frame& decoded = lookAhead->decodedFrames[i];
+            FrameData& frame = image->m_frames[decoded.index];
+            if (frame.m_frame)
+                continue;
+            frame.m_frame = decoded.frame;
+            frame.m_orientation = decoded.orientation;
+            frame.m_haveMetadata = true;
+            frame.m_isComplete = true;
+            frame.m_duration = decoded.duration;
+            frame.m_hasAlpha = decoded.hasAlpha;
+            frame.m_frameBytes = decoded.frameBytes;
+            deltaBytes += safeCast<int>(decoded.frameBytes);
+        }
+        if (deltaBytes) {
+            image->m_decodedSize += deltaBytes;
+            // As in cacheFrame(), decoded frames subsume the data decoded to
+            // determine the image properties.
+            deltaBytes -= image->m_decodedPropertiesSize;
+            image->m_decodedPropertiesSize = 0;
+            if (image->imageObserver())
+                image->imageObserver()->decodedSizeChanged(image.get(), deltaBytes);
+        }
+    }
+
+    bool failed = lookAhead->decodedFrames.size() < lookAhead->framesToDecode.size();
+    lookAhead->framesToDecode.clear();
+    lookAhead->decodedFrames.clear();
+
+    bool allFramesDecoded = true;
+    for (size_t i = 0; allFramesDecoded && i < image->frameCount(); ++i)
+        allFramesDecoded = image->frameIsDecodedAtIndex(i);
+
+    if (failed || allFramesDecoded) {
+        // Once small animations are decoded whole, the decoder is no longer
+        // needed. If decoding failed, decoding here reports it.
+        image->m_animationLookAheadFailed = failed;
+        delete lookAhead;
+    } else
+        image->m_animationLookAhead = lookAhead;
+
+    if (image->m_animationWaitingForFrame) {
+        image->m_animationWaitingForFrame = false;
+        image->startAnimation();
+    }
+}
+#endif
+
 bool BitmapImage::frameHasAlphaAtIndex(size_t index)
 {
     if (m_frames.size() <= index)
@@ -401,6 +836,17 @@ void BitmapImage::startAnimation(bool catchUpIfNecessary)
     if (!m_allDataReceived && repetitionCount(false) == cAnimationLoopOnce && m_currentFrame >= (frameCount() - 1))
         return;
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Have the image decoding threads decode the next frames while this one
+    // shows, and wait for them rather than decode here. The animation goes on
+    // when they are done.
+    decodeAheadIfNeeded();
+    if (m_animationLookAheadPending && !frameIsDecodedAtIndex(nextFrame)) {
+        m_animationWaitingForFrame = true;
+        return;
+    }
+#endif
+
     // Determine time for next frame to start.  By ignoring paint and timer lag
     // in this calculation, we make the animation appear to run at its desired
     // rate regardless of how fast it's being repainted.
@@ -436,7 +882,7 @@ void BitmapImage::startAnimation(bool catchUpIfNecessary)
         // See if we've also passed the time for frames after that to start, in
         // case we need to skip some frames entirely.  Remember not to advance
         // to an incomplete frame.
-        for (size_t frameAfterNext = (nextFrame + 1) % frameCount(); frameIsCompleteAtIndex(frameAfterNext); frameAfterNext = (nextFrame + 1) % frameCount()) {
+        for (size_t frameAfterNext = (nextFrame + 1) % frameCount(); frameIsReadyForAnimationAtIndex(frameAfterNext); frameAfterNext = (nextFrame + 1) % frameCount()) {
             // Should we skip the next frame?
             double frameAfterNextStartTime = m_desiredFrameStartTime + frameDurationAtIndex(nextFrame);
             if (time < frameAfterNextStartTime)
@@ -500,6 +946,27 @@ unsigned BitmapImage::decodedSize() const
     return m_decodedSize;
 }
 
+size_t BitmapImage::animationLookAheadFrameCount()
+{
+    // Enough to ride out a frame that takes longer than usual to decode. Large
+    // animations get fewer, to keep their window within the cutoff.
+    static const size_t cMaxLookAheadFrames = 4;
+    const size_t frameBytes = std::max<size_t>(static_cast<size_t>(size().width()) * size().height() * 4, 1);
+    const size_t framesWithinCutoff = cLargeAnimationCutoff / frameBytes;
+    return std::min(cMaxLookAheadFrames, std::max<size_t>(framesWithinCutoff, 2) - 1);
+}
+
+bool BitmapImage::frameIsReadyForAnimationAtIndex(size_t index)
+{
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Frames still to come from the image decoding threads must not be
+    // decoded here just to be skipped.
+    if (usesAnimationLookAhead())
+        return frameIsDecodedAtIndex(index);
+#endif
+    return frameIsCompleteAtIndex(index);
+}
+
 
 
 void BitmapImage::advanceAnimation(Timer<BitmapImage>*)
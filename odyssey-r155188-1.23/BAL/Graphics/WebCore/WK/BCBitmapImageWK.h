@@ -132,6 +132,13 @@ public:
     virtual void resetAnimation();
 
     virtual unsigned decodedSize() const;
+    // Wall-clock seconds spent decoding the frames of this image, here and on
+    // the image decoding threads. Time the decoding threads were preempted
+    // for is included.
+    double frameDecodeWallTime() const { return m_frameDecodeWallTime; }
+    // Seconds from the first data to the first decoded rows of the first
+    // decoder, see ImageSource::timeToFirstPixels().
+    double timeToFirstPixels() const { return m_timeToFirstPixels; }
 
 #if PLATFORM(MAC)
     // Accessors for native image formats.
@@ -162,7 +169,11 @@ public:
 #endif
 
     virtual PassNativeImagePtr nativeImageForCurrentFrame() OVERRIDE;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    virtual PassNativeImagePtr nativeImageForCurrentFrameAtResolution(double neededPixels) OVERRIDE;
+#endif
     virtual ImageOrientation orientationForCurrentFrame() OVERRIDE { return frameOrientationAtIndex(currentFrame()); }
+    virtual bool currentFrameIsComplete() OVERRIDE { return frameIsCompleteAtIndex(currentFrame()); }
 
     virtual bool currentFrameKnownToBeOpaque() OVERRIDE;
 
@@ -172,9 +183,48 @@ public:
     
     bool canAnimate();
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Caps the pixels decoded per frame, e.g. to the page's budget; 0 means no
+    // limit. Below the cap, single frame images are decoded at the size they
+    // are drawn at.
+    void setMaxDecodedPixels(unsigned);
+#endif
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Whether this image would be decoded on the image decoding threads
+    // rather than on the calling one.
+    bool canDecodeAsynchronously();
+    // Starts decoding on the image decoding threads if the image is large
+    // and not decoded yet, at the resolution a use of |neededPixels| image
+    // pixels needs. Returns true while a decode is running; the caller should
+    // then draw the image with drawPendingFrame(). The image observer is told
+    // when the frame is ready.
+    bool decodeAsynchronouslyIfNeeded(double neededPixels);
+    // The same, for a draw into |destRect|.
+    bool decodeAsynchronouslyIfNeeded(GraphicsContext*, const FloatRect& destRect);
+    // Draws what is known of the image while it is decoded on the image
+    // decoding threads: the last pass of a progressive image or a lower
+    // resolution frame if one was decoded, nothing otherwise.
+    void drawPendingFrame(GraphicsContext*, const FloatRect& dstRect, ColorSpace styleColorSpace, CompositeOperator);
+#endif
+
 private:
     void updateSize() const;
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+    struct AsynchronousDecode;
+    static void decodeOnDecodingThread(AsynchronousDecode*);
+    static void didFinishAsynchronousDecode(void*);
+
+    // Animations decode the frames after the current one on the image
+    // decoding threads, with a decoder of their own.
+    struct AnimationLookAhead;
+    bool usesAnimationLookAhead() const { return m_allDataReceived && !m_animationLookAheadFailed; }
+    void decodeAheadIfNeeded();
+    static void decodeAheadOnDecodingThread(AnimationLookAhead*);
+    static void didFinishDecodingAhead(void*);
+#endif
+
 protected:
     enum RepetitionCountStatus {
       Unknown,    // We haven't checked the source's repetition count.
@@ -206,10 +256,20 @@ protected:
     bool frameHasAlphaAtIndex(size_t);
     ImageOrientation frameOrientationAtIndex(size_t);
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Picks the resolution to decode at for a use that needs |neededPixels|
+    // image pixels, re-decoding if the image would otherwise be scaled up
+    // from a down-sampled frame.
+    void updateDecodedResolution(double neededPixels);
+#endif
+
     // Decodes and caches a frame. Never accessed except internally.
     void cacheFrame(size_t index);
     // Called before accessing m_frames[index]. Returns false on index out of bounds.
     bool ensureFrameIsCached(size_t index);
+    // Whether the frame is cached and complete. Unlike frameIsCompleteAtIndex(),
+    // never decodes.
+    bool frameIsDecodedAtIndex(size_t) const;
 
     // Called to invalidate cached data.  When |destroyAll| is true, we wipe out
     // the entire frame buffer cache and tell the image source to destroy
@@ -220,9 +280,12 @@ protected:
     virtual void destroyDecodedData(bool destroyAll = true);
 
     // If the image is large enough, calls destroyDecodedData() and passes
-    // |destroyAll| along.
+    // |destroyAll| along, or keeps just the frames in the animation window.
     void destroyDecodedDataIfNecessary(bool destroyAll);
 
+    // Clears all frames but the current one and the ones decoded ahead of it.
+    void destroyDecodedDataOutsideAnimationWindow();
+
     // Generally called by destroyDecodedData(), destroys whole-image metadata
     // and notifies observers that the memory footprint has (hopefully)
     // decreased by |frameBytesCleared|.
@@ -243,6 +306,12 @@ protected:
     virtual void startAnimation(bool catchUpIfNecessary = true);
     void advanceAnimation(Timer<BitmapImage>*);
 
+    // How many frames after the current one an animation keeps decoded.
+    size_t animationLookAheadFrameCount();
+    // Whether the animation may move on to the frame without waiting for it
+    // to be decoded.
+    bool frameIsReadyForAnimationAtIndex(size_t);
+
     // Function that does the real work of advancing the animation.  When
     // skippingFrames is true, we're in the middle of a loop trying to skip over
     // a bunch of animation frames, so we should not do things like decode each
@@ -282,6 +351,16 @@ protected:
     Color m_solidColor;  // If we're a 1x1 solid color, this is the color to use to fill.
 
     unsigned m_decodedSize; // The current size of all decoded frames.
+    double m_frameDecodeWallTime; // The time spent decoding frames, see frameDecodeWallTime().
+    double m_timeToFirstPixels; // Kept from the first decoder that output rows, see timeToFirstPixels().
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    unsigned m_maxDecodedPixels; // The cap set by setMaxDecodedPixels().
+#endif
+#if ENABLE(THREADED_IMAGE_DECODING)
+    unsigned m_decoderGeneration; // Bumped whenever the decoder is replaced; stale asynchronous decodes are dropped.
+    AnimationLookAhead* m_animationLookAhead; // Null until needed, and while its decoder is on the image decoding threads.
+    NativeImagePtr m_pendingFrame; // The frame drawPendingFrame() draws; dropped once frame 0 is decoded again.
+#endif
     mutable unsigned m_decodedPropertiesSize; // The size of data decoded by the source to determine image properties (e.g. size, frame count, etc).
     size_t m_frameCount;
 
@@ -291,6 +370,12 @@ protected:
     bool m_animationFinished : 1; // Whether or not we've completed the entire animation.
 
     bool m_allDataReceived : 1; // Whether or not we've received all our data.
+#if ENABLE(THREADED_IMAGE_DECODING)
+    bool m_asynchronousDecodePending : 1; // Whether frame 0 is being decoded on the image decoding threads.
+    bool m_animationLookAheadPending : 1; // Whether animation frames are being decoded on the image decoding threads.
+    bool m_animationWaitingForFrame : 1; // Whether the animation waits for them to advance.
+    bool m_animationLookAheadFailed : 1; // Whether they failed to decode; the animation is then decoded here.
+#endif
     mutable bool m_haveSize : 1; // Whether or not our |m_size| member variable has the final overall image size yet.
     bool m_sizeAvailable : 1; // Whether or not we can obtain the size of the first image frame yet from ImageIO.
     mutable bool m_hasUniformFrameSize : 1;
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "ImageDecodingThreadPool.h"
+
+#include "ImageDecoder.h"
+#include <wtf/HashSet.h>
+#include <wtf/MainThread.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+// Leave a core for the main thread, but don't let a big machine spend more
+// memory on decoded frames at once than a handful of threads can fill.
+static const int maximumNumberOfThreads = 4;
+
+static BackgroundThreadPool* s_sharedPool = 0;
+
+static HashSet<String>& formatsDecodedOnMainThread()
+{
+    DEFINE_STATIC_LOCAL(HashSet<String>, formats, ());
+    return formats;
+}
+
+BackgroundThreadPool* ImageDecodingThreadPool::shared()
+{
+    ASSERT(isMainThread());
+    if (!s_sharedPool) {
+#if USE(QCMSLIB)
+        // Initialize the shared output profile before decoders race for it.
+        ImageDecoder::qcmsOutputDeviceProfile();
+#endif
+        s_sharedPool = new BackgroundThreadPool("WebCore: ImageDecoder", maximumNumberOfThreads);
+    }
+    return s_sharedPool;
+}
+
+void ImageDecodingThreadPool::shutdown()
+{
+    ASSERT(isMainThread());
+    if (!s_sharedPool)
+        return;
+    delete s_sharedPool;
+    s_sharedPool = 0;
+}
+
+bool ImageDecodingThreadPool::canDecodeFormat(const String& format)
+{
+    ASSERT(isMainThread());
+    if (format.isEmpty() || !formatsDecodedOnMainThread().contains(format))
+        return false;
+    if (format == "ico")
+        return formatsDecodedOnMainThread().contains("png");
+    return true;
+}
+
+void ImageDecodingThreadPool::didDecodeFormatOnMainThread(const String& format)
+{
+    ASSERT(isMainThread());
+    if (!format.isEmpty())
+        formatsDecodedOnMainThread().add(format);
+}
+
+} // namespace WebCore
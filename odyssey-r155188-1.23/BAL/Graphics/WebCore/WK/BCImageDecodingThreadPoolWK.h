@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ImageDecodingThreadPool_h
+#define ImageDecodingThreadPool_h
+
+#include "BackgroundThreadPool.h"
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+// A few low priority threads that decode images off the main thread.
+//
+// Each task decodes with a decoder and data of its own, so the decoders only
+// share what their libraries keep in globals:
+// - GIF, BMP and XBM are decoded in WebCore and keep no global state.
+// - libpng keeps all of its state in the png_struct of the decoder. zlib
+//   builds with DYNAMIC_CRC_TABLE fill their CRC table on first use.
+// - libjpeg keeps its state in the decompress struct, but libjpeg-turbo
+//   detects the SIMD extensions into a global on first use.
+// - libwebp before 0.5 sets its DSP function pointers up on first use,
+//   without a lock.
+// - The qcms output profile is created on first use; shared() creates it.
+// All of the lazy globals are read-only once set up, so a format is decoded
+// here only after the main thread has decoded it once, see
+// canDecodeFormat(). ICO embeds PNG, so it also waits for a PNG.
+class ImageDecodingThreadPool {
+public:
+    static BackgroundThreadPool* shared();
+    // Stops and destroys the shared pool, if one was started. Ports whose
+    // child threads must exit before the process does call this on shutdown.
+    static void shutdown();
+
+    // Whether images in |format|, a decoder's filenameExtension(), may be
+    // decoded on the threads. Main thread only.
+    static bool canDecodeFormat(const String& format);
+    // Records that the main thread has decoded a frame in |format|.
+    static void didDecodeFormatOnMainThread(const String& format);
+};
+
+} // namespace WebCore
+
+#endif // ImageDecodingThreadPool_h
@@ -37,13 +37,17 @@
 namespace WebCore {
 
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
-unsigned ImageSource::s_maxPixelsPerDecodedImage = 1024 * 1024;
+// Enough for a full screen image on a 4K display.
+unsigned ImageSource::s_maxPixelsPerDecodedImage = 4096 * 2048;
 #endif
 
 ImageSource::ImageSource(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : m_decoder(0)
     , m_alphaOption(alphaOption)
     , m_gammaAndColorProfileOption(gammaAndColorProfileOption)
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    , m_maxDecodedPixels(s_maxPixelsPerDecodedImage)
+#endif
 {
 }
 
@@ -77,18 +81,31 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
     // This method will examine the data and instantiate an instance of the appropriate decoder plugin.
     // If insufficient bytes are available to determine the image type, no decoder plugin will be
     // made.
-    if (!m_decoder) {
-        m_decoder = static_cast<NativeImageDecoderPtr>(NativeImageDecoder::create(*data, m_alphaOption, m_gammaAndColorProfileOption));
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
-        if (m_decoder && s_maxPixelsPerDecodedImage)
-            m_decoder->setMaxNumPixels(s_maxPixelsPerDecodedImage);
-#endif
-    }
+    if (!m_decoder)
+        m_decoder = createDecoder(*data);
 
     if (m_decoder)
         m_decoder->setData(data, allDataReceived);
 }
 
+NativeImageDecoderPtr ImageSource::createDecoder(const SharedBuffer& data) const
+{
+    NativeImageDecoderPtr decoder = static_cast<NativeImageDecoderPtr>(NativeImageDecoder::create(data, m_alphaOption, m_gammaAndColorProfileOption));
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    if (decoder && m_maxDecodedPixels)
+        decoder->setMaxNumPixels(m_maxDecodedPixels);
+#endif
+    return decoder;
+}
+
+void ImageSource::setDecoder(NativeImageDecoderPtr decoder)
+{
+    if (decoder == m_decoder)
+        return;
+    delete m_decoder;
+    m_decoder = decoder;
+}
+
 String ImageSource::filenameExtension() const
 {
     return m_decoder ? m_decoder->filenameExtension() : String();
@@ -155,6 +172,18 @@ PassNativeImagePtr ImageSource::createFrameAtIndex(size_t index)
     return buffer->asNewNativeImage();
 }
 
+PassNativeImagePtr ImageSource::createFrameCopyAtIndex(size_t index)
+{
+    if (!m_decoder)
+        return 0;
+
+    ImageFrame* buffer = m_decoder->frameBufferAtIndex(index);
+    if (!buffer || buffer->status() == ImageFrame::FrameEmpty || size().isEmpty())
+        return 0;
+
+    return buffer->asNewNativeImageCopy();
+}
+
 float ImageSource::frameDurationAtIndex(size_t index)
 {
     if (!m_decoder)
@@ -202,4 +231,11 @@ unsigned ImageSource::frameBytesAtIndex(size_t index) const
     return m_decoder->frameBytesAtIndex(index);
 }
 
+double ImageSource::timeToFirstPixels() const
+{
+    if (!m_decoder)
+        return 0;
+    return m_decoder->timeToFirstPixels();
+}
+
 }
@@ -131,6 +131,13 @@ public:
     void setData(SharedBuffer* data, bool allDataReceived);
     String filenameExtension() const;
 
+    // Creates a decoder for |data| configured like the one setData() would
+    // create, without feeding it any data. The caller owns the result, which
+    // may be used on another thread and later handed back with setDecoder().
+    NativeImageDecoderPtr createDecoder(const SharedBuffer& data) const;
+    // Replaces the current decoder, taking ownership of |decoder|.
+    void setDecoder(NativeImageDecoderPtr decoder);
+
     bool isSizeAvailable();
     IntSize size(ImageOrientationDescription = ImageOrientationDescription()) const;
     IntSize frameSizeAtIndex(size_t, ImageOrientationDescription = ImageOrientationDescription()) const;
@@ -146,6 +153,9 @@ public:
     // Callers should not call this after calling clear() with a higher index;
     // see comments on clear() above.
     PassNativeImagePtr createFrameAtIndex(size_t);
+    // Like createFrameAtIndex(), but the frame keeps its own copy of the
+    // pixels, so it stays valid after clear() and the decoder are gone.
+    PassNativeImagePtr createFrameCopyAtIndex(size_t);
 
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t); // Whether or not the frame actually used any alpha.
@@ -156,9 +166,19 @@ public:
     // decoded then return 0.
     unsigned frameBytesAtIndex(size_t) const;
 
+    // Seconds from the first data to the first decoded rows, or 0 if there
+    // are none yet or the decoder does not tell.
+    double timeToFirstPixels() const;
+
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
     static unsigned maxPixelsPerDecodedImage() { return s_maxPixelsPerDecodedImage; }
     static void setMaxPixelsPerDecodedImage(unsigned maxPixels) { s_maxPixelsPerDecodedImage = maxPixels; }
+
+    // Limit for this source, initially maxPixelsPerDecodedImage(); 0 means no
+    // limit. Takes effect when the next decoder is created by setData(),
+    // i.e. after clear(true).
+    unsigned maxDecodedPixels() const { return m_maxDecodedPixels; }
+    void setMaxDecodedPixels(unsigned maxPixels) { m_maxDecodedPixels = maxPixels; }
 #endif
 
 private:
@@ -169,6 +189,7 @@ private:
     GammaAndColorProfileOption m_gammaAndColorProfileOption;
 #endif
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    unsigned m_maxDecodedPixels;
     static unsigned s_maxPixelsPerDecodedImage;
 #endif
 };
@@ -144,7 +144,14 @@ public:
     enum TileRule { StretchTile, RoundTile, SpaceTile, RepeatTile };
 
     virtual PassNativeImagePtr nativeImageForCurrentFrame() { return 0; }
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // The current frame decoded for drawing |neededPixels| device pixels of it, which may be a
+    // down-sampled frame smaller than size().
+    virtual PassNativeImagePtr nativeImageForCurrentFrameAtResolution(double) { return nativeImageForCurrentFrame(); }
+#endif
     virtual ImageOrientation orientationForCurrentFrame() { return ImageOrientation(); }
+    // False while the decoder still writes into the pixels of the current frame.
+    virtual bool currentFrameIsComplete() { return true; }
     
 #if PLATFORM(MAC)
     // Accessors for native image formats.
@@ -57,6 +57,11 @@ namespace WebCore {
 class LayerWebKitThread;
 typedef LayerWebKitThread PlatformLayer;
 }
+#elif USE(TEXTURE_MAPPER)
+namespace WebCore {
+class TextureMapperPlatformLayer;
+typedef TextureMapperPlatformLayer PlatformLayer;
+};
 #else
 typedef void* PlatformLayer;
 #endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "TileRasterizerThreadPool.h"
+
+#if USE(TILED_BACKING_STORE)
+
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+// Tiles are large and few are dirty at once; more threads would only
+// hold more back buffers in memory.
+static const int maximumNumberOfThreads = 2;
+
+static BackgroundThreadPool* s_sharedPool = 0;
+
+BackgroundThreadPool* TileRasterizerThreadPool::shared()
+{
+    ASSERT(isMainThread());
+    if (!s_sharedPool)
+        s_sharedPool = new BackgroundThreadPool("WebCore: TileRasterizer", maximumNumberOfThreads);
+    return s_sharedPool;
+}
+
+void TileRasterizerThreadPool::shutdown()
+{
+    ASSERT(isMainThread());
+    if (!s_sharedPool)
+        return;
+    delete s_sharedPool;
+    s_sharedPool = 0;
+}
+
+} // namespace WebCore
+
+#endif // USE(TILED_BACKING_STORE)
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TileRasterizerThreadPool_h
+#define TileRasterizerThreadPool_h
+
+#if USE(TILED_BACKING_STORE)
+
+#include "BackgroundThreadPool.h"
+
+namespace WebCore {
+
+// Threads that replay the paint commands recorded for a tile of the tiled
+// backing store into its back buffer. If the pool has no threads, tiles are
+// rasterized on the main thread.
+class TileRasterizerThreadPool {
+public:
+    static BackgroundThreadPool* shared();
+    // Stops and destroys the shared pool, if one was started. Ports whose
+    // child threads must exit before the process does call this on shutdown.
+    static void shutdown();
+};
+
+} // namespace WebCore
+
+#endif // USE(TILED_BACKING_STORE)
+
+#endif // TileRasterizerThreadPool_h
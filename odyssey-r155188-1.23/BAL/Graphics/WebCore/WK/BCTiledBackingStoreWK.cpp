@@ -24,10 +24,13 @@
 
 #include "GraphicsContext.h"
 #include "TiledBackingStoreClient.h"
+#include <algorithm>
 
 namespace WebCore {
 
 static const int defaultTileDimension = 512;
+static const size_t defaultTileMemoryBudget = 32 * 1024 * 1024;
+static const unsigned bytesPerPixel = 4;
 
 static IntPoint innerBottomRight(const IntRect& rect)
 {
@@ -35,6 +38,11 @@ static IntPoint innerBottomRight(const IntRect& rect)
     return IntPoint(rect.maxX() - 1, rect.maxY() - 1);
 }
 
+static bool farthestTileFirst(const std::pair<double, Tile::Coordinate>& a, const std::pair<double, Tile::Coordinate>& b)
+{
+    return a.first > b.first;
+}
+
 TiledBackingStore::TiledBackingStore(TiledBackingStoreClient* client, PassOwnPtr<TiledBackingStoreBackend> backend)
     : m_client(client)
     , m_backend(backend)
@@ -42,6 +50,7 @@ TiledBackingStore::TiledBackingStore(TiledBackingStoreClient* client, PassOwnPtr
     , m_backingStoreUpdateTimer(this, &TiledBackingStore::backingStoreUpdateTimerFired)
     , m_tileSize(defaultTileDimension, defaultTileDimension)
     , m_coverAreaMultiplier(2.0f)
+    , m_tileMemoryBudget(defaultTileMemoryBudget)
     , m_contentsScale(1.f)
     , m_pendingScale(0)
     , m_commitTileUpdatesOnIdleEventLoop(false)
@@ -124,9 +133,8 @@ void TiledBackingStore::updateTileBuffers()
         return;
     }
 
-    // FIXME: In single threaded case, tile back buffers could be updated asynchronously 
-    // one by one and then swapped to front in one go. This would minimize the time spent
-    // blocking on tile updates.
+    // Tiles that rasterize on another thread paint nothing here, and report
+    // back through tileBufferUpdated() once their new buffer is in front.
     unsigned size = dirtyTiles.size();
     for (unsigned n = 0; n < size; ++n) {
         Vector<IntRect> paintedRects = dirtyTiles[n]->updateBackBuffer();
@@ -137,6 +145,50 @@ void TiledBackingStore::updateTileBuffers()
     m_client->tiledBackingStorePaintEnd(paintedArea);
 }
 
+void TiledBackingStore::tileBufferUpdated(Tile* tile, const Vector<IntRect>& paintedArea)
+{
+    m_client->tiledBackingStorePaintEnd(paintedArea);
+
+    // Invalidations that arrived while the tile was rasterized are still pending.
+    if (tile->isDirty())
+        startTileBufferUpdateTimer();
+}
+
+bool TiledBackingStore::tileIntersectsVisibleRect(const Tile::Coordinate& coordinate) const
+{
+    return m_visibleRect.intersects(tileRectForCoordinate(coordinate));
+}
+
+void TiledBackingStore::setTileMemoryBudget(size_t budget)
+{
+    m_tileMemoryBudget = budget;
+    makeRoomForTiles(0, 0);
+    startBackingStoreUpdateTimer();
+}
+
+bool TiledBackingStore::makeRoomForTiles(unsigned count, double distance)
+{
+    size_t bytesPerTile = m_tileSize.width() * m_tileSize.height() * bytesPerPixel;
+    size_t maximumTileCount = m_tileMemoryBudget / bytesPerTile;
+    if (m_tiles.size() + count <= maximumTileCount)
+        return true;
+
+    // Drop the tiles farther from the viewport than the ones to create,
+    // starting with the farthest.
+    Vector<std::pair<double, Tile::Coordinate> > candidates;
+    TileMap::iterator end = m_tiles.end();
+    for (TileMap::iterator it = m_tiles.begin(); it != end; ++it) {
+        double tileDistance = this->tileDistance(m_visibleRect, it->key);
+        if (tileDistance > distance)
+            candidates.append(std::make_pair(tileDistance, it->key));
+    }
+    std::sort(candidates.begin(), candidates.end(), farthestTileFirst);
+
+    for (size_t i = 0; i < candidates.size() && m_tiles.size() + count > maximumTileCount; ++i)
+        removeTile(candidates[i].second);
+    return m_tiles.size() + count <= maximumTileCount;
+}
+
 void TiledBackingStore::paint(GraphicsContext* context, const IntRect& rect)
 {
     context->save();
@@ -316,6 +368,13 @@ void TiledBackingStore::createTiles()
         }
     }
 
+    // Tiles in the visible rect are always created. Others are only created while they fit in
+    // the memory budget, which stops pre-rendering until the viewport moves.
+    if (shortestDistance > 0 && !tilesToCreate.isEmpty() && !makeRoomForTiles(tilesToCreate.size(), shortestDistance)) {
+        tilesToCreate.clear();
+        requiredTileCount = 0;
+    }
+
     // Now construct the tile(s) within the shortest distance.
     unsigned tilesToCreateCount = tilesToCreate.size();
     for (unsigned n = 0; n < tilesToCreateCount; ++n) {
@@ -80,6 +80,17 @@ public:
 
     void setSupportsAlpha(bool);
 
+    // Tiles are only created beyond the visible area while they fit in this
+    // many bytes; the ones farthest from the viewport are dropped first.
+    size_t tileMemoryBudget() const { return m_tileMemoryBudget; }
+    void setTileMemoryBudget(size_t);
+
+    bool tileIntersectsVisibleRect(const Tile::Coordinate&) const;
+
+    // Called by tiles whose back buffer was rasterized on another thread,
+    // once it has been swapped to the front.
+    void tileBufferUpdated(Tile*, const Vector<IntRect>& paintedArea);
+
 private:
     void startTileBufferUpdateTimer();
     void startBackingStoreUpdateTimer(double = 0);
@@ -96,6 +107,7 @@ private:
     void commitScaleChange();
 
     bool resizeEdgeTiles();
+    bool makeRoomForTiles(unsigned count, double distance);
     void setCoverRect(const IntRect& rect) { m_coverRect = rect; }
     void setKeepRect(const IntRect&);
 
@@ -122,6 +134,7 @@ private:
 
     IntSize m_tileSize;
     float m_coverAreaMultiplier;
+    size_t m_tileMemoryBudget;
 
     FloatPoint m_trajectoryVector;
     FloatPoint m_pendingTrajectoryVector;
@@ -37,4 +37,19 @@ PassNativeImagePtr ImageFrame::asNewNativeImage() const
         CAIRO_FORMAT_ARGB32, width(), height(), width() * sizeof(PixelData)));
 }
 
+PassNativeImagePtr ImageFrame::asNewNativeImageCopy() const
+{
+    RefPtr<cairo_surface_t> surface = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width(), height()));
+    if (cairo_surface_status(surface.get()) != CAIRO_STATUS_SUCCESS)
+        return 0;
+
+    unsigned char* destination = cairo_image_surface_get_data(surface.get());
+    const int stride = cairo_image_surface_get_stride(surface.get());
+    const size_t rowBytes = width() * sizeof(PixelData);
+    for (int y = 0; y < height(); ++y)
+        memcpy(destination + y * stride, m_bytes + y * width(), rowBytes);
+    cairo_surface_mark_dirty(surface.get());
+    return surface.release();
+}
+
 } // namespace WebCore
@@ -37,6 +37,7 @@ GIFImageDecoder::GIFImageDecoder(ImageSource::AlphaOption alphaOption,
                                  ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : ImageDecoder(alphaOption, gammaAndColorProfileOption)
     , m_repetitionCount(cAnimationLoopOnce)
+    , m_paletteFrameIndex(notFound)
 {
 }
 
@@ -175,14 +176,48 @@ void GIFImageDecoder::clearFrameBufferCache(size_t clearBeforeFrame)
             i->clearPixelData();
     }
 
-    // Now |i| holds the last frame we need to preserve; clear prior frames.
+    // Now |i| holds the last frame we need to preserve; clear prior frames,
+    // except for the checkpoints.
     for (Vector<ImageFrame>::iterator j(m_frameBufferCache.begin()); j != i; ++j) {
         ASSERT(j->status() != ImageFrame::FramePartial);
-        if (j->status() != ImageFrame::FrameEmpty)
+        if (j->status() != ImageFrame::FrameEmpty && !isCheckpoint(j - m_frameBufferCache.begin()))
             j->clearPixelData();
     }
 }
 
+bool GIFImageDecoder::isCheckpoint(size_t frameIndex) const
+{
+    // A few evenly spaced frames, fewer for large images, so that a frame
+    // cleared earlier is rebuilt from the nearest checkpoint rather than by
+    // replaying the animation from its first frame.
+    static const size_t cMaxCheckpoints = 3;
+    static const size_t cMaxCheckpointBytes = 4 * 1024 * 1024;
+    static const size_t cMinFramesBetweenCheckpoints = 8;
+
+    const ImageFrame& frame = m_frameBufferCache[frameIndex];
+    if (frame.status() != ImageFrame::FrameComplete || frame.disposalMethod() == ImageFrame::DisposeOverwritePrevious)
+        return false;
+
+    const size_t frameBytes = std::max<size_t>(scaledSize().width() * scaledSize().height() * sizeof(ImageFrame::PixelData), 1);
+    const size_t checkpoints = std::min(cMaxCheckpoints, cMaxCheckpointBytes / frameBytes);
+    if (!checkpoints)
+        return false;
+    const size_t framesBetweenCheckpoints = std::max(cMinFramesBetweenCheckpoints, m_frameBufferCache.size() / (checkpoints + 1));
+    return !((frameIndex + 1) % framesBetweenCheckpoints);
+}
+
+size_t GIFImageDecoder::resumeFrameFor(size_t frameIndex) const
+{
+    // initFrameBuffer() skips DisposeOverwritePrevious frames when looking
+    // for the frame to start from, so they can't be resumed from either.
+    for (size_t i = frameIndex; i; --i) {
+        const ImageFrame& frame = m_frameBufferCache[i - 1];
+        if (frame.status() == ImageFrame::FrameComplete && frame.disposalMethod() != ImageFrame::DisposeOverwritePrevious)
+            return i;
+    }
+    return 0;
+}
+
 bool GIFImageDecoder::haveDecodedRow(unsigned frameIndex, const Vector<unsigned char>& rowBuffer, size_t width, size_t rowNumber, unsigned repeatCount, bool writeTransparentPixels)
 {
     const GIFFrameContext* frameContext = m_reader->frameContext();
@@ -217,14 +252,20 @@ bool GIFImageDecoder::haveDecodedRow(unsigned frameIndex, const Vector<unsigned
     if (((buffer.status() == ImageFrame::FrameEmpty) && !initFrameBuffer(frameIndex)) || !buffer.hasPixelData())
         return false;
 
+    // A frame has a single colormap, which arrives before its rows.
+    if (m_paletteFrameIndex != frameIndex) {
+        m_palette.resize(colorMapSize);
+        ImageFrame::setRGBRow(m_palette.data(), colorMap, colorMapSize);
+        m_paletteFrameIndex = frameIndex;
+    }
+
     ImageFrame::PixelData* currentAddress = buffer.getAddr(xBegin, yBegin);
     // Write one row's worth of data into the frame.  
     for (int x = xBegin; x < xEnd; ++x) {
         const unsigned char sourceValue = rowBuffer[(m_scaled ? m_scaledColumns[x] : x) - frameContext->xOffset];
-        if ((!frameContext->isTransparent || (sourceValue != frameContext->tpixel)) && (sourceValue < colorMapSize)) {
-            const size_t colorIndex = static_cast<size_t>(sourceValue) * 3;
-            buffer.setRGBA(currentAddress, colorMap[colorIndex], colorMap[colorIndex + 1], colorMap[colorIndex + 2], 255);
-        } else {
+        if ((!frameContext->isTransparent || (sourceValue != frameContext->tpixel)) && (sourceValue < colorMapSize))
+            *currentAddress = m_palette[sourceValue];
+        else {
             m_currentBufferSawAlpha = true;
             // We may or may not need to write transparent pixels to the buffer.
             // If we're compositing against a previous image, it's wrong, and if
@@ -330,6 +371,13 @@ void GIFImageDecoder::decode(unsigned haltAtFrame, GIFQuery query)
     if (query == GIFFrameCountQuery)
         return;
 
+    // Once all the data is here no frame is partially decoded, so rather than
+    // go on from wherever the reader stopped, or replay the animation from its
+    // first frame when the reader was recreated, start at the nearest frame
+    // the one asked for can be composited onto.
+    if (isAllDataReceived() && haltAtFrame && haltAtFrame <= m_frameBufferCache.size())
+        m_reader->setCurrentDecodingFrame(resumeFrameFor(haltAtFrame - 1));
+
     if (!m_reader->decode(GIFFullQuery, haltAtFrame)) {
         setFailed();
         return;
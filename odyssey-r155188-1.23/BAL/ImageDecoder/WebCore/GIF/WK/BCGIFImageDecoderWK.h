@@ -72,9 +72,23 @@ namespace WebCore {
         // failure, this will mark the image as failed.
         bool initFrameBuffer(unsigned frameIndex);
 
+        // Whether clearFrameBufferCache() keeps the frame with the given index
+        // as a checkpoint that decoding can later resume from.
+        bool isCheckpoint(size_t frameIndex) const;
+
+        // Returns the frame decoding has to start at to produce |frameIndex|:
+        // the one after the nearest complete frame it can be composited onto,
+        // or the first frame.
+        size_t resumeFrameFor(size_t frameIndex) const;
+
         bool m_currentBufferSawAlpha;
         mutable int m_repetitionCount;
         OwnPtr<GIFImageReader> m_reader;
+
+        // The colormap of frame |m_paletteFrameIndex| expanded to pixels, so
+        // that rows are written with one lookup per pixel.
+        Vector<ImageFrame::PixelData, 256> m_palette;
+        size_t m_paletteFrameIndex;
     };
 
 } // namespace WebCore
@@ -287,6 +287,15 @@ public:
         return m_currentDecodingFrame < m_frames.size() ? m_frames[m_currentDecodingFrame].get() : 0;
     }
 
+    // Makes the next decode() start at |frameIndex|. The client must already
+    // have the frame it is composited onto, and no frame may be partially
+    // decoded.
+    void setCurrentDecodingFrame(size_t frameIndex)
+    {
+        ASSERT(frameIndex <= m_frames.size());
+        m_currentDecodingFrame = frameIndex;
+    }
+
 private:
     bool parse(size_t dataPosition, size_t len, bool parseSizeOnly);
     void setRemainingBytes(size_t);
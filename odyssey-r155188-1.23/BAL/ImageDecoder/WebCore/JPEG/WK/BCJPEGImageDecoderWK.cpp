@@ -40,6 +40,7 @@
 #include "config.h"
 #include "JPEGImageDecoder.h"
 #include "PlatformInstrumentation.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/PassOwnPtr.h>
 
 extern "C" {
@@ -84,6 +85,13 @@ inline bool doFancyUpsampling() { return true; }
 
 const int exifMarker = JPEG_APP0 + 1;
 
+// Every output pass of a progressive JPEG redoes the inverse DCT and color
+// conversion of the whole image. While the image loads, a new pass starts
+// once a new scan is complete, but no sooner than this many seconds after
+// the last one and never taking more than a fifth of the time.
+const double minimumProgressiveOutputInterval = 0.1;
+const double progressiveOutputIntervalPerPassTime = 4;
+
 namespace WebCore {
 
 struct decoder_error_mgr {
@@ -244,6 +252,8 @@ public:
         , m_bytesToSkip(0)
         , m_state(JPEG_HEADER)
         , m_samples(0)
+        , m_lastCompletedScan(0)
+        , m_nextOutputPassTime(0)
 #if USE(QCMSLIB)
         , m_transform(0)
 #endif
@@ -399,9 +409,23 @@ public:
             // image is a sequential JPEG.
             m_info.buffered_image = jpeg_has_multiple_scans(&m_info);
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+            // Let the inverse DCT do most of the down sampling; the remaining
+            // rows and columns are skipped in outputScanlines().
+            if (m_decoder->willDownSample()) {
+                m_info.scale_num = 1;
+                m_info.scale_denom = m_decoder->dctScaleDenominator();
+            }
+#endif
+
             // Used to set up image size so arrays can be allocated.
             jpeg_calc_output_dimensions(&m_info);
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+            if (m_decoder->willDownSample())
+                m_decoder->setDCTScaledSize(IntSize(m_info.output_width, m_info.output_height));
+#endif
+
             // Make a one-row-high sample array that will go away when done with
             // image. Always make it big enough to hold an RGB row. Since this
             // uses the IJG memory manager, it must be allocated before the call
@@ -453,25 +477,38 @@ public:
                 int status;
                 do {
                     status = jpeg_consume_input(&m_info);
+                    if (status == JPEG_SCAN_COMPLETED)
+                        m_lastCompletedScan = m_info.input_scan_number;
                 } while ((status != JPEG_SUSPENDED) && (status != JPEG_REACHED_EOI));
 
+                double passStartTime = 0;
                 for (;;) {
                     if (!m_info.output_scanline) {
-                        int scan = m_info.input_scan_number;
-
-                        // If we haven't displayed anything yet
-                        // (output_scan_number == 0) and we have enough data for
-                        // a complete scan, force output of the last full scan.
-                        if (!m_info.output_scan_number && (scan > 1) && (status != JPEG_REACHED_EOI))
-                            --scan;
+                        int scan;
+                        if (jpeg_input_complete(&m_info))
+                            scan = m_info.input_scan_number;
+                        else if (!m_info.output_scan_number) {
+                            // If we haven't displayed anything yet, show the
+                            // last full scan, or else the rows of the first
+                            // scan as they arrive.
+                            scan = m_lastCompletedScan ? m_lastCompletedScan : m_info.input_scan_number;
+                        } else {
+                            // Later passes only show complete scans, so that
+                            // they never stop halfway waiting for data.
+                            if (m_lastCompletedScan <= m_info.output_scan_number || monotonicallyIncreasingTime() < m_nextOutputPassTime)
+                                return false; // Wait for more data.
+                            scan = m_lastCompletedScan;
+                        }
 
                         if (!jpeg_start_output(&m_info, scan))
                             return false; // I/O suspension.
+                        passStartTime = monotonicallyIncreasingTime();
                     }
 
                     if (m_info.output_scanline == 0xffffff)
                         m_info.output_scanline = 0;
 
+                    bool passHadRowsLeft = m_info.output_scanline < m_info.output_height;
                     if (!m_decoder->outputScanlines()) {
                         if (!m_info.output_scanline)
                             // Didn't manage to read any lines - flag so we
@@ -482,6 +519,14 @@ public:
                     }
 
                     if (m_info.output_scanline == m_info.output_height) {
+                        if (passHadRowsLeft) {
+                            // A pass started by an earlier call waited for
+                            // rows from the network, so it is not timed.
+                            double now = monotonicallyIncreasingTime();
+                            double passTime = passStartTime ? now - passStartTime : 0;
+                            m_nextOutputPassTime = now + std::max(minimumProgressiveOutputInterval, passTime * progressiveOutputIntervalPerPassTime);
+                        }
+
                         if (!jpeg_finish_output(&m_info))
                             return false; // I/O suspension.
 
@@ -549,6 +594,9 @@ private:
 
     JSAMPARRAY m_samples;
 
+    int m_lastCompletedScan; // The last scan of a progressive JPEG that was read entirely.
+    double m_nextOutputPassTime; // The earliest time the next progressive output pass may start.
+
 #if USE(QCMSLIB)
     qcms_transform* m_transform;
 #endif
@@ -613,6 +661,28 @@ bool JPEGImageDecoder::setSize(unsigned width, unsigned height)
     return true;
 }
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+unsigned JPEGImageDecoder::dctScaleDenominator() const
+{
+    // libjpeg scales by 1/2, 1/4 and 1/8, rounding the output size up.
+    IntSize targetSize = scaledSize();
+    unsigned denominator = 8;
+    while (denominator > 1) {
+        unsigned width = (size().width() + denominator - 1) / denominator;
+        unsigned height = (size().height() + denominator - 1) / denominator;
+        if (width >= static_cast<unsigned>(targetSize.width()) && height >= static_cast<unsigned>(targetSize.height()))
+            break;
+        denominator /= 2;
+    }
+    return denominator;
+}
+
+void JPEGImageDecoder::setDCTScaledSize(const IntSize& dctScaledSize)
+{
+    rescaleScaleDataForDecodedSize(dctScaledSize);
+}
+#endif
+
 ImageFrame* JPEGImageDecoder::frameBufferAtIndex(size_t index)
 {
     if (index)
@@ -681,6 +751,7 @@ bool JPEGImageDecoder::outputScanlines(ImageFrame& buffer)
         int destY = scaledY(sourceY);
         if (destY < 0)
             continue;
+        didDecodeFirstPixels();
 
 #if USE(QCMSLIB)
         if (m_reader->colorTransform() && colorSpace == JCS_RGB)
@@ -688,6 +759,13 @@ bool JPEGImageDecoder::outputScanlines(ImageFrame& buffer)
 #endif
 
         ImageFrame::PixelData* currentAddress = buffer.getAddr(0, destY);
+        if (!isScaled) {
+            if (colorSpace == JCS_RGB)
+                ImageFrame::setRGBRow(currentAddress, *samples, width);
+            else
+                ImageFrame::setInvertedCMYKRow(currentAddress, *samples, width);
+            continue;
+        }
         for (int x = 0; x < width; ++x) {
             setPixel<colorSpace>(buffer, currentAddress, samples, isScaled ? m_scaledColumns[x] : x);
             ++currentAddress;
@@ -730,6 +808,7 @@ bool JPEGImageDecoder::outputScanlines()
             unsigned char* row = reinterpret_cast<unsigned char*>(buffer.getAddr(0, info->output_scanline));
             if (jpeg_read_scanlines(info, &row, 1) != 1)
                 return false;
+            didDecodeFirstPixels();
 #if USE(QCMSLIB)
             if (qcms_transform* transform = m_reader->colorTransform())
                 qcms_transform_data_type(transform, row, row, info->output_width, rgbOutputColorSpace() == JCS_EXT_BGRA ? QCMS_OUTPUT_BGRX : QCMS_OUTPUT_RGBX);
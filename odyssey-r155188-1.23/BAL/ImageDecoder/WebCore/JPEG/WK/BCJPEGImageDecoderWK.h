@@ -75,6 +75,14 @@ namespace WebCore {
             return m_scaled;
         }
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+        // The largest DCT scaling denominator that still yields at least
+        // scaledSize() pixels.
+        unsigned dctScaleDenominator() const;
+        // Called with the output size libjpeg computed for that denominator.
+        void setDCTScaledSize(const IntSize&);
+#endif
+
         bool outputScanlines();
         void jpegComplete();
 
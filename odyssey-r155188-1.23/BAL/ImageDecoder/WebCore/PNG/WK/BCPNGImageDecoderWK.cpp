@@ -40,7 +40,6 @@
 #include "config.h"
 #include "PNGImageDecoder.h"
 
-#include "Color.h"
 #include "PlatformInstrumentation.h"
 //#if OS(MORPHOS)
 //#include <libraries/png.h>
@@ -519,29 +518,6 @@ void PNGImageDecoder::headerAvailable()
     }
 }
 
-static inline void setPixelRGB(ImageFrame::PixelData* dest, png_bytep pixel)
-{
-    *dest = 0xFF000000U | pixel[0] << 16 | pixel[1] << 8 | pixel[2];
-}
-
-static inline void setPixelRGBA(ImageFrame::PixelData* dest, png_bytep pixel, unsigned char& nonTrivialAlphaMask)
-{
-    unsigned char a = pixel[3];
-    *dest = a << 24 | pixel[0] << 16 | pixel[1] << 8 | pixel[2];
-    nonTrivialAlphaMask |= (255 - a);
-}
-
-static inline void setPixelPremultipliedRGBA(ImageFrame::PixelData* dest, png_bytep pixel, unsigned char& nonTrivialAlphaMask)
-{
-    unsigned char a = pixel[3];
-    unsigned char r = fastDivideBy255(pixel[0] * a);
-    unsigned char g = fastDivideBy255(pixel[1] * a);
-    unsigned char b = fastDivideBy255(pixel[2] * a);
-
-    *dest = a << 24 | r << 16 | g << 8 | b;
-    nonTrivialAlphaMask |= (255 - a);
-}
-
 void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex, int)
 {
     if (m_frameBufferCache.isEmpty())
@@ -674,21 +650,12 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     } else
 #endif
     {
-        png_bytep pixel = row;
-        if (hasAlpha) {
-            if (buffer.premultiplyAlpha()) {
-                for (int x = 0; x < width; ++x, pixel += 4)
-                    setPixelPremultipliedRGBA(address++, pixel, nonTrivialAlphaMask);
-            } else {
-                for (int x = 0; x < width; ++x, pixel += 4)
-                    setPixelRGBA(address++, pixel, nonTrivialAlphaMask);
-            }
-        } else {
-            for (int x = 0; x < width; ++x, pixel += 3)
-                setPixelRGB(address++, pixel);
-        }
+        if (hasAlpha)
+            nonTrivialAlphaMask = buffer.setRGBARow(address, row, width);
+        else
+            ImageFrame::setRGBRow(address, row, width);
     }
-
+    didDecodeFirstPixels();
 
     if (nonTrivialAlphaMask && !buffer.hasAlpha())
         buffer.setHasAlpha(true);
@@ -1043,7 +1010,9 @@ void PNGImageDecoder::frameComplete()
 int PNGImageDecoder::processingStart(png_unknown_chunkp chunk)
 {
     static png_byte dataPNG[8] = {137, 80, 78, 71, 13, 10, 26, 10};
-    static png_byte datagAMA[16] = {0, 0, 0, 4, 103, 65, 77, 65};
+    // Patched with this image's gamma below, so it must not be shared by
+    // decoders running on other threads.
+    png_byte datagAMA[16] = {0, 0, 0, 4, 103, 65, 77, 65};
 
     if (!m_hasInfo)
         return 0;
@@ -52,7 +52,7 @@
 inline WEBP_CSP_MODE outputMode(bool hasAlpha) { return hasAlpha ? MODE_Argb : MODE_ARGB; }
 #elif CPU(MIDDLE_ENDIAN)
 inline WEBP_CSP_MODE outputMode(bool hasAlpha) { return hasAlpha ? MODE_rgbA : MODE_RGBA; }
-#elif // LITTLE_ENDIAN, output BGRA pixels.
+#else // LITTLE_ENDIAN, output BGRA pixels.
 inline WEBP_CSP_MODE outputMode(bool hasAlpha) { return hasAlpha ? MODE_bgrA : MODE_BGRA; }
 #endif
 
@@ -62,6 +62,7 @@ WEBPImageDecoder::WEBPImageDecoder(ImageSource::AlphaOption alphaOption,
                                    ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : ImageDecoder(alphaOption, gammaAndColorProfileOption)
     , m_decoder(0)
+    , m_consumedDataSize(0)
     , m_hasAlpha(false)
     , m_formatFlags(0)
 #ifdef QCMS_WEBP_COLOR_CORRECTION
@@ -97,6 +98,15 @@ bool WEBPImageDecoder::isSizeAvailable()
     return ImageDecoder::isSizeAvailable();
 }
 
+bool WEBPImageDecoder::setSize(unsigned width, unsigned height)
+{
+    if (!ImageDecoder::setSize(width, height))
+        return false;
+
+    prepareScaleDataIfNecessary();
+    return true;
+}
+
 ImageFrame* WEBPImageDecoder::frameBufferAtIndex(size_t index)
 {
     if (index)
@@ -173,7 +183,7 @@ void WEBPImageDecoder::readColorProfile(const uint8_t* data, size_t size)
     WebPDemuxDelete(demuxer);
 }
 
-void WEBPImageDecoder::applyColorProfile(const uint8_t* data, size_t size, ImageFrame& buffer)
+void WEBPImageDecoder::applyColorProfile(ImageFrame& buffer)
 {
     int width;
     int decodedHeight;
@@ -183,7 +193,7 @@ void WEBPImageDecoder::applyColorProfile(const uint8_t* data, size_t size, Image
         return;
 
     if (!m_haveReadProfile) {
-        readColorProfile(data, size);
+        readColorProfile(reinterpret_cast<const uint8_t*>(m_data->data()), m_data->size());
         m_haveReadProfile = true;
     }
 
@@ -194,9 +204,7 @@ void WEBPImageDecoder::applyColorProfile(const uint8_t* data, size_t size, Image
         uint8_t* row = reinterpret_cast<uint8_t*>(buffer.getAddr(0, y));
         if (qcms_transform* transform = colorTransform())
             qcms_transform_data_type(transform, row, row, width, QCMS_OUTPUT_RGBX);
-        uint8_t* pixel = row;
-        for (int x = 0; x < width; ++x, pixel += 4)
-            buffer.setRGBA(x, y, pixel[0], pixel[1], pixel[2], pixel[3]);
+        buffer.setRGBARow(buffer.getAddr(0, y), row, width);
     }
 
     m_decodedHeight = decodedHeight;
@@ -209,13 +217,12 @@ bool WEBPImageDecoder::decode(bool onlySize)
     if (failed())
         return false;
 
-    const uint8_t* dataBytes = reinterpret_cast<const uint8_t*>(m_data->data());
-    const size_t dataSize = m_data->size();
-
     if (!ImageDecoder::isSizeAvailable()) {
         static const size_t imageHeaderSize = 30;
-        if (dataSize < imageHeaderSize)
+        if (m_data->size() < imageHeaderSize)
             return false;
+        const uint8_t* dataBytes = reinterpret_cast<const uint8_t*>(m_data->data());
+        const size_t dataSize = m_data->size();
         int width, height;
 #ifdef QCMS_WEBP_COLOR_CORRECTION
         WebPData inputData = { dataBytes, dataSize };
@@ -258,7 +265,7 @@ bool WEBPImageDecoder::decode(bool onlySize)
     ASSERT(buffer.status() != ImageFrame::FrameComplete);
 
     if (buffer.status() == ImageFrame::FrameEmpty) {
-        if (!buffer.setSize(size().width(), size().height()))
+        if (!buffer.setSize(scaledSize().width(), scaledSize().height()))
             return setFailed();
         buffer.setStatus(ImageFrame::FramePartial);
         buffer.setHasAlpha(m_hasAlpha);
@@ -271,29 +278,59 @@ bool WEBPImageDecoder::decode(bool onlySize)
             mode = outputMode(false);
         if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile())
             mode = MODE_RGBA; // Decode to RGBA for input to libqcms.
-        int rowStride = size().width() * sizeof(ImageFrame::PixelData);
+        int rowStride = scaledSize().width() * sizeof(ImageFrame::PixelData);
         uint8_t* output = reinterpret_cast<uint8_t*>(buffer.getAddr(0, 0));
-        int outputSize = size().height() * rowStride;
-        m_decoder = WebPINewRGB(mode, output, outputSize, rowStride);
+        int outputSize = scaledSize().height() * rowStride;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+        if (m_scaled) {
+            // libwebp resamples while decoding, so only the scaled output size
+            // from m_scaledColumns and m_scaledRows is used here.
+            if (!WebPInitDecoderConfig(&m_decoderConfig))
+                return setFailed();
+            m_decoderConfig.options.use_scaling = 1;
+            m_decoderConfig.options.scaled_width = scaledSize().width();
+            m_decoderConfig.options.scaled_height = scaledSize().height();
+            m_decoderConfig.output.colorspace = mode;
+            m_decoderConfig.output.is_external_memory = 1;
+            m_decoderConfig.output.u.RGBA.rgba = output;
+            m_decoderConfig.output.u.RGBA.stride = rowStride;
+            m_decoderConfig.output.u.RGBA.size = outputSize;
+            m_decoder = WebPIDecode(0, 0, &m_decoderConfig);
+        } else
+#endif
+            m_decoder = WebPINewRGB(mode, output, outputSize, rowStride);
         if (!m_decoder)
             return setFailed();
     }
 
-    switch (WebPIUpdate(m_decoder, dataBytes, dataSize)) {
-    case VP8_STATUS_OK:
-        if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile()) 
-            applyColorProfile(dataBytes, dataSize, buffer);
-        buffer.setStatus(ImageFrame::FrameComplete);
+    // The decoder keeps what it has not decoded yet, so it is only handed the
+    // bytes that arrived since the last call.
+    VP8StatusCode status = VP8_STATUS_SUSPENDED;
+    const char* segment;
+    while (unsigned segmentLength = m_data->getSomeData(segment, m_consumedDataSize)) {
+        m_consumedDataSize += segmentLength;
+        status = WebPIAppend(m_decoder, reinterpret_cast<const uint8_t*>(segment), segmentLength);
+        if (status != VP8_STATUS_SUSPENDED)
+            break;
+    }
+
+    if (status != VP8_STATUS_OK && status != VP8_STATUS_SUSPENDED) {
         clear();
-        return true;
-    case VP8_STATUS_SUSPENDED:
-        if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile()) 
-            applyColorProfile(dataBytes, dataSize, buffer);
-        return false;
-    default:
-        clear();                         
         return setFailed();
     }
+
+    int decodedHeight;
+    if (WebPIDecGetRGB(m_decoder, &decodedHeight, 0, 0, 0) && decodedHeight > 0)
+        didDecodeFirstPixels();
+    if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile())
+        applyColorProfile(buffer);
+
+    if (status == VP8_STATUS_SUSPENDED)
+        return false;
+
+    buffer.setStatus(ImageFrame::FrameComplete);
+    clear();
+    return true;
 }
 
 } // namespace WebCore
@@ -47,12 +47,18 @@ public:
 
     virtual String filenameExtension() const { return "webp"; }
     virtual bool isSizeAvailable();
+    virtual bool setSize(unsigned width, unsigned height);
     virtual ImageFrame* frameBufferAtIndex(size_t index);
 
 private:
     bool decode(bool onlySize);
 
     WebPIDecoder* m_decoder;
+    unsigned m_consumedDataSize; // The bytes of m_data already appended to |m_decoder|.
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Referenced by |m_decoder| while it decodes a down-sampled image.
+    WebPDecoderConfig m_decoderConfig;
+#endif
     bool m_hasAlpha;
     int m_formatFlags;
 
@@ -60,13 +66,13 @@ private:
     qcms_transform* colorTransform() const { return m_transform; }
     void createColorTransform(const char* data, size_t);
     void readColorProfile(const uint8_t* data, size_t);
-    void applyColorProfile(const uint8_t* data, size_t, ImageFrame&);
+    void applyColorProfile(ImageFrame&);
 
     bool m_haveReadProfile;
     qcms_transform* m_transform;
     int m_decodedHeight;
 #else
-    void applyColorProfile(const uint8_t*, size_t, ImageFrame&) { };
+    void applyColorProfile(ImageFrame&) { };
 #endif
     void clear();
 };
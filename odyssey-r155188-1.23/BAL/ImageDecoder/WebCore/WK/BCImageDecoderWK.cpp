@@ -39,6 +39,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <string.h>
+
+#if (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #if OS(MORPHOS)
 extern bool canAllocateMemory(long long size);
@@ -245,6 +250,135 @@ void ImageFrame::setStatus(FrameStatus status)
     m_status = status;
 }
 
+// Exact for every product of two 8 bit values.
+static inline unsigned divideBy255(unsigned value)
+{
+    unsigned approximation = value >> 8;
+    unsigned remainder = value - approximation * 255 + 1;
+    return approximation + (remainder >> 8);
+}
+
+#if (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+// The SSE2 converters handle four pixels at a time and return how many
+// pixels they converted; the scalar loops finish the row.
+
+// Pixels are stored little endian, so ARGB words are B, G, R, A in memory.
+static inline __m128i swapRedAndBlue(__m128i pixels)
+{
+    const __m128i greenAndAlpha = _mm_set1_epi32(0xFF00FF00);
+    __m128i redAndBlue = _mm_andnot_si128(greenAndAlpha, pixels);
+    redAndBlue = _mm_or_si128(_mm_slli_epi32(redAndBlue, 16), _mm_srli_epi32(redAndBlue, 16));
+    return _mm_or_si128(_mm_and_si128(pixels, greenAndAlpha), redAndBlue);
+}
+
+// Multiplies the first three 16 bit channels of two pixels by the fourth,
+// divided by 255 as divideBy255() does. The fourth channel is kept.
+static inline __m128i multiplyByFourthChannel(__m128i channels)
+{
+    const __m128i fourthChannel = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i multiplier = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, 0xFF), 0xFF);
+    __m128i product = _mm_mullo_epi16(channels, multiplier);
+    __m128i approximation = _mm_srli_epi16(product, 8);
+    __m128i remainder = _mm_add_epi16(_mm_sub_epi16(product, _mm_slli_epi16(approximation, 8)), _mm_add_epi16(approximation, one));
+    __m128i quotient = _mm_add_epi16(approximation, _mm_srli_epi16(remainder, 8));
+    return _mm_or_si128(_mm_andnot_si128(fourthChannel, quotient), _mm_and_si128(fourthChannel, channels));
+}
+
+static inline __m128i multiplyPixelsByFourthChannel(__m128i pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = multiplyByFourthChannel(_mm_unpacklo_epi8(pixels, zero));
+    __m128i high = multiplyByFourthChannel(_mm_unpackhi_epi8(pixels, zero));
+    return _mm_packus_epi16(low, high);
+}
+
+static int setRGBARowSSE2(ImageFrame::PixelData* dest, const unsigned char* rgba, int count, bool premultiplyAlpha, unsigned char& nonTrivialAlphaMask)
+{
+    const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+    int x = 0;
+    for (; x + 4 <= count; x += 4, rgba += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+        bool opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(pixels, alphaMask), alphaMask)) == 0xFFFF;
+        if (!opaque) {
+            nonTrivialAlphaMask = 0xFF;
+            if (premultiplyAlpha)
+                pixels = multiplyPixelsByFourthChannel(pixels);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), swapRedAndBlue(pixels));
+    }
+    return x;
+}
+
+static int setInvertedCMYKRowSSE2(ImageFrame::PixelData* dest, const unsigned char* cmyk, int count)
+{
+    const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+    int x = 0;
+    for (; x + 4 <= count; x += 4, cmyk += 16) {
+        __m128i pixels = multiplyPixelsByFourthChannel(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cmyk)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), swapRedAndBlue(_mm_or_si128(pixels, alphaMask)));
+    }
+    return x;
+}
+#endif
+
+void ImageFrame::setRGBRow(PixelData* dest, const unsigned char* rgb, int count)
+{
+    int x = 0;
+#if CPU(BIG_ENDIAN)
+    // Four pixels are three big endian words: RGBR GBRG BRGB.
+    for (; x + 4 <= count; x += 4, rgb += 12) {
+        uint32_t words[3];
+        memcpy(words, rgb, sizeof(words));
+        dest[x] = 0xFF000000U | words[0] >> 8;
+        dest[x + 1] = 0xFF000000U | (words[0] & 0xFF) << 16 | words[1] >> 16;
+        dest[x + 2] = 0xFF000000U | (words[1] & 0xFFFF) << 8 | words[2] >> 24;
+        dest[x + 3] = 0xFF000000U | (words[2] & 0xFFFFFF);
+    }
+#endif
+    for (; x < count; ++x, rgb += 3)
+        dest[x] = 0xFF000000U | rgb[0] << 16 | rgb[1] << 8 | rgb[2];
+}
+
+unsigned char ImageFrame::setRGBARow(PixelData* dest, const unsigned char* rgba, int count)
+{
+    unsigned char nonTrivialAlphaMask = 0;
+    int x = 0;
+#if (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+    x = setRGBARowSSE2(dest, rgba, count, m_premultiplyAlpha, nonTrivialAlphaMask);
+    rgba += x * 4;
+#endif
+    for (; x < count; ++x, rgba += 4) {
+        unsigned r = rgba[0];
+        unsigned g = rgba[1];
+        unsigned b = rgba[2];
+        unsigned a = rgba[3];
+        if (a != 255) {
+            nonTrivialAlphaMask |= 255 - a;
+            if (m_premultiplyAlpha) {
+                r = divideBy255(r * a);
+                g = divideBy255(g * a);
+                b = divideBy255(b * a);
+            }
+        }
+        dest[x] = a << 24 | r << 16 | g << 8 | b;
+    }
+    return nonTrivialAlphaMask;
+}
+
+void ImageFrame::setInvertedCMYKRow(PixelData* dest, const unsigned char* cmyk, int count)
+{
+    int x = 0;
+#if (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+    x = setInvertedCMYKRowSSE2(dest, cmyk, count);
+    cmyk += x * 4;
+#endif
+    for (; x < count; ++x, cmyk += 4) {
+        unsigned k = cmyk[3];
+        dest[x] = 0xFF000000U | divideBy255(cmyk[0] * k) << 16 | divideBy255(cmyk[1] * k) << 8 | divideBy255(cmyk[2] * k);
+    }
+}
+
 namespace {
 
 enum MatchType {
@@ -300,7 +434,7 @@ unsigned ImageDecoder::frameBytesAtIndex(size_t index) const
     if (m_frameBufferCache.size() <= index)
         return 0;
     // FIXME: Use the dimension of the requested frame.
-    return m_size.area() * sizeof(ImageFrame::PixelData);
+    return scaledSize().area() * sizeof(ImageFrame::PixelData);
 }
 
 void ImageDecoder::prepareScaleDataIfNecessary()
@@ -321,6 +455,19 @@ void ImageDecoder::prepareScaleDataIfNecessary()
     fillScaledValues(m_scaledRows, scale, height);
 }
 
+void ImageDecoder::rescaleScaleDataForDecodedSize(const IntSize& decodedSize)
+{
+    if (!m_scaled)
+        return;
+
+    IntSize targetSize = scaledSize();
+    ASSERT(decodedSize.width() >= targetSize.width() && decodedSize.height() >= targetSize.height());
+    m_scaledColumns.clear();
+    m_scaledRows.clear();
+    fillScaledValues(m_scaledColumns, targetSize.width() / (double)decodedSize.width(), decodedSize.width());
+    fillScaledValues(m_scaledRows, targetSize.height() / (double)decodedSize.height(), decodedSize.height());
+}
+
 int ImageDecoder::upperBoundScaledX(int origX, int searchStart)
 {
     return getScaledValue<UpperBound>(m_scaledColumns, origX, searchStart);
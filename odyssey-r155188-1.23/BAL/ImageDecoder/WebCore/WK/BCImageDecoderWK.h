@@ -34,6 +34,7 @@
 #include "PlatformScreen.h"
 #include "SharedBuffer.h"
 #include <wtf/Assertions.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/RefPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
@@ -108,6 +109,9 @@ namespace WebCore {
         // (Actual use: This pointer will be owned by BitmapImage and freed in
         // FrameData::clear()).
         PassNativeImagePtr asNewNativeImage() const;
+        // Like asNewNativeImage(), but the native image has its own copy of
+        // the pixels, so it outlives this frame and the decoder.
+        PassNativeImagePtr asNewNativeImageCopy() const;
 
         bool hasAlpha() const;
         const IntRect& originalFrameRect() const { return m_originalFrameRect; }
@@ -206,6 +210,15 @@ namespace WebCore {
         }
 #endif
 
+        // Row versions of setRGBA() for the decoders' output paths. Each
+        // converts |count| pixels of packed 8 bit samples, several at a time
+        // where the CPU allows. |dest| may alias the samples for setRGBARow().
+        static void setRGBRow(PixelData* dest, const unsigned char* rgb, int count);
+        // Premultiplies if premultiplyAlpha(). Returns a non zero mask if any
+        // pixel is not fully opaque.
+        unsigned char setRGBARow(PixelData* dest, const unsigned char* rgba, int count);
+        // Adobe JPEGs store CMYK inverted; see JPEGImageDecoder.
+        static void setInvertedCMYKRow(PixelData* dest, const unsigned char* cmyk, int count);
 
     private:
         int width() const
@@ -239,7 +252,8 @@ namespace WebCore {
     //
     // ENABLE(IMAGE_DECODER_DOWN_SAMPLING) allows image decoders to downsample
     // at decode time.  Image decoders will downsample any images larger than
-    // |m_maxNumPixels|.  FIXME: Not yet supported by all decoders.
+    // |m_maxNumPixels|.  JPEG, PNG, GIF and WebP support it; BMP and ICO
+    // always decode at full size.
     class ImageDecoder {
         WTF_MAKE_NONCOPYABLE(ImageDecoder); WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -250,7 +264,9 @@ namespace WebCore {
             , m_sizeAvailable(false)
             , m_maxNumPixels(-1)
             , m_isAllDataReceived(false)
-            , m_failed(false) { }
+            , m_failed(false)
+            , m_firstDataTime(0)
+            , m_firstPixelsTime(0) { }
 
         virtual ~ImageDecoder() { }
 
@@ -269,8 +285,15 @@ namespace WebCore {
                 return;
             m_data = data;
             m_isAllDataReceived = allDataReceived;
+            if (!m_firstDataTime && data && data->size())
+                m_firstDataTime = monotonicallyIncreasingTime();
         }
 
+        // Seconds from the first data to the first decoded rows of a frame,
+        // or 0 until the decoder has output rows. Only decoders that call
+        // didDecodeFirstPixels() report it.
+        double timeToFirstPixels() const { return m_firstPixelsTime ? m_firstPixelsTime - m_firstDataTime : 0; }
+
         // Lazily-decodes enough of the image to get the size (if possible).
         // FIXME: Right now that has to be done by each subclass; factor the
         // decode call out and use it here.
@@ -401,6 +424,8 @@ namespace WebCore {
         virtual void clearFrameBufferCache(size_t) { }
 
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+        // Must be called before the size is decoded; the scale is fixed by
+        // setSize().
         void setMaxNumPixels(int m) { m_maxNumPixels = m; }
 #endif
 
@@ -410,12 +435,24 @@ namespace WebCore {
 
     protected:
         void prepareScaleDataIfNecessary();
+        // For decoders that first shrink the image themselves (e.g. JPEG DCT
+        // scaling): resamples the already reduced |decodedSize| to
+        // scaledSize(), so that m_scaledColumns and m_scaledRows index into
+        // the decoder's output rather than the original image.
+        void rescaleScaleDataForDecodedSize(const IntSize& decodedSize);
         int upperBoundScaledX(int origX, int searchStart = 0);
         int lowerBoundScaledX(int origX, int searchStart = 0);
         int upperBoundScaledY(int origY, int searchStart = 0);
         int lowerBoundScaledY(int origY, int searchStart = 0);
         int scaledY(int origY, int searchStart = 0);
 
+        // Called by the decoders whenever they have written rows to a frame.
+        void didDecodeFirstPixels()
+        {
+            if (!m_firstPixelsTime && m_firstDataTime)
+                m_firstPixelsTime = monotonicallyIncreasingTime();
+        }
+
         RefPtr<SharedBuffer> m_data; // The encoded data.
         Vector<ImageFrame, 1> m_frameBufferCache;
         // FIXME: Do we need m_colorProfile any more, for any port?
@@ -442,6 +479,8 @@ namespace WebCore {
         int m_maxNumPixels;
         bool m_isAllDataReceived;
         bool m_failed;
+        double m_firstDataTime;
+        double m_firstPixelsTime;
     };
 
 } // namespace WebCore
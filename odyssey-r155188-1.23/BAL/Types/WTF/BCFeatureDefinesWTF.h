@@ -527,7 +527,7 @@
 #endif
 
 #if !defined(ENABLE_IMAGE_DECODER_DOWN_SAMPLING)
-#define ENABLE_IMAGE_DECODER_DOWN_SAMPLING 0
+#define ENABLE_IMAGE_DECODER_DOWN_SAMPLING 1
 #endif
 
 #if !defined(ENABLE_INDEXED_DATABASE)
@@ -789,7 +789,11 @@
 #endif
 
 #if !defined(ENABLE_THREADED_HTML_PARSER)
-#define ENABLE_THREADED_HTML_PARSER 0
+#define ENABLE_THREADED_HTML_PARSER 1
+#endif
+
+#if !defined(ENABLE_THREADED_IMAGE_DECODING)
+#define ENABLE_THREADED_IMAGE_DECODING 1
 #endif
 
 #if !defined(ENABLE_THREADED_SCROLLING)
@@ -933,6 +933,32 @@
 #define WTF_USE_ACCELERATED_COMPOSITING 1
 #endif
 
+/* The OWB ports composite layers in software, with the TextureMapper */
+#if ENABLE(ACCELERATED_COMPOSITING)
+#if !defined(WTF_USE_ACCELERATED_COMPOSITING)
+#define WTF_USE_ACCELERATED_COMPOSITING 1
+#endif
+#if !defined(WTF_USE_TEXTURE_MAPPER)
+#define WTF_USE_TEXTURE_MAPPER 1
+#endif
+#endif
+
+/* The OWB ports turn the tiled backing store on at build time */
+#if ENABLE(TILED_BACKING_STORE) && !defined(WTF_USE_TILED_BACKING_STORE)
+#define WTF_USE_TILED_BACKING_STORE 1
+#endif
+
+/* Display lists are kept in Cairo recording surfaces */
+#if USE(CAIRO) && !defined(WTF_USE_DISPLAY_LISTS)
+#define WTF_USE_DISPLAY_LISTS 1
+#endif
+
+/* Tiles are rasterized from display lists on worker threads. Cairo builds
+   without thread support (CAIRO_NO_MUTEX) must define this to 0 */
+#if USE(TILED_BACKING_STORE) && USE(DISPLAY_LISTS) && !defined(WTF_USE_THREADED_TILE_RASTERIZATION)
+#define WTF_USE_THREADED_TILE_RASTERIZATION 1
+#endif
+
 #if ENABLE(WEBGL) && !defined(WTF_USE_3D_GRAPHICS)
 #define WTF_USE_3D_GRAPHICS 1
 #endif
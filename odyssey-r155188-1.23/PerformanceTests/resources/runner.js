@@ -0,0 +1,158 @@
+// Helpers shared by the pages in PerformanceTests. Load it with
+// <script src="../resources/runner.js"></script> before the page's own script.
+//
+// Pages that compare a setting off and on do it in one of two ways:
+// - In test builds with window.internals, the page sets each value through internals.settings
+//   and measures both in turn.
+// - In the browser, set the WebKit preference the page names, then open the page with
+//   ?<preference>=0 or ?<preference>=1 so the results are labelled with the value. The page
+//   cannot read the preference itself.
+// Counters only the test builds have are reported when window.internals provides them.
+var PerfRunner = (function () {
+    var parameters = {};
+    location.search.substring(1).split("&").forEach(function (parameter) {
+        if (!parameter)
+            return;
+        var separator = parameter.indexOf("=");
+        var name = decodeURIComponent(separator < 0 ? parameter : parameter.substring(0, separator));
+        var value = separator < 0 ? "" : decodeURIComponent(parameter.substring(separator + 1));
+        (parameters[name] = parameters[name] || []).push(value);
+    });
+
+    function log(text) {
+        var element = document.getElementById("log");
+        if (!element) {
+            element = document.createElement("pre");
+            element.id = "log";
+            document.body.insertBefore(element, document.body.firstChild);
+        }
+        element.textContent += text + "\n";
+    }
+
+    // All values given for |name| in the query string, in order.
+    function parameterValues(name) {
+        return parameters[name] || [];
+    }
+
+    // internals[name](arguments...), or null when the build has no such counter.
+    function counter(name) {
+        if (!window.internals || !internals[name])
+            return null;
+        return internals[name].apply(internals, Array.prototype.slice.call(arguments, 1));
+    }
+
+    // Calls measure(label, done) for each value of a boolean setting, described by
+    // { setter: "setFooEnabled", preference: "WebKitFooEnabled", off: "label", on: "label" }.
+    function compareSetting(setting, measure) {
+        var runs = [];
+        if (window.internals && internals.settings && internals.settings[setting.setter]) {
+            runs.push({ label: setting.off, value: false });
+            runs.push({ label: setting.on, value: true });
+        } else {
+            var values = parameterValues(setting.preference);
+            if (!values.length) {
+                log("Set the " + setting.preference + " preference and add ?" + setting.preference + "=0 or =1 to the URL to label the results.");
+                runs.push({ label: "current " + setting.preference, value: null });
+            } else
+                runs.push({ label: values[0] == "0" || values[0] == "false" ? setting.off : setting.on, value: null });
+        }
+
+        function nextRun() {
+            var run = runs.shift();
+            if (!run)
+                return;
+            if (run.value !== null)
+                internals.settings[setting.setter](run.value);
+            measure(run.label, nextRun);
+        }
+        nextRun();
+    }
+
+    // Calls step(index) stepCount times from timers, forcing the layout the next paint depends
+    // on after each, then done({ worst, average }) with the time each step took to come around,
+    // in ms. That includes the paints the port makes before the next timer fires, but nothing
+    // makes it paint every step.
+    function timeSteps(stepCount, step, done) {
+        var index = 0;
+        var last = 0;
+        var worst = 0;
+        var total = 0;
+        function tick() {
+            var now = Date.now();
+            if (last) {
+                worst = Math.max(worst, now - last);
+                total += now - last;
+            }
+            last = now;
+            if (index == stepCount) {
+                done({ worst: worst, average: stepCount ? total / stepCount : 0 });
+                return;
+            }
+            step(index++);
+            document.body.offsetTop;
+            setTimeout(tick, 0);
+        }
+        setTimeout(tick, 0);
+    }
+
+    // Scrolls the document from the top to the bottom in stepCount steps, see timeSteps().
+    function scrollSteps(stepCount, done) {
+        window.scrollTo(0, 0);
+        var maximumScroll = document.body.scrollHeight - window.innerHeight;
+        timeSteps(stepCount + 1, function (index) {
+            window.scrollTo(0, Math.round(maximumScroll * index / stepCount));
+        }, done);
+    }
+
+    // A deterministic pseudo-random number generator, so every run builds the same page.
+    function randomGenerator(seed) {
+        var state = seed;
+        return function () {
+            state = (state * 1103515245 + 12345) & 0x7fffffff;
+            return state;
+        };
+    }
+
+    var words = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor incididunt ut labore et dolore magna aliqua".split(" ");
+
+    function text(wordCount, random) {
+        var result = "";
+        for (var i = 0; i < wordCount; ++i)
+            result += words[random() % words.length] + " ";
+        return result;
+    }
+
+    // A 1600x1200 photo-like image as a data URL. Many overlapping gradients keep it reasonably
+    // small while still giving the decoder full size frames to produce. Ports without JPEG
+    // encoding fall back to PNG.
+    function photoURL(seed) {
+        var canvas = document.createElement("canvas");
+        canvas.width = 1600;
+        canvas.height = 1200;
+        var context = canvas.getContext("2d");
+        var random = randomGenerator(seed);
+        for (var i = 0; i < 40; ++i) {
+            var value = random();
+            var x = value % canvas.width;
+            var y = (value >> 11) % canvas.height;
+            var gradient = context.createRadialGradient(x, y, 0, x, y, 100 + value % 500);
+            gradient.addColorStop(0, "rgba(" + (value & 0xff) + "," + ((value >> 8) & 0xff) + "," + ((value >> 16) & 0xff) + ",0.8)");
+            gradient.addColorStop(1, "rgba(0,0,0,0)");
+            context.fillStyle = gradient;
+            context.fillRect(0, 0, canvas.width, canvas.height);
+        }
+        return canvas.toDataURL("image/jpeg", 0.9);
+    }
+
+    return {
+        log: log,
+        parameterValues: parameterValues,
+        counter: counter,
+        compareSetting: compareSetting,
+        timeSteps: timeSteps,
+        scrollSteps: scrollSteps,
+        randomGenerator: randomGenerator,
+        text: text,
+        photoURL: photoURL
+    };
+})();
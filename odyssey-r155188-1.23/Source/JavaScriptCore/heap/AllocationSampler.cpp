@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "AllocationSampler.h"
+
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "Heap.h"
+#include "Interpreter.h"
+#include "Operations.h"
+#include "StackVisitor.h"
+#include "VM.h"
+
+namespace JSC {
+
+static const size_t maximumStackDepth = 32;
+
+static String functionNameForFrame(StackVisitor& visitor)
+{
+    switch (visitor->codeType()) {
+    case StackVisitor::Frame::Global:
+        return ASCIILiteral("(program)");
+    case StackVisitor::Frame::Eval:
+        return ASCIILiteral("(eval)");
+    case StackVisitor::Frame::Function: {
+        FunctionExecutable* executable = jsCast<FunctionExecutable*>(visitor->codeBlock()->ownerExecutable());
+        if (!executable->name().isEmpty())
+            return executable->name().string();
+        if (!executable->inferredName().isEmpty())
+            return executable->inferredName().string();
+        return ASCIILiteral("(anonymous function)");
+    }
+    case StackVisitor::Frame::Native:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return String();
+}
+
+class SampleStackFunctor {
+public:
+    SampleStackFunctor(Vector<AllocationSampler::Frame, maximumStackDepth>& frames)
+        : m_frames(frames)
+    {
+    }
+
+    StackVisitor::Status operator()(StackVisitor& visitor)
+    {
+        if (!visitor->isJSFrame())
+            return StackVisitor::Continue;
+
+        AllocationSampler::Frame frame;
+        frame.functionName = functionNameForFrame(visitor);
+        frame.sourceURL = visitor->sourceURL();
+        unsigned column;
+        visitor->computeLineAndColumn(frame.line, column);
+        m_frames.append(frame);
+        return m_frames.size() < maximumStackDepth ? StackVisitor::Continue : StackVisitor::Done;
+    }
+
+private:
+    Vector<AllocationSampler::Frame, maximumStackDepth>& m_frames;
+};
+
+AllocationSampler::AllocationSampler(VM* vm)
+    : m_vm(vm)
+    , m_samplingInterval(0)
+    , m_bytesSinceLastSample(0)
+{
+}
+
+void AllocationSampler::setSamplingInterval(size_t bytes)
+{
+    m_samplingInterval = bytes;
+    m_bytesSinceLastSample = 0;
+    m_frames.clear();
+    m_frameIndices.clear();
+    m_nodes.clear();
+    m_childNodes.clear();
+    m_liveSamples.clear();
+    if (!m_samplingInterval)
+        return;
+
+    Node root = { 0, 0, 0, 0 };
+    m_nodes.append(root);
+}
+
+void AllocationSampler::didAllocate(size_t bytes, void* cell)
+{
+    m_bytesSinceLastSample += bytes;
+    if (m_bytesSinceLastSample < m_samplingInterval)
+        return;
+
+    // Each sample stands for all the whole intervals that have gone by since the last one.
+    size_t sampledBytes = m_bytesSinceLastSample - m_bytesSinceLastSample % m_samplingInterval;
+    m_bytesSinceLastSample -= sampledBytes;
+
+    unsigned node = nodeForCurrentStack();
+    for (unsigned current = node; ; current = m_nodes[current].parent) {
+        m_nodes[current].allocatedBytes += sampledBytes;
+        if (!current)
+            break;
+    }
+
+    if (cell) {
+        LiveSample sample = { cell, node, sampledBytes };
+        m_liveSamples.append(sample);
+    }
+}
+
+CallFrame* AllocationSampler::currentCallFrame() const
+{
+    // Entering the VM sets the dynamic global object, and the interpreter, the
+    // JIT and the runtime functions they call keep the top call frame current
+    // until it is left again. Outside of that, and while the heap runs
+    // finalizers, the top call frame may be a frame that has returned.
+    if (!m_vm->dynamicGlobalObject || m_vm->heap.isBusy())
+        return 0;
+    CallFrame* callFrame = m_vm->topCallFrame->removeHostCallFrameFlag();
+    if (!callFrame)
+        return 0;
+    JSStack& stack = m_vm->interpreter->stack();
+    if (callFrame->registers() < stack.begin() || callFrame->registers() >= stack.end())
+        return 0;
+    return callFrame;
+}
+
+unsigned AllocationSampler::nodeForCurrentStack()
+{
+    Vector<Frame, maximumStackDepth> frames;
+    if (CallFrame* callFrame = currentCallFrame()) {
+        SampleStackFunctor functor(frames);
+        callFrame->iterate(functor);
+    }
+
+    // The stack is walked from the innermost frame out; the tree is rooted at the outermost.
+    unsigned node = 0;
+    for (size_t i = frames.size(); i--;) {
+        unsigned frame = frameIndex(frames[i]);
+        uint64_t key = (static_cast<uint64_t>(node) << 32) | (frame + 1);
+        HashMap<uint64_t, unsigned>::AddResult result = m_childNodes.add(key, m_nodes.size());
+        if (result.isNewEntry) {
+            Node child = { node, frame, 0, 0 };
+            m_nodes.append(child);
+        }
+        node = result.iterator->value;
+    }
+    return node;
+}
+
+unsigned AllocationSampler::frameIndex(const Frame& frame)
+{
+    StringBuilder key;
+    key.append(frame.functionName);
+    key.append('\n');
+    key.append(frame.sourceURL);
+    key.append('\n');
+    key.appendNumber(frame.line);
+
+    HashMap<String, unsigned>::AddResult result = m_frameIndices.add(key.toString(), m_frames.size());
+    if (result.isNewEntry)
+        m_frames.append(frame);
+    return result.iterator->value;
+}
+
+void AllocationSampler::didFinishMarking()
+{
+    if (!isEnabled())
+        return;
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+        m_nodes[i].liveBytes = 0;
+
+    size_t liveSampleCount = 0;
+    for (size_t i = 0; i < m_liveSamples.size(); ++i) {
+        LiveSample sample = m_liveSamples[i];
+        if (!Heap::isMarked(sample.cell))
+            continue;
+        m_liveSamples[liveSampleCount++] = sample;
+        for (unsigned current = sample.node; ; current = m_nodes[current].parent) {
+            m_nodes[current].liveBytes += sample.bytes;
+            if (!current)
+                break;
+        }
+    }
+    m_liveSamples.shrink(liveSampleCount);
+}
+
+static void appendQuotedJSONString(StringBuilder& builder, const String& string)
+{
+    builder.append('"');
+    for (unsigned i = 0; i < string.length(); ++i) {
+        UChar character = string[i];
+        if (character == '"' || character == '\\') {
+            builder.append('\\');
+            builder.append(character);
+        } else if (character < 0x20) {
+            static const char hexDigits[] = "0123456789abcdef";
+            LChar escape[] = { '\\', 'u', '0', '0', static_cast<LChar>(hexDigits[character >> 4]), static_cast<LChar>(hexDigits[character & 0xF]) };
+            builder.append(escape, WTF_ARRAY_LENGTH(escape));
+        } else
+            builder.append(character);
+    }
+    builder.append('"');
+}
+
+void AllocationSampler::appendNodeJSON(StringBuilder& builder, unsigned node, const Vector<Vector<unsigned> >& children) const
+{
+    builder.append("{\"frame\":");
+    if (node)
+        builder.appendNumber(m_nodes[node].frame);
+    else
+        builder.append("null");
+    builder.append(",\"allocatedBytes\":");
+    builder.appendNumber(m_nodes[node].allocatedBytes);
+    builder.append(",\"liveBytes\":");
+    builder.appendNumber(m_nodes[node].liveBytes);
+    builder.append(",\"children\":[");
+    for (size_t i = 0; i < children[node].size(); ++i) {
+        if (i)
+            builder.append(',');
+        appendNodeJSON(builder, children[node][i], children);
+    }
+    builder.append("]}");
+}
+
+String AllocationSampler::toJSON() const
+{
+    StringBuilder builder;
+    builder.append("{\"samplingInterval\":");
+    builder.appendNumber(m_samplingInterval);
+    builder.append(",\"frames\":[");
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        if (i)
+            builder.append(',');
+        builder.append("{\"functionName\":");
+        appendQuotedJSONString(builder, m_frames[i].functionName);
+        builder.append(",\"sourceURL\":");
+        appendQuotedJSONString(builder, m_frames[i].sourceURL);
+        builder.append(",\"line\":");
+        builder.appendNumber(m_frames[i].line);
+        builder.append('}');
+    }
+    builder.append("],\"tree\":");
+
+    if (m_nodes.isEmpty())
+        builder.append("null");
+    else {
+        // Children are always created after their parent, so one forward pass builds the lists.
+        Vector<Vector<unsigned> > children(m_nodes.size());
+        for (size_t i = 1; i < m_nodes.size(); ++i)
+            children[m_nodes[i].parent].append(i);
+        appendNodeJSON(builder, 0, children);
+    }
+    builder.append('}');
+    return builder.toString();
+}
+
+} // namespace JSC
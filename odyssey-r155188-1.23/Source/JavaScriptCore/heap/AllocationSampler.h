@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef AllocationSampler_h
+#define AllocationSampler_h
+
+#include "JSExportMacros.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class ExecState;
+class VM;
+
+typedef ExecState CallFrame;
+
+// Attributes heap growth to the JavaScript that caused it. Roughly every
+// samplingInterval() bytes, the allocators' slow paths record the current
+// stack (function, source URL and line for each frame). Samples are folded
+// into a calling-context tree: every node counts the bytes allocated beneath
+// it, and after each GC the live bytes beneath it, that is the bytes of the
+// sampled cells allocated there that survived.
+//
+// There is no retained size. A cell only counts at the site that allocated
+// it, not at the sites of the objects that keep it alive, and the objects it
+// points to count at their own sites. Retained sizes need the edges of the
+// heap graph, which marking does not record. Backing stores are never
+// counted as live, as copying moves them.
+//
+// Allocations made while no JavaScript runs, or while the heap is busy, are
+// counted at the root, as the VM's top call frame may be stale then.
+class AllocationSampler {
+    WTF_MAKE_NONCOPYABLE(AllocationSampler);
+    friend class SampleStackFunctor;
+public:
+    AllocationSampler(VM*);
+
+    // Zero turns sampling off and discards everything collected so far.
+    JS_EXPORT_PRIVATE void setSamplingInterval(size_t bytes);
+    size_t samplingInterval() const { return m_samplingInterval; }
+    bool isEnabled() const { return !!m_samplingInterval; }
+
+    // Called from the allocators' slow paths with the number of bytes handed
+    // out since their last refill. |cell| is the cell being allocated, which
+    // lets the sample track whether it survives.
+    void didAllocateCells(size_t bytes, void* cell)
+    {
+        if (UNLIKELY(isEnabled()))
+            didAllocate(bytes, cell);
+    }
+    // Backing stores move during copying, so only their allocation is counted.
+    void didAllocateStorage(size_t bytes)
+    {
+        if (UNLIKELY(isEnabled()))
+            didAllocate(bytes, 0);
+    }
+
+    // Called once marking has finished; drops the samples whose cells died.
+    void didFinishMarking();
+
+    // { samplingInterval, frames: [{ functionName, sourceURL, line }], tree },
+    // where tree nodes are { frame, allocatedBytes, liveBytes, children }.
+    JS_EXPORT_PRIVATE String toJSON() const;
+
+private:
+    struct Frame {
+        String functionName;
+        String sourceURL;
+        unsigned line;
+    };
+
+    struct Node {
+        unsigned parent;
+        unsigned frame;
+        size_t allocatedBytes; // Estimated from the samples, since sampling started.
+        size_t liveBytes; // Estimated from the sampled cells that survived the last GC.
+    };
+
+    struct LiveSample {
+        void* cell;
+        unsigned node;
+        size_t bytes;
+    };
+
+    void didAllocate(size_t bytes, void* cell);
+    unsigned nodeForCurrentStack();
+    CallFrame* currentCallFrame() const;
+    unsigned frameIndex(const Frame&);
+    void appendNodeJSON(StringBuilder&, unsigned node, const Vector<Vector<unsigned> >& children) const;
+
+    VM* m_vm;
+    size_t m_samplingInterval;
+    size_t m_bytesSinceLastSample;
+
+    Vector<Frame> m_frames;
+    HashMap<String, unsigned> m_frameIndices;
+    Vector<Node> m_nodes; // m_nodes[0] is the root, standing for allocations made outside JavaScript.
+    HashMap<uint64_t, unsigned> m_childNodes; // (parent node, frame + 1) -> node
+    Vector<LiveSample> m_liveSamples;
+};
+
+} // namespace JSC
+
+#endif // AllocationSampler_h
@@ -71,6 +71,7 @@ CheckedBoolean CopiedSpace::tryAllocateSlowCase(size_t bytes, void** outPtr)
     
     ASSERT(m_heap->vm()->currentThreadIsHoldingAPILock());
     m_heap->didAllocate(m_allocator.currentCapacity());
+    m_heap->allocationSampler().didAllocateStorage(m_allocator.currentCapacity());
 
     allocateBlock();
 
@@ -93,6 +94,7 @@ CheckedBoolean CopiedSpace::tryAllocateOversize(size_t bytes, void** outPtr)
     allocator.resetCurrentBlock();
 
     m_heap->didAllocate(block->region()->blockSize());
+    m_heap->allocationSampler().didAllocateStorage(block->region()->blockSize());
 
     return true;
 }
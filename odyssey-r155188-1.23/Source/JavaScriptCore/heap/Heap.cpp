@@ -255,6 +255,7 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_blockAllocator()
     , m_objectSpace(this)
     , m_storageSpace(this)
+    , m_allocationSampler(vm)
     , m_extraMemoryUsage(0)
     , m_machineThreads(this)
     , m_sharedData(vm)
@@ -270,6 +271,8 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_deferralDepth(0)
 {
     m_storageSpace.init();
+    if (Options::allocationSamplingInterval())
+        m_allocationSampler.setSamplingInterval(Options::allocationSamplingInterval());
 }
 
 Heap::~Heap()
@@ -753,6 +756,8 @@ void Heap::collect(SweepToggle sweepToggle)
     }
 
     JAVASCRIPTCORE_GC_MARKED();
+
+    m_allocationSampler.didFinishMarking();
     
     {
         GCPHASE(SweepingArrayBuffers);
@@ -22,6 +22,7 @@
 #ifndef Heap_h
 #define Heap_h
 
+#include "AllocationSampler.h"
 #include "ArrayBuffer.h"
 #include "BlockAllocator.h"
 #include "CodeBlockSet.h"
@@ -112,6 +113,8 @@ namespace JSC {
 
         JS_EXPORT_PRIVATE IncrementalSweeper* sweeper();
 
+        AllocationSampler& allocationSampler() { return m_allocationSampler; }
+
         // true if collection is in progress
         inline bool isCollecting();
         // true if an allocation or collection is in progress
@@ -254,6 +257,7 @@ namespace JSC {
         BlockAllocator m_blockAllocator;
         MarkedSpace m_objectSpace;
         CopiedSpace m_storageSpace;
+        AllocationSampler m_allocationSampler;
         GCIncomingRefCountedSet<ArrayBuffer> m_arrayBuffers;
         size_t m_extraMemoryUsage;
 
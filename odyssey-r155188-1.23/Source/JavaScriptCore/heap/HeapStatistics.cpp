@@ -37,6 +37,7 @@
 #include <wtf/CurrentTime.h>
 #include <wtf/DataLog.h>
 #include <wtf/Deque.h>
+#include <wtf/text/CString.h>
 
 namespace JSC {
 
@@ -250,4 +251,20 @@ void HeapStatistics::showObjectStatistics(Heap* heap)
                 / storageStatistics.objectCount()));
 }
 
+String HeapStatistics::allocationSamplesAsJSON(Heap* heap)
+{
+    return heap->allocationSampler().toJSON();
+}
+
+bool HeapStatistics::writeAllocationSamples(Heap* heap, const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    CString json = allocationSamplesAsJSON(heap).utf8();
+    bool succeeded = fwrite(json.data(), 1, json.length(), file) == json.length();
+    return !fclose(file) && succeeded;
+}
+
 } // namespace JSC
@@ -28,6 +28,7 @@
 
 #include "JSExportMacros.h"
 #include <wtf/Deque.h>
+#include <wtf/Forward.h>
 
 namespace JSC {
 
@@ -44,6 +45,11 @@ public:
 
     static void showObjectStatistics(Heap*);
 
+    // The allocation sampler's calling-context tree, as JSON. Nodes count the
+    // bytes allocated beneath them and how many of those are still live.
+    JS_EXPORT_PRIVATE static String allocationSamplesAsJSON(Heap*);
+    JS_EXPORT_PRIVATE static bool writeAllocationSamples(Heap*, const char* path);
+
     static const size_t KB = 1024;
     static const size_t MB = 1024 * KB;
     static const size_t GB = 1024 * MB;
@@ -77,8 +77,16 @@ void* MarkedAllocator::allocateSlowCase(size_t bytes)
 #endif
     
     ASSERT(!m_freeList.head);
-    m_heap->didAllocate(m_freeList.bytes);
-    
+    size_t bytesAllocated = m_freeList.bytes;
+    m_heap->didAllocate(bytesAllocated);
+
+    void* result = refillAndAllocate(bytes);
+    m_heap->allocationSampler().didAllocateCells(bytesAllocated, result);
+    return result;
+}
+
+void* MarkedAllocator::refillAndAllocate(size_t bytes)
+{
     void* result = tryAllocate(bytes);
     
     if (LIKELY(result != 0))
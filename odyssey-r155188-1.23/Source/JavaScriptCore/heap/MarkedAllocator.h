@@ -39,6 +39,7 @@ public:
 private:
     JS_EXPORT_PRIVATE void* allocateSlowCase(size_t);
     void* tryAllocate(size_t);
+    void* refillAndAllocate(size_t);
     void* tryAllocateHelper(size_t);
     MarkedBlock* allocateBlock(size_t);
     
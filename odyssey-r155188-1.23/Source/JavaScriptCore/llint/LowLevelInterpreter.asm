@@ -489,30 +489,6 @@ _llint_op_new_regexp:
     dispatch(3)
 
 
-_llint_op_less:
-    traceExecution()
-    callSlowPath(_slow_path_less)
-    dispatch(4)
-
-
-_llint_op_lesseq:
-    traceExecution()
-    callSlowPath(_slow_path_lesseq)
-    dispatch(4)
-
-
-_llint_op_greater:
-    traceExecution()
-    callSlowPath(_slow_path_greater)
-    dispatch(4)
-
-
-_llint_op_greatereq:
-    traceExecution()
-    callSlowPath(_slow_path_greatereq)
-    dispatch(4)
-
-
 _llint_op_mod:
     traceExecution()
     callSlowPath(_slow_path_mod)
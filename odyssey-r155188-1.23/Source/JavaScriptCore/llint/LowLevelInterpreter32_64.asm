@@ -603,6 +603,44 @@ _llint_op_nstricteq:
     strictEq(macro (left, right, result) cineq left, right, result end, _slow_path_nstricteq)
 
 
+macro compareOp(integerCompare, slowPath)
+    loadi 12[PC], t2
+    loadi 8[PC], t0
+    loadConstantOrVariable(t2, t3, t1)
+    loadConstantOrVariable2Reg(t0, t2, t0)
+    bineq t2, Int32Tag, .slow
+    bineq t3, Int32Tag, .slow
+    loadi 4[PC], t2
+    integerCompare(t0, t1, t0)
+    storei BooleanTag, TagOffset[cfr, t2, 8]
+    storei t0, PayloadOffset[cfr, t2, 8]
+    dispatch(4)
+
+.slow:
+    callSlowPath(slowPath)
+    dispatch(4)
+end
+
+_llint_op_less:
+    traceExecution()
+    compareOp(macro (left, right, result) cilt left, right, result end, _slow_path_less)
+
+
+_llint_op_lesseq:
+    traceExecution()
+    compareOp(macro (left, right, result) cilteq left, right, result end, _slow_path_lesseq)
+
+
+_llint_op_greater:
+    traceExecution()
+    compareOp(macro (left, right, result) cigt left, right, result end, _slow_path_greater)
+
+
+_llint_op_greatereq:
+    traceExecution()
+    compareOp(macro (left, right, result) cigteq left, right, result end, _slow_path_greatereq)
+
+
 _llint_op_inc:
     traceExecution()
     loadi 4[PC], t0
@@ -456,6 +456,49 @@ _llint_op_nstricteq:
         _slow_path_nstricteq)
 
 
+macro compareOp(integerCompare, slowPath)
+    traceExecution()
+    loadisFromInstruction(3, t0)
+    loadisFromInstruction(2, t2)
+    loadConstantOrVariable(t0, t1)
+    loadConstantOrVariable(t2, t0)
+    bqb t0, tagTypeNumber, .slow
+    bqb t1, tagTypeNumber, .slow
+    integerCompare(t0, t1, t0)
+    loadisFromInstruction(1, t1)
+    orq ValueFalse, t0
+    storeq t0, [cfr, t1, 8]
+    dispatch(4)
+
+.slow:
+    callSlowPath(slowPath)
+    dispatch(4)
+end
+
+_llint_op_less:
+    compareOp(
+        macro (left, right, result) cilt left, right, result end,
+        _slow_path_less)
+
+
+_llint_op_lesseq:
+    compareOp(
+        macro (left, right, result) cilteq left, right, result end,
+        _slow_path_lesseq)
+
+
+_llint_op_greater:
+    compareOp(
+        macro (left, right, result) cigt left, right, result end,
+        _slow_path_greater)
+
+
+_llint_op_greatereq:
+    compareOp(
+        macro (left, right, result) cigteq left, right, result end,
+        _slow_path_greatereq)
+
+
 macro preOp(arithmeticOperation, slowPath)
     traceExecution()
     loadisFromInstruction(1, t0)
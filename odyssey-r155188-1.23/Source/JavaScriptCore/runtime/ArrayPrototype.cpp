@@ -619,60 +619,179 @@ static bool attemptFastSort(ExecState* exec, JSObject* thisObj, JSValue function
     return true;
 }
 
-static bool performSlowSort(ExecState* exec, JSObject* thisObj, unsigned length, JSValue function, CallData& callData, CallType& callType)
-{
-    // "Min" sort. Not the fastest, but definitely less code than heapsort
-    // or quicksort, and much less swapping than bubblesort/insertionsort.
-    for (unsigned i = 0; i < length - 1; ++i) {
-        JSValue iObj = getOrHole(thisObj, exec, i);
-        if (exec->hadException())
-            return false;
-        unsigned themin = i;
-        JSValue minObj = iObj;
-        for (unsigned j = i + 1; j < length; ++j) {
-            JSValue jObj = getOrHole(thisObj, exec, j);
-            if (exec->hadException())
+class SlowSortComparator {
+public:
+    SlowSortComparator(ExecState* exec, const MarkedArgumentBuffer& values, JSValue function, CallType callType, const CallData& callData)
+        : m_exec(exec)
+        , m_values(values)
+        , m_function(function)
+        , m_callType(callType)
+        , m_callData(callData)
+    {
+        if (callType == CallTypeJS)
+            m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(function), 2));
+    }
+
+    // Converts every value to a string up front when there is no comparator,
+    // so each element is stringified once instead of once per comparison.
+    // Also fails if the cached call could not be set up, e.g. because the
+    // stack is exhausted; the exception is then pending.
+    bool prepare()
+    {
+        if (m_callType != CallTypeNone)
+            return !m_exec->hadException();
+        m_strings.reserveInitialCapacity(m_values.size());
+        for (size_t i = 0; i < m_values.size(); ++i) {
+            m_strings.uncheckedAppend(m_values.at(i).toWTFStringInline(m_exec));
+            if (m_exec->hadException())
                 return false;
-            double compareResult;
-            if (!jObj)
-                compareResult = 1;
-            else if (!minObj)
-                compareResult = -1;
-            else if (jObj.isUndefined())
-                compareResult = 1; // don't check minObj because there's no need to differentiate == (0) from > (1)
-            else if (minObj.isUndefined())
-                compareResult = -1;
-            else if (callType != CallTypeNone) {
-                MarkedArgumentBuffer l;
-                l.append(jObj);
-                l.append(minObj);
-                compareResult = call(exec, function, callType, callData, jsUndefined(), l).toNumber(exec);
-            } else
-                compareResult = codePointCompareLessThan(jObj.toWTFStringInline(exec), minObj.toWTFStringInline(exec)) ? -1 : 1;
-
-            if (compareResult < 0) {
-                themin = j;
-                minObj = jObj;
-            }
         }
-        // Swap themin and i
-        if (themin > i) {
-            if (minObj) {
-                thisObj->methodTable()->putByIndex(thisObj, exec, i, minObj, true);
-                if (exec->hadException())
-                    return false;
-            } else if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, i)) {
-                throwTypeError(exec, "Unable to delete property.");
+        return true;
+    }
+
+    // Returns true only if the value at index b must be ordered strictly
+    // before the value at index a; equal values keep their relative order.
+    bool isGreater(unsigned a, unsigned b)
+    {
+        if (m_callType == CallTypeNone)
+            return codePointCompareLessThan(m_strings[b], m_strings[a]);
+
+        double compareResult;
+        if (m_cachedCall) {
+            m_cachedCall->setThis(jsUndefined());
+            m_cachedCall->setArgument(0, m_values.at(a));
+            m_cachedCall->setArgument(1, m_values.at(b));
+            compareResult = m_cachedCall->call().toNumber(m_cachedCall->newCallFrame(m_exec));
+        } else {
+            MarkedArgumentBuffer arguments;
+            arguments.append(m_values.at(a));
+            arguments.append(m_values.at(b));
+            compareResult = call(m_exec, m_function, m_callType, m_callData, jsUndefined(), arguments).toNumber(m_exec);
+        }
+        return compareResult > 0;
+    }
+
+private:
+    ExecState* m_exec;
+    const MarkedArgumentBuffer& m_values;
+    JSValue m_function;
+    CallType m_callType;
+    const CallData& m_callData;
+    OwnPtr<CachedCall> m_cachedCall;
+    Vector<String> m_strings;
+};
+
+// Bottom-up stable merge sort over indices into the comparator's value list.
+// Adjacent runs that are already in order are not merged, so presorted input
+// costs a single comparison per run.
+static bool mergeSortIndices(ExecState* exec, SlowSortComparator& comparator, Vector<unsigned>& order)
+{
+    size_t size = order.size();
+    Vector<unsigned> buffer(size);
+
+    for (size_t width = 1; width < size; width *= 2) {
+        for (size_t begin = 0; begin + width < size; begin += 2 * width) {
+            size_t middle = begin + width;
+            size_t end = std::min(middle + width, size);
+
+            bool needsMerge = comparator.isGreater(order[middle - 1], order[middle]);
+            if (exec->hadException())
                 return false;
-            }
-            if (iObj) {
-                thisObj->methodTable()->putByIndex(thisObj, exec, themin, iObj, true);
+            if (!needsMerge)
+                continue;
+
+            size_t left = begin;
+            size_t right = middle;
+            size_t out = begin;
+            while (left < middle && right < end) {
+                bool takeRight = comparator.isGreater(order[left], order[right]);
                 if (exec->hadException())
                     return false;
-            } else if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, themin)) {
-                throwTypeError(exec, "Unable to delete property.");
-                return false;
+                buffer[out++] = takeRight ? order[right++] : order[left++];
             }
+            while (left < middle)
+                buffer[out++] = order[left++];
+            while (right < end)
+                buffer[out++] = order[right++];
+            for (size_t i = begin; i < end; ++i)
+                order[i] = buffer[i];
+        }
+    }
+    return true;
+}
+
+// Sorts arrays that attemptFastSort rejects (array-likes, holes, accessors,
+// sparse storage) through the generic property interface. Present elements are
+// snapshotted first, so a comparator that mutates the array cannot corrupt the
+// sort, and nothing is written back until every comparison has succeeded.
+static bool performSlowSort(ExecState* exec, JSObject* thisObj, unsigned length, JSValue function, CallData& callData, CallType& callType)
+{
+    Vector<uint32_t, 0, UnsafeVectorOverflow> keys;
+    if (length < 1000) {
+        for (unsigned i = 0; i < length; ++i)
+            keys.append(i);
+    } else {
+        // Potentially sparse; only visit indices that actually exist.
+        PropertyNameArray nameArray(exec);
+        thisObj->methodTable()->getPropertyNames(thisObj, exec, nameArray, IncludeDontEnumProperties);
+        if (exec->hadException())
+            return false;
+        for (size_t i = 0; i < nameArray.size(); ++i) {
+            PropertyName name = nameArray[i];
+            uint32_t index = name.asIndex();
+            if (index != PropertyName::NotAnIndex && index < length)
+                keys.append(index);
+        }
+        // Keep the sort stable with respect to index order.
+        std::sort(keys.begin(), keys.end());
+    }
+
+    MarkedArgumentBuffer values;
+    unsigned undefinedCount = 0;
+    Vector<uint32_t, 0, UnsafeVectorOverflow> presentKeys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        JSValue value = getOrHole(thisObj, exec, keys[i]);
+        if (exec->hadException())
+            return false;
+        if (!value)
+            continue;
+        presentKeys.append(keys[i]);
+        if (value.isUndefined())
+            ++undefinedCount;
+        else
+            values.append(value);
+    }
+
+    SlowSortComparator comparator(exec, values, function, callType, callData);
+    if (!comparator.prepare())
+        return false;
+
+    Vector<unsigned> order(values.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    if (!mergeSortIndices(exec, comparator, order))
+        return false;
+
+    unsigned index = 0;
+    for (size_t i = 0; i < order.size(); ++i, ++index) {
+        thisObj->methodTable()->putByIndex(thisObj, exec, index, values.at(order[i]), true);
+        if (exec->hadException())
+            return false;
+    }
+    for (unsigned i = 0; i < undefinedCount; ++i, ++index) {
+        thisObj->methodTable()->putByIndex(thisObj, exec, index, jsUndefined(), true);
+        if (exec->hadException())
+            return false;
+    }
+
+    // Anything that existed past the compacted range has moved down; delete
+    // it so that holes end up at the end of the array.
+    for (size_t i = 0; i < presentKeys.size(); ++i) {
+        if (presentKeys[i] < index)
+            continue;
+        if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, presentKeys[i])) {
+            throwTypeError(exec, "Unable to delete property.");
+            return false;
         }
     }
     return true;
@@ -691,64 +810,8 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSort(ExecState* exec)
 
     if (attemptFastSort(exec, thisObj, function, callData, callType))
         return JSValue::encode(thisObj);
-    
-    // Assume that for small-ish arrays, doing the slow sort directly is better.
-    if (length < 1000)
-        return performSlowSort(exec, thisObj, length, function, callData, callType) ? JSValue::encode(thisObj) : JSValue::encode(jsUndefined());
-    
-    JSGlobalObject* globalObject = JSGlobalObject::create(
-        exec->vm(), JSGlobalObject::createStructure(exec->vm(), jsNull()));
-    JSArray* flatArray = constructEmptyArray(globalObject->globalExec(), 0);
-    if (exec->hadException())
-        return JSValue::encode(jsUndefined());
-    
-    PropertyNameArray nameArray(exec);
-    thisObj->methodTable()->getPropertyNames(thisObj, exec, nameArray, IncludeDontEnumProperties);
-    if (exec->hadException())
-        return JSValue::encode(jsUndefined());
 
-    Vector<uint32_t, 0, UnsafeVectorOverflow> keys;
-    for (size_t i = 0; i < nameArray.size(); ++i) {
-        PropertyName name = nameArray[i];
-        uint32_t index = name.asIndex();
-        if (index == PropertyName::NotAnIndex)
-            continue;
-        
-        JSValue value = getOrHole(thisObj, exec, index);
-        if (exec->hadException())
-            return JSValue::encode(jsUndefined());
-        if (!value)
-            continue;
-        keys.append(index);
-        flatArray->push(exec, value);
-        if (exec->hadException())
-            return JSValue::encode(jsUndefined());
-    }
-    
-    if (!attemptFastSort(exec, flatArray, function, callData, callType)
-        && !performSlowSort(exec, flatArray, flatArray->length(), function, callData, callType))
-        return JSValue::encode(jsUndefined());
-    
-    for (size_t i = 0; i < keys.size(); ++i) {
-        size_t index = keys[i];
-        if (index < flatArray->length())
-            continue;
-        
-        if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, index)) {
-            throwTypeError(exec, "Unable to delete property.");
-            return JSValue::encode(jsUndefined());
-        }
-    }
-    
-    for (size_t i = flatArray->length(); i--;) {
-        JSValue value = getOrHole(flatArray, exec, i);
-        RELEASE_ASSERT(value);
-        thisObj->methodTable()->putByIndex(thisObj, exec, i, value, true);
-        if (exec->hadException())
-            return JSValue::encode(jsUndefined());
-    }
-    
-    return JSValue::encode(thisObj);
+    return performSlowSort(exec, thisObj, length, function, callData, callType) ? JSValue::encode(thisObj) : JSValue::encode(jsUndefined());
 }
 
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncSplice(ExecState* exec)
@@ -94,4 +94,24 @@ JSValue evaluate(ExecState* exec, const SourceCode& source, JSValue thisValue, J
     return result;
 }
 
+bool prepareProgram(ExecState* exec, const SourceCode& source)
+{
+    JSLockHolder lock(exec);
+    RELEASE_ASSERT(exec->vm().identifierTable == wtfThreadData().currentIdentifierTable());
+    RELEASE_ASSERT(!exec->vm().isCollectorBusy());
+
+    // Nothing is cached while a debugger or profiler is attached, and the debugger
+    // must only hear about the parse once, when the program actually runs.
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+    if (globalObject->hasDebugger() || globalObject->hasProfiler())
+        return false;
+
+    ProgramExecutable* program = ProgramExecutable::create(exec, source);
+    if (!program)
+        return false;
+
+    JSObject* exception = 0;
+    return globalObject->createProgramCodeBlock(exec, program, &exception);
+}
+
 } // namespace JSC
@@ -37,6 +37,11 @@ namespace JSC {
     JS_EXPORT_PRIVATE bool checkSyntax(ExecState*, const SourceCode&, JSValue* exception = 0);
     JS_EXPORT_PRIVATE JSValue evaluate(ExecState*, const SourceCode&, JSValue thisValue = JSValue(), JSValue* exception = 0);
 
+    // Parses and generates bytecode for a program without running it, so that a later
+    // evaluate() of the same source finds it in the VM's code cache. Returns false if
+    // the program could not be compiled; the error is reported when it is evaluated.
+    JS_EXPORT_PRIVATE bool prepareProgram(ExecState*, const SourceCode&);
+
 } // namespace JSC
 
 #endif // Completion_h
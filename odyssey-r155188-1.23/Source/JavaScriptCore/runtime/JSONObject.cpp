@@ -39,6 +39,7 @@
 #include "Operations.h"
 #include "PropertyNameArray.h"
 #include <wtf/MathExtras.h>
+#include <wtf/text/ASCIIFastPath.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -254,13 +255,25 @@ Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
     return Local<Unknown>(m_exec->vm(), jsString(m_exec, result.toString()));
 }
 
+static inline int findCharacterNeedingEscape(const LChar* data, int start, int length)
+{
+    return WTF::findControlCharacterOr(data + start, data + length, '"', '\\') - data;
+}
+
+static inline int findCharacterNeedingEscape(const UChar* data, int start, int length)
+{
+    int i = start;
+    while (i < length && (data[i] > 0x1F && data[i] != '"' && data[i] != '\\'))
+        ++i;
+    return i;
+}
+
 template <typename CharType>
 static void appendStringToStringBuilder(StringBuilder& builder, const CharType* data, int length)
 {
     for (int i = 0; i < length; ++i) {
         int start = i;
-        while (i < length && (data[i] > 0x1F && data[i] != '"' && data[i] != '\\'))
-            ++i;
+        i = findCharacterNeedingEscape(data, start, length);
         builder.append(data + start, i - start);
         if (i >= length)
             break;
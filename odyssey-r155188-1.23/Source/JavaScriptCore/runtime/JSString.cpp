@@ -88,6 +88,10 @@ void JSRopeString::resolveRope(ExecState* exec) const
 {
     ASSERT(isRope());
 
+    RopeStatistics& statistics = Heap::heap(this)->vm()->ropeStatistics;
+    statistics.resolvedRopes++;
+    statistics.resolvedRopeBytes += is8Bit() ? m_length : m_length * sizeof(UChar);
+
     if (is8Bit()) {
         LChar* buffer;
         if (RefPtr<StringImpl> newImpl = StringImpl::tryCreateUninitialized(m_length, buffer)) {
@@ -191,10 +195,13 @@ void JSRopeString::resolveRopeSlowCase8(LChar* buffer) const
 void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
 {
     UChar* position = buffer + m_length; // We will be working backwards over the rope.
-    Vector<JSString*, 32, UnsafeVectorOverflow> workQueue; // These strings are kept alive by the parent rope, so using a Vector is OK.
+    Vector<JSString*, 32, UnsafeVectorOverflow> workQueue; // Putting strings into a Vector is only OK because there are no GC points in this method.
 
-    for (size_t i = 0; i < s_maxInternalRopeLength && m_fibers[i]; ++i)
+    for (size_t i = 0; i < s_maxInternalRopeLength && m_fibers[i]; ++i) {
         workQueue.append(m_fibers[i].get());
+        // Clearing here works only because there are no GC points in this method.
+        m_fibers[i].clear();
+    }
 
     while (!workQueue.isEmpty()) {
         JSString* currentFiber = workQueue.last();
@@ -230,9 +237,56 @@ void JSRopeString::outOfMemory(ExecState* exec) const
         throwOutOfMemoryError(exec);
 }
 
+JSString* JSRopeString::fiberContaining(unsigned offset, unsigned length, unsigned& offsetInFiber) const
+{
+    ASSERT(isRope());
+    ASSERT(length);
+    ASSERT(offset + length <= m_length);
+
+    const JSRopeString* rope = this;
+    for (unsigned depth = 0; depth < s_maxFiberSearchDepth; ++depth) {
+        JSString* fiber = 0;
+        for (size_t i = 0; i < s_maxInternalRopeLength && rope->m_fibers[i]; ++i) {
+            unsigned fiberLength = rope->m_fibers[i]->length();
+            if (offset < fiberLength) {
+                fiber = rope->m_fibers[i].get();
+                break;
+            }
+            offset -= fiberLength;
+        }
+
+        // The range straddles two fibers, or the rope was emptied by a failed resolve.
+        if (!fiber || offset + length > fiber->length())
+            return 0;
+
+        if (!fiber->isRope()) {
+            offsetInFiber = offset;
+            return fiber;
+        }
+        rope = static_cast<const JSRopeString*>(fiber);
+    }
+    return 0;
+}
+
+JSString* JSRopeString::substringFromFiber(ExecState* exec, unsigned offset, unsigned length) const
+{
+    unsigned offsetInFiber;
+    JSString* fiber = fiberContaining(offset, length, offsetInFiber);
+    if (!fiber)
+        return 0;
+    exec->vm().ropeStatistics.substringsFromFibers++;
+    return jsSubstring(exec, fiber->m_value, offsetInFiber, length);
+}
+
 JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
+    unsigned offsetInFiber;
+    if (JSString* fiber = fiberContaining(i, 1, offsetInFiber)) {
+        exec->vm().ropeStatistics.substringsFromFibers++;
+        return jsSingleCharacterSubstring(exec, fiber->m_value, offsetInFiber);
+    }
+
     resolveRope(exec);
     // Return a safe no-value result, this should never be used, since the excetion will be thrown.
     if (exec->exception())
@@ -242,6 +296,207 @@ JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
     return jsSingleCharacterSubstring(exec, m_value, i);
 }
 
+UChar JSRopeString::characterAtSlowCase(ExecState* exec, unsigned i)
+{
+    ASSERT(isRope());
+    unsigned offsetInFiber;
+    if (JSString* fiber = fiberContaining(i, 1, offsetInFiber)) {
+        exec->vm().ropeStatistics.substringsFromFibers++;
+        return fiber->m_value[offsetInFiber];
+    }
+
+    resolveRope(exec);
+    // Return a safe no-value result, this should never be used, since the excetion will be thrown.
+    if (exec->exception())
+        return 0;
+    ASSERT(!isRope());
+    RELEASE_ASSERT(i < m_value.length());
+    return m_value[i];
+}
+
+// Calls functor(fiber, offset) for the flat fibers that end after |start|, left
+// to right, until the functor returns false.
+template<typename Functor>
+void JSRopeString::forEachFlatFiber(unsigned start, Functor& functor) const
+{
+    // Putting strings into a Vector is only OK because there are no GC points in this method.
+    Vector<std::pair<JSString*, unsigned>, 32, UnsafeVectorOverflow> workQueue;
+    workQueue.append(std::make_pair(const_cast<JSRopeString*>(this), 0u));
+
+    while (!workQueue.isEmpty()) {
+        JSString* currentFiber = workQueue.last().first;
+        unsigned offset = workQueue.last().second;
+        workQueue.removeLast();
+
+        if (offset + currentFiber->length() <= start)
+            continue;
+
+        if (!currentFiber->isRope()) {
+            if (!functor(currentFiber->m_value, offset))
+                return;
+            continue;
+        }
+
+        JSRopeString* currentFiberAsRope = static_cast<JSRopeString*>(currentFiber);
+        unsigned fiberOffsets[s_maxInternalRopeLength];
+        size_t fiberCount = 0;
+        for (; fiberCount < s_maxInternalRopeLength && currentFiberAsRope->m_fibers[fiberCount]; ++fiberCount) {
+            fiberOffsets[fiberCount] = offset;
+            offset += currentFiberAsRope->m_fibers[fiberCount]->length();
+        }
+        while (fiberCount--)
+            workQueue.append(std::make_pair(currentFiberAsRope->m_fibers[fiberCount].get(), fiberOffsets[fiberCount]));
+    }
+}
+
+// Finds the first match at or after |start|. The last characters of the
+// fibers seen so far are kept to find matches that span fibers. Gives up once
+// it has compared more characters than resolving the rope and searching it
+// again would, however many fibers that took.
+class FiberPatternSearch {
+public:
+    FiberPatternSearch(const String& pattern, unsigned start, unsigned length)
+        : m_pattern(pattern)
+        , m_start(start)
+        , m_carryStart(0)
+        , m_comparisons(0)
+        , m_maximumComparisons(static_cast<uint64_t>(length - start) * maximumComparisonsPerCharacter)
+        , m_result(notFound)
+        , m_gaveUp(false)
+    {
+    }
+
+    bool operator()(const String& fiber, unsigned offset)
+    {
+        unsigned length = fiber.length();
+        unsigned patternLength = m_pattern.length();
+
+        // Matches that start in the kept characters and end in this fiber.
+        for (size_t i = 0; i < m_carry.size(); ++i) {
+            if (i + patternLength > m_carry.size() + length)
+                break; // Needs characters from the next fibers, and so do the later positions.
+            unsigned j = 0;
+            for (; j < patternLength; ++j) {
+                UChar character = i + j < m_carry.size() ? m_carry[i + j] : fiber[i + j - m_carry.size()];
+                if (character != m_pattern[j])
+                    break;
+            }
+            m_comparisons += j + 1;
+            if (j == patternLength) {
+                m_result = m_carryStart + i;
+                return false;
+            }
+        }
+
+        unsigned from = m_start > offset ? m_start - offset : 0;
+        m_comparisons += length - from;
+        if (m_comparisons > m_maximumComparisons) {
+            m_gaveUp = true;
+            return false;
+        }
+
+        size_t position = fiber.find(m_pattern, from);
+        if (position != notFound) {
+            m_result = offset + position;
+            return false;
+        }
+
+        // Keep the last patternLength - 1 characters that a match may start at.
+        size_t carryLength = patternLength - 1;
+        if (length - from >= carryLength)
+            m_carry.clear();
+        for (unsigned i = std::max(from, length > carryLength ? length - static_cast<unsigned>(carryLength) : 0); i < length; ++i)
+            m_carry.append(fiber[i]);
+        if (m_carry.size() > carryLength)
+            m_carry.remove(0, m_carry.size() - carryLength);
+        m_carryStart = offset + length - m_carry.size();
+        return true;
+    }
+
+    size_t result() const { return m_result; }
+    bool gaveUp() const { return m_gaveUp; }
+
+private:
+    // Resolving copies every character once before searching them again.
+    static const unsigned maximumComparisonsPerCharacter = 2;
+
+    const String& m_pattern;
+    unsigned m_start;
+    Vector<UChar, JSRopeString::s_maxPatternLengthForFiberSearch> m_carry;
+    unsigned m_carryStart;
+    uint64_t m_comparisons;
+    uint64_t m_maximumComparisons;
+    size_t m_result;
+    bool m_gaveUp;
+};
+
+size_t JSRopeString::findSlowCase(ExecState* exec, const String& pattern, unsigned start)
+{
+    ASSERT(isRope());
+    if (pattern.length() && pattern.length() <= s_maxPatternLengthForFiberSearch && start < m_length) {
+        FiberPatternSearch search(pattern, start, m_length);
+        forEachFlatFiber(start, search);
+        if (!search.gaveUp()) {
+            exec->vm().ropeStatistics.searchesInFibers++;
+            return search.result();
+        }
+    }
+
+    resolveRope(exec);
+    // Return a safe no-value result, this should never be used, since the excetion will be thrown.
+    if (exec->exception())
+        return notFound;
+    ASSERT(!isRope());
+    return m_value.find(pattern, start);
+}
+
+// Compares the fibers with the prefix until it is matched or a character differs.
+class FiberPrefixMatch {
+public:
+    FiberPrefixMatch(const String& prefix)
+        : m_prefix(prefix)
+        , m_matchedLength(0)
+        , m_matches(false)
+    {
+    }
+
+    bool operator()(const String& fiber, unsigned)
+    {
+        unsigned length = std::min(fiber.length(), m_prefix.length() - m_matchedLength);
+        for (unsigned i = 0; i < length; ++i) {
+            if (fiber[i] != m_prefix[m_matchedLength + i])
+                return false;
+        }
+        m_matchedLength += length;
+        m_matches = m_matchedLength == m_prefix.length();
+        return !m_matches;
+    }
+
+    bool matches() const { return m_matches; }
+
+private:
+    const String& m_prefix;
+    unsigned m_matchedLength;
+    bool m_matches;
+};
+
+bool JSRopeString::startsWithSlowCase(ExecState* exec, const String& prefix)
+{
+    ASSERT(isRope());
+    if (prefix.isNull())
+        return false;
+    if (prefix.length() > m_length)
+        return false;
+    if (!prefix.length())
+        return true;
+
+    // Only the fibers the prefix covers are visited.
+    FiberPrefixMatch match(prefix);
+    forEachFlatFiber(0, match);
+    exec->vm().ropeStatistics.searchesInFibers++;
+    return match.matches();
+}
+
 JSValue JSString::toPrimitive(ExecState*, PreferredPrimitiveType) const
 {
     return const_cast<JSString*>(this);
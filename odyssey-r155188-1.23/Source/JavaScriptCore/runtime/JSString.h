@@ -153,6 +153,12 @@ namespace JSC {
 
         bool canGetIndex(unsigned i) { return i < m_length; }
         JSString* getIndex(ExecState*, unsigned);
+        UChar characterAt(ExecState*, unsigned);
+
+        // Like String::find() and String::startsWith(), but ropes are searched
+        // fiber by fiber where that is cheaper than resolving them.
+        size_t find(ExecState*, const String&, unsigned start);
+        bool startsWith(ExecState*, const String&);
 
         static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue proto)
         {
@@ -306,10 +312,22 @@ namespace JSC {
         }
 
         void visitFibers(SlotVisitor&);
+
+        // Returns the substring without resolving the rope when it lies entirely
+        // within one flat fiber, or 0 when the caller has to resolve.
+        JS_EXPORT_PRIVATE JSString* substringFromFiber(ExecState*, unsigned offset, unsigned length) const;
             
         static ptrdiff_t offsetOfFibers() { return OBJECT_OFFSETOF(JSRopeString, m_fibers); }
 
         static const unsigned s_maxInternalRopeLength = 3;
+
+        // Ropes built by repeated appending are deep on one side; past this many
+        // levels, resolving once is cheaper than walking the fibers on every access.
+        static const unsigned s_maxFiberSearchDepth = 32;
+
+        // Searches keep the last characters of each fiber to find matches that
+        // span fibers, so longer patterns are searched in the resolved rope.
+        static const unsigned s_maxPatternLengthForFiberSearch = 64;
             
     private:
         friend JSValue jsString(ExecState*, Register*, unsigned);
@@ -320,7 +338,13 @@ namespace JSC {
         void resolveRopeSlowCase(UChar*) const;
         void outOfMemory(ExecState*) const;
             
+        JSString* fiberContaining(unsigned offset, unsigned length, unsigned& offsetInFiber) const;
+        template<typename Functor> void forEachFlatFiber(unsigned start, Functor&) const;
+            
         JS_EXPORT_PRIVATE JSString* getIndexSlowCase(ExecState*, unsigned);
+        JS_EXPORT_PRIVATE UChar characterAtSlowCase(ExecState*, unsigned);
+        JS_EXPORT_PRIVATE size_t findSlowCase(ExecState*, const String&, unsigned start);
+        JS_EXPORT_PRIVATE bool startsWithSlowCase(ExecState*, const String&);
 
         mutable FixedArray<WriteBarrier<JSString>, s_maxInternalRopeLength> m_fibers;
     };
@@ -390,6 +414,29 @@ namespace JSC {
         return jsSingleCharacterSubstring(exec, m_value, i);
     }
 
+    inline UChar JSString::characterAt(ExecState* exec, unsigned i)
+    {
+        ASSERT(canGetIndex(i));
+        if (isRope())
+            return static_cast<JSRopeString*>(this)->characterAtSlowCase(exec, i);
+        ASSERT(i < m_value.length());
+        return m_value[i];
+    }
+
+    inline size_t JSString::find(ExecState* exec, const String& pattern, unsigned start)
+    {
+        if (isRope())
+            return static_cast<JSRopeString*>(this)->findSlowCase(exec, pattern, start);
+        return m_value.find(pattern, start);
+    }
+
+    inline bool JSString::startsWith(ExecState* exec, const String& prefix)
+    {
+        if (isRope())
+            return static_cast<JSRopeString*>(this)->startsWithSlowCase(exec, prefix);
+        return m_value.startsWith(prefix);
+    }
+
     inline JSString* jsString(VM* vm, const String& s)
     {
         int size = s.length();
@@ -411,6 +458,12 @@ namespace JSC {
         VM* vm = &exec->vm();
         if (!length)
             return vm->smallStrings.emptyString();
+        if (!offset && length == s->length())
+            return s;
+        if (s->isRope()) {
+            if (JSString* substring = static_cast<JSRopeString*>(s)->substringFromFiber(exec, offset, length))
+                return substring;
+        }
         return jsSubstring(vm, s->value(exec), offset, length);
     }
 
@@ -37,6 +37,7 @@
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
+#include <wtf/text/ASCIIFastPath.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -49,6 +50,29 @@ static inline bool isJSONWhiteSpace(const CharType& c)
     return c == ' ' || c == 0x9 || c == 0xA || c == 0xD;
 }
 
+static inline const LChar* skipJSONWhiteSpace(const LChar* ptr, const LChar* end)
+{
+    // Pretty-printed JSON indents with long runs of spaces; step over those a word at a time.
+    while (ptr < end && isJSONWhiteSpace(*ptr)) {
+        if (*ptr == ' ' && WTF::isAlignedToMachineWord(ptr)) {
+            const LChar* wordEnd = WTF::alignToMachineWord(end);
+            while (ptr < wordEnd && *reinterpret_cast_ptr<const WTF::MachineWord*>(ptr) == WTF::repeatedByte(' '))
+                ptr += sizeof(WTF::MachineWord);
+            if (ptr >= end || !isJSONWhiteSpace(*ptr))
+                break;
+        }
+        ++ptr;
+    }
+    return ptr;
+}
+
+static inline const UChar* skipJSONWhiteSpace(const UChar* ptr, const UChar* end)
+{
+    while (ptr < end && isJSONWhiteSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
 template <typename CharType>
 bool LiteralParser<CharType>::tryJSONPParse(Vector<JSONPData>& results, bool needsFullSourceInfo)
 {
@@ -172,8 +196,7 @@ ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const UCh
 template <typename CharType>
 template <ParserMode mode> TokenType LiteralParser<CharType>::Lexer::lex(LiteralParserToken<CharType>& token)
 {
-    while (m_ptr < m_end && isJSONWhiteSpace(*m_ptr))
-        ++m_ptr;
+    m_ptr = skipJSONWhiteSpace(m_ptr, m_end);
 
     ASSERT(m_ptr <= m_end);
     if (m_ptr >= m_end) {
@@ -345,6 +368,24 @@ template <ParserMode mode, typename CharType, UChar terminator> static inline bo
     return (c >= ' ' && (mode == StrictJSON || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && mode != StrictJSON);
 }
 
+template <ParserMode mode, LChar terminator> static ALWAYS_INLINE const LChar* skipSafeStringCharacters(const LChar* ptr, const LChar* end)
+{
+    while (true) {
+        ptr = WTF::findControlCharacterOr(ptr, end, terminator, '\\');
+        // A tab is the only control character that may be safe; keep scanning past it.
+        if (ptr == end || !isSafeStringCharacter<mode, LChar, terminator>(*ptr))
+            return ptr;
+        ++ptr;
+    }
+}
+
+template <ParserMode mode, UChar terminator> static ALWAYS_INLINE const UChar* skipSafeStringCharacters(const UChar* ptr, const UChar* end)
+{
+    while (ptr < end && isSafeStringCharacter<mode, UChar, terminator>(*ptr))
+        ++ptr;
+    return ptr;
+}
+
 template <typename CharType>
 template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token)
 {
@@ -353,8 +394,7 @@ template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParse
     StringBuilder builder;
     do {
         runStart = m_ptr;
-        while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
-            ++m_ptr;
+        m_ptr = skipSafeStringCharacters<mode, terminator>(m_ptr, m_end);
         if (builder.length())
             builder.append(runStart, m_ptr - runStart);
         if ((mode != NonStrictJSON) && m_ptr < m_end && *m_ptr == '\\') {
@@ -45,6 +45,16 @@ GlobalMemoryStatistics globalMemoryStatistics()
     return stats;
 }
 
+RegExpCacheStatistics regExpCacheStatistics(VM& vm)
+{
+    return vm.regExpCache()->statistics();
+}
+
+RopeStatistics ropeStatistics(VM& vm)
+{
+    return vm.ropeStatistics;
+}
+
 }
 
 
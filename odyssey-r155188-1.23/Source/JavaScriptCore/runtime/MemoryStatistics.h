@@ -27,17 +27,22 @@
 #define MemoryStatistics_h
 
 #include "Heap.h"
+#include "RegExpCache.h"
 
 class VM;
 
 namespace JSC {
 
+struct RopeStatistics;
+
 struct GlobalMemoryStatistics {
     size_t stackBytes;
     size_t JITBytes;
 };
 
 JS_EXPORT_PRIVATE GlobalMemoryStatistics globalMemoryStatistics();
+JS_EXPORT_PRIVATE RegExpCacheStatistics regExpCacheStatistics(VM&);
+JS_EXPORT_PRIVATE RopeStatistics ropeStatistics(VM&);
 
 }
 
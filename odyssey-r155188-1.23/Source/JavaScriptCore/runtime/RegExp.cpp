@@ -274,7 +274,6 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 
     if (!hasCode()) {
         ASSERT(m_state == NotCompiled);
-        vm->regExpCache()->addToStrongCache(this);
         m_state = ByteCode;
     }
 
@@ -289,6 +288,7 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 #else
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
+            vm->regExpCache()->didCompile(this);
             return;
         }
 #endif
@@ -298,6 +298,7 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 #endif
 
     m_regExpBytecode = Yarr::byteCompile(pattern, &vm->m_regExpAllocator);
+    vm->regExpCache()->didCompile(this);
 }
 
 void RegExp::compileIfNecessary(VM& vm, Yarr::YarrCharSize charSize)
@@ -396,7 +397,6 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 
     if (!hasCode()) {
         ASSERT(m_state == NotCompiled);
-        vm->regExpCache()->addToStrongCache(this);
         m_state = ByteCode;
     }
 
@@ -411,6 +411,7 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 #else
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
+            vm->regExpCache()->didCompile(this);
             return;
         }
 #endif
@@ -420,6 +421,7 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 #endif
 
     m_regExpBytecode = Yarr::byteCompile(pattern, &vm->m_regExpAllocator);
+    vm->regExpCache()->didCompile(this);
 }
 
 void RegExp::compileIfNecessaryMatchOnly(VM& vm, Yarr::YarrCharSize charSize)
@@ -482,6 +484,17 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     return MatchResult::failed();
 }
 
+size_t RegExp::estimatedCodeSize()
+{
+    size_t size = 0;
+#if ENABLE(YARR_JIT)
+    size += m_regExpJITCode.size();
+#endif
+    if (m_regExpBytecode)
+        size += m_regExpBytecode->estimatedSizeInBytes();
+    return size;
+}
+
 void RegExp::invalidateCode()
 {
     if (!hasCode())
@@ -70,6 +70,7 @@ namespace JSC {
         }
 
         void invalidateCode();
+        size_t estimatedCodeSize();
         
 #if ENABLE(REGEXP_TRACING)
         void printTraceData();
@@ -38,9 +38,14 @@ namespace JSC {
 RegExp* RegExpCache::lookupOrCreate(const String& patternString, RegExpFlags flags)
 {
     RegExpKey key(flags, patternString);
-    if (RegExp* regExp = m_weakCache.get(key))
+    if (RegExp* regExp = m_weakCache.get(key)) {
+        ++m_hitCount;
+        if (m_strongCache.contains(regExp))
+            m_strongCacheOrder.appendOrMoveToLast(regExp);
         return regExp;
+    }
 
+    ++m_missCount;
     RegExp* regExp = RegExp::createWithoutCaching(*m_vm, patternString, flags);
 #if ENABLE(REGEXP_TRACING)
     m_vm->addRegExpToTrace(regExp);
@@ -51,7 +56,11 @@ RegExp* RegExpCache::lookupOrCreate(const String& patternString, RegExpFlags fla
 }
 
 RegExpCache::RegExpCache(VM* vm)
-    : m_nextEntryInStrongCache(0)
+    : m_strongCacheSizeInBytes(0)
+    , m_compileCount(0)
+    , m_hitCount(0)
+    , m_missCount(0)
+    , m_evictionCount(0)
     , m_vm(vm)
 {
 }
@@ -63,22 +72,62 @@ void RegExpCache::finalize(Handle<Unknown> handle, void*)
     regExp->invalidateCode();
 }
 
-void RegExpCache::addToStrongCache(RegExp* regExp)
+void RegExpCache::didCompile(RegExp* regExp)
 {
-    String pattern = regExp->pattern();
-    if (pattern.length() > maxStrongCacheablePatternLength)
+    ++m_compileCount;
+
+    size_t sizeInBytes = regExp->estimatedCodeSize();
+    StrongCacheMap::iterator it = m_strongCache.find(regExp);
+    if (it != m_strongCache.end()) {
+        m_strongCacheSizeInBytes -= it->value.sizeInBytes;
+        if (sizeInBytes > maxStrongCacheableEntrySize) {
+            removeFromStrongCache(regExp);
+            return;
+        }
+        it->value.sizeInBytes = sizeInBytes;
+        m_strongCacheSizeInBytes += sizeInBytes;
+        m_strongCacheOrder.appendOrMoveToLast(regExp);
+        shrinkStrongCache();
+        return;
+    }
+
+    if (sizeInBytes > maxStrongCacheableEntrySize)
         return;
-    m_strongCache[m_nextEntryInStrongCache].set(*m_vm, regExp);
-    m_nextEntryInStrongCache++;
-    if (m_nextEntryInStrongCache == maxStrongCacheableEntries)
-        m_nextEntryInStrongCache = 0;
+
+    StrongCacheEntry entry;
+    entry.regExp.set(*m_vm, regExp);
+    entry.sizeInBytes = sizeInBytes;
+    m_strongCache.add(regExp, entry);
+    m_strongCacheOrder.appendOrMoveToLast(regExp);
+    m_strongCacheSizeInBytes += sizeInBytes;
+    shrinkStrongCache();
+}
+
+void RegExpCache::removeFromStrongCache(RegExp* regExp)
+{
+    m_strongCacheOrder.remove(regExp);
+    m_strongCache.remove(regExp);
+}
+
+void RegExpCache::shrinkStrongCache()
+{
+    // Never evict the most recently used entry, which is the one being compiled.
+    while (m_strongCacheOrder.size() > 1
+        && (m_strongCacheSizeInBytes > strongCacheCapacityInBytes || m_strongCacheOrder.size() > maxStrongCacheableEntries)) {
+        RegExp* regExp = m_strongCacheOrder.first();
+        StrongCacheMap::iterator it = m_strongCache.find(regExp);
+        ASSERT(it != m_strongCache.end());
+        m_strongCacheSizeInBytes -= it->value.sizeInBytes;
+        removeFromStrongCache(regExp);
+        ++m_evictionCount;
+    }
 }
 
 void RegExpCache::invalidateCode()
 {
-    for (int i = 0; i < maxStrongCacheableEntries; i++)
-        m_strongCache[i].clear();
-    m_nextEntryInStrongCache = 0;
+    m_strongCache.clear();
+    m_strongCacheOrder.clear();
+    m_strongCacheSizeInBytes = 0;
 
     RegExpCacheMap::iterator end = m_weakCache.end();
     for (RegExpCacheMap::iterator it = m_weakCache.begin(); it != end; ++it) {
@@ -89,4 +138,16 @@ void RegExpCache::invalidateCode()
     }
 }
 
+RegExpCacheStatistics RegExpCache::statistics() const
+{
+    RegExpCacheStatistics statistics;
+    statistics.compiles = m_compileCount;
+    statistics.hits = m_hitCount;
+    statistics.misses = m_missCount;
+    statistics.evictions = m_evictionCount;
+    statistics.strongCacheEntries = m_strongCache.size();
+    statistics.strongCacheBytes = m_strongCacheSizeInBytes;
+    return statistics;
+}
+
 }
@@ -30,14 +30,33 @@
 #include "Strong.h"
 #include "Weak.h"
 #include "WeakInlines.h"
-#include <wtf/FixedArray.h>
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
 
 #ifndef RegExpCache_h
 #define RegExpCache_h
 
 namespace JSC {
 
+struct RegExpCacheStatistics {
+    RegExpCacheStatistics()
+        : compiles(0)
+        , hits(0)
+        , misses(0)
+        , evictions(0)
+        , strongCacheEntries(0)
+        , strongCacheBytes(0)
+    {
+    }
+
+    size_t compiles; // Bytecode or JIT compilations, including recompiles after GC or eviction.
+    size_t hits; // Lookups that found a live RegExp for the same pattern and flags.
+    size_t misses; // Lookups that had to create a new RegExp.
+    size_t evictions; // Entries dropped from the strong cache to stay within budget.
+    size_t strongCacheEntries;
+    size_t strongCacheBytes; // Estimated size of the compiled code kept alive by the strong cache.
+};
+
 class RegExpCache : private WeakHandleOwner {
 friend class RegExp;
 typedef HashMap<RegExpKey, Weak<RegExp> > RegExpCacheMap;
@@ -46,19 +65,36 @@ public:
     RegExpCache(VM* vm);
     void invalidateCode();
 
+    RegExpCacheStatistics statistics() const;
+
 private:
-    
-    static const unsigned maxStrongCacheablePatternLength = 256;
+    // Compiled regular expressions are kept alive across garbage collections in
+    // a least recently used cache bounded by the estimated size of their code.
+    static const size_t strongCacheCapacityInBytes = 1024 * 1024;
+    static const size_t maxStrongCacheableEntrySize = strongCacheCapacityInBytes / 8;
+    static const unsigned maxStrongCacheableEntries = 512;
 
-    static const int maxStrongCacheableEntries = 32;
+    struct StrongCacheEntry {
+        Strong<RegExp> regExp;
+        size_t sizeInBytes;
+    };
+    typedef HashMap<RegExp*, StrongCacheEntry> StrongCacheMap;
 
     virtual void finalize(Handle<Unknown>, void* context);
 
     RegExp* lookupOrCreate(const WTF::String& patternString, RegExpFlags);
-    void addToStrongCache(RegExp*);
+    void didCompile(RegExp*);
+    void removeFromStrongCache(RegExp*);
+    void shrinkStrongCache();
+
     RegExpCacheMap m_weakCache; // Holds all regular expressions currently live.
-    int m_nextEntryInStrongCache;
-    WTF::FixedArray<Strong<RegExp>, maxStrongCacheableEntries> m_strongCache; // Holds a select few regular expressions that have compiled and executed
+    StrongCacheMap m_strongCache; // Holds recently used regular expressions that have compiled code.
+    ListHashSet<RegExp*> m_strongCacheOrder; // Least recently used first.
+    size_t m_strongCacheSizeInBytes;
+    size_t m_compileCount;
+    size_t m_hitCount;
+    size_t m_missCount;
+    size_t m_evictionCount;
     VM* m_vm;
 };
 
@@ -125,6 +125,21 @@ namespace JSC {
         double increment;
     };
 
+    struct RopeStatistics {
+        RopeStatistics()
+            : resolvedRopes(0)
+            , resolvedRopeBytes(0)
+            , substringsFromFibers(0)
+            , searchesInFibers(0)
+        {
+        }
+
+        size_t resolvedRopes;
+        size_t resolvedRopeBytes;
+        size_t substringsFromFibers; // Substrings and characters read out of a single fiber without resolving the rope.
+        size_t searchesInFibers; // indexOf() and prefix tests answered by walking the fibers without resolving the rope.
+    };
+
 #if ENABLE(DFG_JIT)
     class ConservativeRoots;
 
@@ -276,6 +291,7 @@ namespace JSC {
         const MarkedArgumentBuffer* emptyList; // Lists are supposed to be allocated on the stack to have their elements properly marked, which is not the case here - but this list has nothing to mark.
         SmallStrings smallStrings;
         NumericStrings numericStrings;
+        RopeStatistics ropeStatistics;
         DateInstanceCache dateInstanceCache;
         WTF::SimpleStats machineCodeBytesPerBytecodeWordForBaselineJIT;
 
@@ -0,0 +1,314 @@
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: NPL 1.1/GPL 2.0/LGPL 2.1
+*
+* The contents of this file are subject to the Netscape Public License
+* Version 1.1 (the "License"); you may not use this file except in
+* compliance with the License. You may obtain a copy of the License at
+* http://www.mozilla.org/NPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is JavaScript Engine testing utilities.
+*
+* The Initial Developer of the Original Code is Netscape Communications Corp.
+* Portions created by the Initial Developer are Copyright (C) 2002
+* the Initial Developer. All Rights Reserved.
+*
+* Contributor(s): Fabien Coeurjoly
+*
+* Alternatively, the contents of this file may be used under the terms of
+* either the GNU General Public License Version 2 or later (the "GPL"), or
+* the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+* in which case the provisions of the GPL or the LGPL are applicable instead
+* of those above. If you wish to allow use of your version of this file only
+* under the terms of either the GPL or the LGPL, and not to allow others to
+* use your version of this file under the terms of the NPL, indicate your
+* decision by deleting the provisions above and replace them with the notice
+* and other provisions required by the GPL or the LGPL. If you do not delete
+* the provisions above, a recipient may use your version of this file under
+* the terms of any one of the NPL, the GPL or the LGPL.
+*
+* ***** END LICENSE BLOCK *****
+*
+*
+* SUMMARY: Skipping start offsets that cannot begin a match must not skip matches.
+*
+* Before matching at each offset, the interpreter skips the offsets at which
+* none of the characters a match can start with occur, or where the literal
+* prefix of the pattern does not occur, or which do not start a line when
+* every alternative is anchored with ^ in multiline mode. These are patterns
+* for which those characters, prefixes or line starts are easy to get wrong.
+*
+* There is no sticky (y) flag in this engine, so only ^ anchors are covered.
+*/
+//-----------------------------------------------------------------------------
+var i = 0;
+var bug = '(none)';
+var summary = 'Skipping start offsets that cannot begin a match must not skip matches';
+var status = '';
+var statusmessages = new Array();
+var pattern = '';
+var patterns = new Array();
+var string = '';
+var strings = new Array();
+var actualmatch = '';
+var actualmatches = new Array();
+var expectedmatch = '';
+var expectedmatches = new Array();
+
+
+// Alternations: every alternative adds its first characters.
+status = inSection(1);
+pattern = /cat|dog|bird/;
+string = 'hotdog';
+actualmatch = string.match(pattern);
+expectedmatch = Array('dog');
+addThis();
+
+status = inSection(2);
+pattern = /ab|ac/;
+string = 'xxaaac';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ac');
+addThis();
+
+status = inSection(3);
+pattern = /(x)?yz|q/;
+string = '--yz';
+actualmatch = string.match(pattern);
+expectedmatch = Array('yz', undefined);
+addThis();
+
+status = inSection(4);
+pattern = /a(?:b|c)d|(e+)f/;
+string = 'zzeef acd';
+actualmatch = string.match(pattern);
+expectedmatch = Array('eef', 'ee');
+addThis();
+
+status = inSection(5);
+pattern = /(?:a|b*)c/;
+string = '--c';
+actualmatch = string.match(pattern);
+expectedmatch = Array('c');
+addThis();
+
+// Literal prefixes that repeat their own characters.
+status = inSection(6);
+pattern = /aab/;
+string = 'aaab';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aab');
+addThis();
+
+status = inSection(7);
+pattern = /abcabd/;
+string = 'abcabcabd';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abcabd');
+addThis();
+
+status = inSection(8);
+pattern = /o./g;
+string = 'foo boot moon';
+actualmatch = string.match(pattern);
+expectedmatch = Array('oo', 'oo', 'oo');
+addThis();
+
+// Case-insensitive matches start with either case.
+status = inSection(9);
+pattern = /HELLO/i;
+string = 'say hello';
+actualmatch = string.match(pattern);
+expectedmatch = Array('hello');
+addThis();
+
+status = inSection(10);
+pattern = /hello world/i;
+string = 'HeLLo WORLD';
+actualmatch = string.match(pattern);
+expectedmatch = Array('HeLLo WORLD');
+addThis();
+
+status = inSection(11);
+pattern = /[a-c]x|Q/i;
+string = '--BX';
+actualmatch = string.match(pattern);
+expectedmatch = Array('BX');
+addThis();
+
+status = inSection(12);
+pattern = /\u03bc/i;
+string = 'x\u00b5';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\u00b5');
+addThis();
+
+status = inSection(13);
+pattern = /\u00e9t\u00e9/i;
+string = 'l\'\u00c9T\u00c9';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\u00c9T\u00c9');
+addThis();
+
+// Lookahead at the start consumes nothing.
+status = inSection(14);
+pattern = /(?=b)\w+/;
+string = 'aa bcd';
+actualmatch = string.match(pattern);
+expectedmatch = Array('bcd');
+addThis();
+
+status = inSection(15);
+pattern = /(?!a)\w/;
+string = 'aab';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b');
+addThis();
+
+status = inSection(16);
+pattern = /(?=.*z)y/;
+string = 'xyz';
+actualmatch = string.match(pattern);
+expectedmatch = Array('y');
+addThis();
+
+status = inSection(17);
+pattern = /(?=(\d))/;
+string = 'ab1';
+actualmatch = string.match(pattern);
+expectedmatch = Array('', '1');
+addThis();
+
+// Multiline anchors.
+status = inSection(18);
+pattern = /^b/m;
+string = 'a\nb';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b');
+addThis();
+
+status = inSection(19);
+pattern = /^b/m;
+string = 'a\rb';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b');
+addThis();
+
+status = inSection(20);
+pattern = /^b/m;
+string = 'a\u2028b';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b');
+addThis();
+
+status = inSection(21);
+pattern = /^b/;
+string = 'a\nb';
+actualmatch = string.match(pattern);
+expectedmatch = null;
+addThis();
+
+status = inSection(22);
+pattern = /^b|c/m;
+string = 'xc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('c');
+addThis();
+
+status = inSection(23);
+pattern = /^$/m;
+string = 'a\n\nb';
+actualmatch = string.match(pattern);
+expectedmatch = Array('');
+addThis();
+
+status = inSection(24);
+pattern = /^(?:a|b)c/m;
+string = 'xac\nbc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('bc');
+addThis();
+
+status = inSection(25);
+pattern = /^\w/gm;
+string = 'one\ntwo\n\nthree';
+actualmatch = string.match(pattern);
+expectedmatch = Array('o', 't', 't');
+addThis();
+
+// Characters outside the BMP are surrogate pairs of 16-bit units.
+status = inSection(26);
+pattern = /\ud83d\ude00/;
+string = 'x\ud83d\ude01\ud83d\ude00';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\ud83d\ude00');
+addThis();
+
+status = inSection(27);
+pattern = /(.)\ude00/;
+string = 'x\ud83d\ude00';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\ud83d\ude00', '\ud83d');
+addThis();
+
+status = inSection(28);
+pattern = /(?:\ud83d\ude00|\ud83d\ude01)+/;
+string = 'a\ud83d\ude01\ud83d\ude00b';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\ud83d\ude01\ud83d\ude00');
+addThis();
+
+status = inSection(29);
+pattern = /[\ud800-\udbff][\udc00-\udfff]/;
+string = 'ab\ud834\udd1e';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\ud834\udd1e');
+addThis();
+
+// Prefixes with characters that share a low byte with Latin-1 ones.
+status = inSection(30);
+pattern = /\u0161b/;
+string = 'aa\u0161b';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\u0161b');
+addThis();
+
+status = inSection(31);
+pattern = /a\u0100\u0100x/;
+string = 'aa\u0100a\u0100\u0100x';
+actualmatch = string.match(pattern);
+expectedmatch = Array('a\u0100\u0100x');
+addThis();
+
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusmessages[i] = status;
+  patterns[i] = pattern;
+  strings[i] = string;
+  actualmatches[i] = actualmatch;
+  expectedmatches[i] = expectedmatch;
+  i++;
+}
+
+
+function test()
+{
+  enterFunc ('test');
+  printBugNumber (bug);
+  printStatus (summary);
+  testRegExp(statusmessages, patterns, strings, actualmatches, expectedmatches);
+  exitFunc ('test');
+}
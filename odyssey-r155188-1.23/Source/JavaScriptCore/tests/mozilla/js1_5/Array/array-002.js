@@ -0,0 +1,134 @@
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: NPL 1.1/GPL 2.0/LGPL 2.1
+*
+* The contents of this file are subject to the Netscape Public License
+* Version 1.1 (the "License"); you may not use this file except in
+* compliance with the License. You may obtain a copy of the License at
+* http://www.mozilla.org/NPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is JavaScript Engine testing utilities.
+*
+* The Initial Developer of the Original Code is Netscape Communications Corp.
+* Portions created by the Initial Developer are Copyright (C) 2002
+* the Initial Developer. All Rights Reserved.
+*
+* Contributor(s): Fabien Coeurjoly
+*
+* Alternatively, the contents of this file may be used under the terms of
+* either the GNU General Public License Version 2 or later (the "GPL"), or
+* the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+* in which case the provisions of the GPL or the LGPL are applicable instead
+* of those above. If you wish to allow use of your version of this file only
+* under the terms of either the GPL or the LGPL, and not to allow others to
+* use your version of this file under the terms of the NPL, indicate your
+* decision by deleting the provisions above and replace them with the notice
+* and other provisions required by the GPL or the LGPL. If you do not delete
+* the provisions above, a recipient may use your version of this file under
+* the terms of any one of the NPL, the GPL or the LGPL.
+*
+* ***** END LICENSE BLOCK *****
+*
+*
+* SUMMARY: Sorting with a comparator close to the stack limit must not crash.
+*
+* Array.prototype.sort() on objects that are not plain arrays prepares one
+* call to the comparator and reuses it for every comparison. When there is no
+* stack left for that call the sort has to throw, not call the comparator
+* anyway. We recurse until the stack overflows and sort in the innermost
+* frame that caught the overflow: the sort either works or throws a
+* RangeError.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Sorting with a comparator close to the stack limit must not crash';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+function compare(a, b)
+{
+  return a - b;
+}
+
+function sortNearStackLimit(makeObject)
+{
+  var outcome = 'no overflow';
+
+  function recurse()
+  {
+    try
+    {
+      recurse();
+    }
+    catch (e)
+    {
+      if (outcome != 'no overflow')
+        return;
+      var obj = makeObject();
+      try
+      {
+        Array.prototype.sort.call(obj, compare);
+        outcome = (obj[0] === 1 && obj[1] === 2 && obj[2] === 3) ? 'no crash' : 'not sorted';
+      }
+      catch (e2)
+      {
+        outcome = (e2 instanceof RangeError) ? 'no crash' : 'unexpected ' + e2;
+      }
+    }
+  }
+
+  recurse();
+  return outcome;
+}
+
+
+status = inSection(1);
+actual = sortNearStackLimit(function () { return {length: 3, 0: 3, 1: 1, 2: 2}; });
+expect = 'no crash';
+addThis();
+
+status = inSection(2);
+actual = sortNearStackLimit(function () { var arr = [3, 1, 2]; arr[1000000] = 4; return arr; });
+expect = 'no crash';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,137 @@
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: NPL 1.1/GPL 2.0/LGPL 2.1
+*
+* The contents of this file are subject to the Netscape Public License
+* Version 1.1 (the "License"); you may not use this file except in
+* compliance with the License. You may obtain a copy of the License at
+* http://www.mozilla.org/NPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is JavaScript Engine testing utilities.
+*
+* The Initial Developer of the Original Code is Netscape Communications Corp.
+* Portions created by the Initial Developer are Copyright (C) 2002
+* the Initial Developer. All Rights Reserved.
+*
+* Contributor(s): Fabien Coeurjoly
+*
+* Alternatively, the contents of this file may be used under the terms of
+* either the GNU General Public License Version 2 or later (the "GPL"), or
+* the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+* in which case the provisions of the GPL or the LGPL are applicable instead
+* of those above. If you wish to allow use of your version of this file only
+* under the terms of either the GPL or the LGPL, and not to allow others to
+* use your version of this file under the terms of the NPL, indicate your
+* decision by deleting the provisions above and replace them with the notice
+* and other provisions required by the GPL or the LGPL. If you do not delete
+* the provisions above, a recipient may use your version of this file under
+* the terms of any one of the NPL, the GPL or the LGPL.
+*
+* ***** END LICENSE BLOCK *****
+*
+*
+* SUMMARY: indexOf() on ropes must find matches that span fibers.
+*
+* Strings built by concatenation are searched fiber by fiber instead of
+* being flattened first. A match may start in one fiber and end in a later
+* one, possibly skipping fibers shorter than the pattern. lastIndexOf() with
+* a position of 0 only compares the first fibers.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'indexOf() on ropes must find matches that span fibers';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+// Builds a fresh rope out of the pieces, which are never flattened.
+function rope(pieces)
+{
+  var result = '';
+  for (var i = 0; i < pieces.length; i++)
+    result += pieces[i];
+  return result;
+}
+
+var pieces = ['<html><bo', 'd', 'y>', 'text ', 'with &am', 'p; entities', '</body></html>'];
+var flat = pieces.join('');
+var patterns = ['<body>', 'dy>te', 'd', '&amp;', 'p; e', '</html>', 'missing', 'l><', ''];
+
+for (var i = 0; i < patterns.length; i++)
+{
+  status = inSection(i + 1) + ' indexOf("' + patterns[i] + '")';
+  actual = rope(pieces).indexOf(patterns[i]);
+  expect = flat.indexOf(patterns[i]);
+  addThis();
+
+  status = inSection(i + 1) + ' indexOf("' + patterns[i] + '", 9)';
+  actual = rope(pieces).indexOf(patterns[i], 9);
+  expect = flat.indexOf(patterns[i], 9);
+  addThis();
+
+  status = inSection(i + 1) + ' lastIndexOf("' + patterns[i] + '", 0)';
+  actual = rope(pieces).lastIndexOf(patterns[i], 0);
+  expect = flat.lastIndexOf(patterns[i], 0);
+  addThis();
+}
+
+status = inSection(patterns.length + 1) + ' 16-bit fibers';
+actual = rope(['caf', '\u00e9 ', '\u2603 ', 'snow']).indexOf('\u00e9 \u2603');
+expect = 3;
+addThis();
+
+// Many short fibers, as built by += in a loop.
+var shortPieces = [];
+for (var i = 0; i < 500; i++)
+  shortPieces.push(i % 50 == 49 ? '<b' : 'r>');
+var shortFlat = shortPieces.join('');
+
+status = inSection(patterns.length + 2) + ' short fibers';
+actual = rope(shortPieces).indexOf('<br>');
+expect = shortFlat.indexOf('<br>');
+addThis();
+
+status = inSection(patterns.length + 3) + ' short fibers, no match';
+actual = rope(shortPieces).indexOf('<b>');
+expect = -1;
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,38 @@
+(function () {
+    function compareRows(a, b) {
+        return a.key - b.key;
+    }
+
+    function makeRows(count) {
+        var rows = [];
+        for (var i = 0; i < count; ++i)
+            rows.push({ key: (i * 7919) % count });
+        return rows;
+    }
+
+    for (var iteration = 0; iteration < 20; ++iteration) {
+        // Array-like object.
+        var arrayLike = { length: 900 };
+        var rows = makeRows(900);
+        for (var i = 0; i < rows.length; ++i)
+            arrayLike[i] = rows[i];
+        Array.prototype.sort.call(arrayLike, compareRows);
+
+        // Array with holes.
+        var holey = makeRows(900);
+        for (var i = 0; i < holey.length; i += 10)
+            delete holey[i];
+        holey.sort(compareRows);
+
+        // Array with accessors.
+        var withGetters = makeRows(900);
+        Object.defineProperty(withGetters, 5, { get: function () { return { key: 5 }; }, configurable: true });
+        withGetters.sort(compareRows);
+
+        // Large sparse array, default comparison.
+        var sparse = [];
+        for (var i = 0; i < 2000; ++i)
+            sparse[i * 37] = "item" + ((i * 7919) % 2000);
+        sparse.sort();
+    }
+})();
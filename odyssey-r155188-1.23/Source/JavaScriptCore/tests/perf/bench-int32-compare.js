@@ -0,0 +1,12 @@
+(function () {
+    var count = 0;
+    for (var i = 0; i < 200; ++i) {
+        for (var j = 0; j < 100000; ++j) {
+            var less = i < j;
+            var greaterEq = j >= i;
+            if (less === greaterEq)
+                ++count;
+        }
+    }
+    return count;
+})();
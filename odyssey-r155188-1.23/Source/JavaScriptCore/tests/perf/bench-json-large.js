@@ -0,0 +1,22 @@
+(function () {
+    var records = [];
+    for (var i = 0; i < 5000; ++i) {
+        records.push({
+            id: i,
+            name: "record number " + i,
+            description: "A fairly long description string that carries no escapes at all, record " + i,
+            path: "C:\\data\\records\\" + i,
+            tags: ["alpha", "beta", "gamma"],
+            active: !(i % 3),
+            score: i / 7
+        });
+    }
+    var compact = JSON.stringify(records);
+    var pretty = JSON.stringify(records, null, 8);
+
+    for (var iteration = 0; iteration < 10; ++iteration) {
+        JSON.parse(compact);
+        JSON.parse(pretty);
+        JSON.stringify(records);
+    }
+})();
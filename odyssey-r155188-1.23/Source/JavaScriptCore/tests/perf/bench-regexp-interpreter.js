@@ -0,0 +1,29 @@
+(function () {
+    var words = [];
+    for (var i = 0; i < 2000; ++i)
+        words.push("word" + i);
+    var text = words.join("   \t ") + "\n";
+    var lines = [];
+    for (var i = 0; i < 200; ++i)
+        lines.push((i % 10 ? "line " : "#heading") + i + " " + text.substring(0, 200));
+    var document = lines.join("\n");
+    var addresses = [];
+    for (var i = 0; i < 500; ++i)
+        addresses.push(i % 3 ? "user" + i + "@example.com" : "not an address " + i);
+    var urls = [];
+    for (var i = 0; i < 500; ++i)
+        urls.push(i % 4 ? "http://www.example.com/path/" + i + "?q=" + i : "ftp:/broken" + i);
+
+    var email = /^[\w.+-]+@[\w-]+\.[\w.-]+$/;
+    var url = /^https?:\/\/[\w.-]+(?:\/[\w.\/?=&%-]*)?$/;
+
+    for (var iteration = 0; iteration < 20; ++iteration) {
+        text.split(/\s+/g);
+        document.match(/^#\w+/gm);
+        document.replace(/heading/g, "title");
+        for (var i = 0; i < addresses.length; ++i)
+            email.test(addresses[i]);
+        for (var i = 0; i < urls.length; ++i)
+            url.test(urls[i]);
+    }
+})();
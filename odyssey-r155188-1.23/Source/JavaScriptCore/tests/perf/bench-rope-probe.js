@@ -0,0 +1,19 @@
+(function () {
+    var header = "Content-Type: text/html; charset=utf-8\r\n";
+    var body = "";
+    for (var i = 0; i < 200; ++i)
+        body += "<p>paragraph " + i + "</p>";
+
+    var result = 0;
+    for (var iteration = 0; iteration < 20000; ++iteration) {
+        // Each message is a fresh shallow rope; peeking at its ends should not flatten it.
+        var message = header + "\r\n" + body;
+        result += message.charCodeAt(0);
+        if (message.charAt(header.length - 2) == "\r")
+            result += message.slice(0, 12).length;
+        result += message.substring(header.length + 2, header.length + 5).length;
+        result += message.substr(message.length - 4).length;
+    }
+    if (result <= 0)
+        throw "Bad result: " + result;
+})();
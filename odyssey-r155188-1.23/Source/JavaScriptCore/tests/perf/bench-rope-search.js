@@ -0,0 +1,24 @@
+(function () {
+    var chunk = "<tr><td class=\"cell\">value</td><td class=\"cell\">other value</td></tr>\n";
+
+    var result = 0;
+    for (var iteration = 0; iteration < 200; ++iteration) {
+        // Each document is a fresh rope of a few thousand fibers; probing near its start
+        // should not copy the whole of it.
+        var html = "<!DOCTYPE html><html><head><title>Report</title></head><body><table>\n";
+        for (var i = 0; i < 2000; ++i)
+            html += chunk;
+        html += "</table></body></html>";
+        if (html.lastIndexOf("<!DOCTYPE", 0) == 0)
+            result += html.indexOf("<body>");
+        result += html.indexOf("</td>", 100);
+
+        // Text appended a few characters at a time.
+        var text = "";
+        for (var i = 0; i < 2000; ++i)
+            text += i % 10 + " ";
+        result += text.indexOf("9 0");
+    }
+    if (result <= 0)
+        throw "Bad result: " + result;
+})();
@@ -1291,6 +1291,9 @@ public:
 
             input.next();
 
+            if (pattern->m_matchStartFilter.isEnabled() && !skipToPossibleMatchStart())
+                return JSRegExpNoMatch;
+
             context->matchBegin = input.getPos();
 
             if (currentTerm().alternative.onceThrough)
@@ -1395,6 +1398,60 @@ public:
         return JSRegExpErrorNoMatch;
     }
 
+    // Moves the input forward to the first offset at or after the current one
+    // at which the pattern's MatchStartFilter allows a match to begin. Returns
+    // false if there is no such offset.
+    bool skipToPossibleMatchStart()
+    {
+        const MatchStartFilter& filter = pattern->m_matchStartFilter;
+        unsigned pos = input.getPos();
+        unsigned end = input.end();
+
+        while (true) {
+            if (filter.hasPrefix())
+                pos = findPrefix(filter, pos);
+            else if (filter.m_hasFirstCharacters) {
+                while (pos < end && !filter.canStartWith(input.reread(pos)))
+                    ++pos;
+            }
+
+            if (filter.m_hasFirstCharacters && pos >= end)
+                return false;
+
+            if (!filter.m_requiresLineStart || !pos || testCharacterClass(pattern->newlineCharacterClass, input.reread(pos - 1))) {
+                input.setPos(pos);
+                return true;
+            }
+
+            if (pos >= end)
+                return false;
+            ++pos;
+        }
+    }
+
+    // Boyer-Moore-Horspool search for the pattern's literal prefix. Returns the
+    // end of the input if the prefix does not occur at or after |pos|.
+    unsigned findPrefix(const MatchStartFilter& filter, unsigned pos)
+    {
+        const Vector<UChar>& prefix = filter.m_prefix;
+        unsigned prefixLength = prefix.size();
+        unsigned end = input.end();
+        int lastCharacter = prefix[prefixLength - 1];
+
+        while (end - pos >= prefixLength) {
+            int ch = input.reread(pos + prefixLength - 1);
+            if (ch == lastCharacter) {
+                unsigned i = prefixLength - 1;
+                while (i && input.reread(pos + i - 1) == prefix[i - 1])
+                    --i;
+                if (!i)
+                    return pos;
+            }
+            pos += filter.m_prefixShift[ch & 0xff];
+        }
+        return end;
+    }
+
     JSRegExpResult matchNonZeroDisjunction(ByteDisjunction* disjunction, DisjunctionContext* context, bool btrack = false)
     {
         JSRegExpResult result = matchDisjunction(disjunction, context, btrack);
@@ -1419,6 +1476,9 @@ public:
         for (unsigned i = 0; i < pattern->m_body->m_numSubpatterns + 1; ++i)
             output[i << 1] = offsetNoMatch;
 
+        if (pattern->m_matchStartFilter.isEnabled() && !skipToPossibleMatchStart())
+            return offsetNoMatch;
+
         allocatorPool = pattern->m_allocator->startAllocator();
         RELEASE_ASSERT(allocatorPool);
 
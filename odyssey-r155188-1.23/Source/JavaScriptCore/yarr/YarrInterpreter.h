@@ -341,6 +341,7 @@ public:
         : m_body(body)
         , m_ignoreCase(pattern.m_ignoreCase)
         , m_multiline(pattern.m_multiline)
+        , m_matchStartFilter(pattern.m_matchStartFilter)
         , m_allocator(allocator)
     {
         m_body->terms.shrinkToFit();
@@ -355,9 +356,24 @@ public:
         m_userCharacterClasses.shrinkToFit();
     }
 
+    size_t estimatedSizeInBytes() const
+    {
+        size_t size = sizeof(BytecodePattern) + m_body->terms.size() * sizeof(ByteTerm);
+        for (size_t i = 0; i < m_allParenthesesInfo.size(); ++i)
+            size += sizeof(ByteDisjunction) + m_allParenthesesInfo[i]->terms.size() * sizeof(ByteTerm);
+        for (size_t i = 0; i < m_userCharacterClasses.size(); ++i) {
+            CharacterClass* characterClass = m_userCharacterClasses[i].get();
+            size += sizeof(CharacterClass);
+            size += (characterClass->m_matches.size() + characterClass->m_matchesUnicode.size()) * sizeof(UChar);
+            size += (characterClass->m_ranges.size() + characterClass->m_rangesUnicode.size()) * sizeof(CharacterRange);
+        }
+        return size;
+    }
+
     OwnPtr<ByteDisjunction> m_body;
     bool m_ignoreCase;
     bool m_multiline;
+    MatchStartFilter m_matchStartFilter;
     // Each BytecodePattern is associated with a RegExp, each RegExp is associated
     // with a VM.  Cache a pointer to out VM's m_regExpAllocator.
     BumpPointerAllocator* m_allocator;
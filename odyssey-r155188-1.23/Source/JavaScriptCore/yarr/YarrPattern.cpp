@@ -818,6 +818,136 @@ public:
         }
     }
 
+    // Computes the pattern's MatchStartFilter from the first characters every
+    // alternative of the body must consume, a literal prefix shared by all
+    // matches, and whether all alternatives are anchored to the start of a line.
+    void computeMatchStartFilter()
+    {
+        MatchStartFilter& filter = m_pattern.m_matchStartFilter;
+        Vector<OwnPtr<PatternAlternative> >& alternatives = m_pattern.m_body->m_alternatives;
+
+        bool allStartWithBOL = true;
+        for (size_t i = 0; i < alternatives.size(); ++i) {
+            if (!alternatives[i]->m_startsWithBOL)
+                allStartWithBOL = false;
+        }
+        filter.m_requiresLineStart = m_pattern.m_multiline && allStartWithBOL;
+
+        MatchStartFilter firstCharacters;
+        if (addFirstCharacters(m_pattern.m_body, firstCharacters) != FirstCharacterConsumed)
+            return;
+        firstCharacters.m_hasFirstCharacters = true;
+        firstCharacters.m_requiresLineStart = filter.m_requiresLineStart;
+        filter = firstCharacters;
+
+        if (alternatives.size() != 1 || m_pattern.m_ignoreCase)
+            return;
+
+        Vector<PatternTerm>& terms = alternatives[0]->m_terms;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            PatternTerm& term = terms[i];
+            if (term.type != PatternTerm::TypePatternCharacter || term.quantityType != QuantifierFixedCount)
+                break;
+            unsigned count = term.quantityCount.unsafeGet();
+            if (filter.m_prefix.size() + count > MatchStartFilter::maximumPrefixLength)
+                break;
+            for (unsigned j = 0; j < count; ++j)
+                filter.m_prefix.append(term.patternCharacter);
+        }
+
+        if (!filter.hasPrefix())
+            return;
+
+        unsigned prefixLength = filter.m_prefix.size();
+        for (unsigned i = 0; i < WTF_ARRAY_LENGTH(filter.m_prefixShift); ++i)
+            filter.m_prefixShift[i] = prefixLength;
+        // Characters sharing a low byte share a slot; later positions give
+        // smaller shifts, so each slot ends up with the safe minimum.
+        for (unsigned i = 0; i < prefixLength - 1; ++i)
+            filter.m_prefixShift[filter.m_prefix[i] & 0xff] = prefixLength - 1 - i;
+    }
+
+private:
+    enum FirstCharacterResult {
+        FirstCharacterConsumed,
+        FirstCharacterOptional,
+        FirstCharacterUnknown,
+    };
+
+    FirstCharacterResult addFirstCharacters(PatternDisjunction* disjunction, MatchStartFilter& filter)
+    {
+        FirstCharacterResult result = FirstCharacterConsumed;
+        for (size_t i = 0; i < disjunction->m_alternatives.size(); ++i) {
+            FirstCharacterResult alternativeResult = addFirstCharacters(disjunction->m_alternatives[i].get(), filter);
+            if (alternativeResult == FirstCharacterUnknown)
+                return FirstCharacterUnknown;
+            if (alternativeResult == FirstCharacterOptional)
+                result = FirstCharacterOptional;
+        }
+        return result;
+    }
+
+    // Adds every character that can be the first one consumed by the
+    // alternative. Terms that may match empty contribute their characters and
+    // the scan continues with the next term.
+    FirstCharacterResult addFirstCharacters(PatternAlternative* alternative, MatchStartFilter& filter)
+    {
+        Vector<PatternTerm>& terms = alternative->m_terms;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            PatternTerm& term = terms[i];
+            bool mayMatchEmpty = term.quantityType != QuantifierFixedCount || !term.quantityCount;
+
+            switch (term.type) {
+            case PatternTerm::TypeAssertionBOL:
+            case PatternTerm::TypeAssertionEOL:
+            case PatternTerm::TypeAssertionWordBoundary:
+            case PatternTerm::TypeParentheticalAssertion:
+            case PatternTerm::TypeForwardReference:
+                continue;
+
+            case PatternTerm::TypePatternCharacter:
+                filter.addFirstCharacter(term.patternCharacter);
+                if (m_pattern.m_ignoreCase) {
+                    filter.addFirstCharacter(Unicode::toLower(term.patternCharacter));
+                    filter.addFirstCharacter(Unicode::toUpper(term.patternCharacter));
+                }
+                break;
+
+            case PatternTerm::TypeCharacterClass: {
+                if (term.invert())
+                    return FirstCharacterUnknown;
+                CharacterClass* characterClass = term.characterClass;
+                for (size_t j = 0; j < characterClass->m_matches.size(); ++j)
+                    filter.addFirstCharacter(characterClass->m_matches[j]);
+                for (size_t j = 0; j < characterClass->m_ranges.size(); ++j)
+                    filter.addFirstCharacterRange(characterClass->m_ranges[j].begin, characterClass->m_ranges[j].end);
+                for (size_t j = 0; j < characterClass->m_matchesUnicode.size(); ++j)
+                    filter.addFirstCharacter(characterClass->m_matchesUnicode[j]);
+                for (size_t j = 0; j < characterClass->m_rangesUnicode.size(); ++j)
+                    filter.addFirstCharacterRange(characterClass->m_rangesUnicode[j].begin, characterClass->m_rangesUnicode[j].end);
+                break;
+            }
+
+            case PatternTerm::TypeParenthesesSubpattern: {
+                FirstCharacterResult result = addFirstCharacters(term.parentheses.disjunction, filter);
+                if (result == FirstCharacterUnknown)
+                    return FirstCharacterUnknown;
+                if (result == FirstCharacterOptional)
+                    mayMatchEmpty = true;
+                break;
+            }
+
+            case PatternTerm::TypeBackReference:
+            case PatternTerm::TypeDotStarEnclosure:
+                return FirstCharacterUnknown;
+            }
+
+            if (!mayMatchEmpty)
+                return FirstCharacterConsumed;
+        }
+        return FirstCharacterOptional;
+    }
+
 private:
     YarrPattern& m_pattern;
     PatternAlternative* m_alternative;
@@ -855,6 +985,7 @@ const char* YarrPattern::compile(const String& patternString)
     constructor.optimizeBOL();
         
     constructor.setupOffsets();
+    constructor.computeMatchStartFilter();
 
     return 0;
 }
@@ -303,6 +303,61 @@ struct TermChain {
     Vector<TermChain> hotTerms;
 };
 
+// Summary of the offsets at which a match of the whole pattern can begin. It
+// is computed once per pattern so that the interpreter can skip start offsets
+// that cannot match, rather than running the backtracking matcher at each one.
+struct MatchStartFilter {
+    static const unsigned maximumPrefixLength = 255;
+
+    MatchStartFilter()
+        : m_hasFirstCharacters(false)
+        , m_allowsNonLatin1FirstCharacter(false)
+        , m_requiresLineStart(false)
+    {
+        for (unsigned i = 0; i < WTF_ARRAY_LENGTH(m_latin1FirstCharacters); ++i)
+            m_latin1FirstCharacters[i] = 0;
+        for (unsigned i = 0; i < WTF_ARRAY_LENGTH(m_prefixShift); ++i)
+            m_prefixShift[i] = 0;
+    }
+
+    bool isEnabled() const { return m_hasFirstCharacters || m_requiresLineStart; }
+    bool hasPrefix() const { return m_prefix.size() > 1; }
+
+    bool canStartWith(int ch) const
+    {
+        if (ch > 0xff)
+            return m_allowsNonLatin1FirstCharacter;
+        return m_latin1FirstCharacters[ch >> 5] & (1u << (ch & 31));
+    }
+
+    void addFirstCharacterRange(UChar begin, UChar end)
+    {
+        if (end > 0xff) {
+            m_allowsNonLatin1FirstCharacter = true;
+            if (begin > 0xff)
+                return;
+            end = 0xff;
+        }
+        for (unsigned ch = begin; ch <= end; ++ch)
+            m_latin1FirstCharacters[ch >> 5] |= 1u << (ch & 31);
+    }
+
+    void addFirstCharacter(UChar ch) { addFirstCharacterRange(ch, ch); }
+
+    // Every match begins with a character for which canStartWith() is true.
+    bool m_hasFirstCharacters : 1;
+    bool m_allowsNonLatin1FirstCharacter : 1;
+    // Every match begins at the start of the input or just after a newline.
+    bool m_requiresLineStart : 1;
+    uint32_t m_latin1FirstCharacters[8];
+
+    // Literal text that every match begins with. When it is at least two
+    // characters long the interpreter locates it with a Horspool scan, using
+    // m_prefixShift indexed by the low byte of the character being examined.
+    Vector<UChar> m_prefix;
+    uint8_t m_prefixShift[256];
+};
+
 struct YarrPattern {
     JS_EXPORT_PRIVATE YarrPattern(const String& pattern, bool ignoreCase, bool multiline, const char** error);
 
@@ -324,6 +379,7 @@ struct YarrPattern {
 
         m_disjunctions.clear();
         m_userCharacterClasses.clear();
+        m_matchStartFilter = MatchStartFilter();
     }
 
     bool containsIllegalBackReference()
@@ -383,6 +439,7 @@ struct YarrPattern {
     PatternDisjunction* m_body;
     Vector<OwnPtr<PatternDisjunction>, 4> m_disjunctions;
     Vector<OwnPtr<CharacterClass> > m_userCharacterClasses;
+    MatchStartFilter m_matchStartFilter;
 
 private:
     const char* compile(const String& patternString);
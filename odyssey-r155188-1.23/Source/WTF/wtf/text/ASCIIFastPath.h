@@ -100,6 +100,49 @@ inline bool charactersAreAllASCII(const CharacterType* characters, size_t length
     return !(allCharBits & nonASCIIBitMask);
 }
 
+// A machine word with every byte set to |byte|.
+inline MachineWord repeatedByte(uint8_t byte)
+{
+    return (~static_cast<MachineWord>(0) / 0xFF) * byte;
+}
+
+// True if any byte of |word| is less than |bound|, which must not exceed 0x80.
+// This only answers for the word as a whole; it does not tell which byte matched.
+inline bool wordHasByteLessThan(MachineWord word, uint8_t bound)
+{
+    ASSERT(bound <= 0x80);
+    return (word - repeatedByte(bound)) & ~word & repeatedByte(0x80);
+}
+
+inline bool wordHasByte(MachineWord word, uint8_t byte)
+{
+    return wordHasByteLessThan(word ^ repeatedByte(byte), 1);
+}
+
+// Returns the first character in [characters, end) that is a control character
+// (below 0x20) or equal to |first| or |second|, or |end| if there is none.
+// Runs without a match are checked a machine word at a time.
+inline const LChar* findControlCharacterOr(const LChar* characters, const LChar* end, LChar first, LChar second)
+{
+    while (characters != end && !isAlignedToMachineWord(characters)) {
+        if (*characters < 0x20 || *characters == first || *characters == second)
+            return characters;
+        ++characters;
+    }
+
+    const LChar* wordEnd = alignToMachineWord(end);
+    while (characters < wordEnd) {
+        MachineWord word = *reinterpret_cast_ptr<const MachineWord*>(characters);
+        if (wordHasByteLessThan(word, 0x20) || wordHasByte(word, first) || wordHasByte(word, second))
+            break;
+        characters += sizeof(MachineWord);
+    }
+
+    while (characters != end && *characters >= 0x20 && *characters != first && *characters != second)
+        ++characters;
+    return characters;
+}
+
 inline void copyLCharsFromUCharSource(LChar* destination, const UChar* source, size_t length)
 {
 #if OS(DARWIN) && (CPU(X86) || CPU(X86_64))
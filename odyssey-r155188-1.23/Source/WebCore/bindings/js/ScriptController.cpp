@@ -162,6 +162,19 @@ ScriptValue ScriptController::evaluate(const ScriptSourceCode& sourceCode)
     return evaluateInWorld(sourceCode, mainThreadNormalWorld());
 }
 
+void ScriptController::precompileScript(const ScriptSourceCode& sourceCode)
+{
+    if (sourceCode.isEmpty() || !canExecuteScripts(NotAboutToExecuteScript))
+        return;
+
+    JSDOMWindowShell* shell = windowShell(mainThreadNormalWorld());
+    ExecState* exec = shell->window()->globalExec();
+    JSLockHolder lock(exec);
+
+    // Failures are deliberately ignored; evaluate() compiles the script again and reports them.
+    JSC::prepareProgram(exec, sourceCode.jsSourceCode());
+}
+
 PassRefPtr<DOMWrapperWorld> ScriptController::createWorld()
 {
     return DOMWrapperWorld::create(JSDOMWindow::commonVM());
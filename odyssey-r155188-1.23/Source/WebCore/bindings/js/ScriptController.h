@@ -104,6 +104,10 @@ public:
     ScriptValue evaluate(const ScriptSourceCode&);
     ScriptValue evaluateInWorld(const ScriptSourceCode&, DOMWrapperWorld*);
 
+    // Compiles a script that is about to be evaluated into the VM's code cache, for use
+    // while the main thread would otherwise sit idle waiting for the script to be allowed to run.
+    void precompileScript(const ScriptSourceCode&);
+
     WTF::TextPosition eventHandlerPosition() const;
 
     void enableEval();
@@ -168,6 +168,12 @@ PassRefPtr<SimpleFontData> CSSFontFaceSource::getFontData(const FontDescription&
 #endif
         }
     } else {
+        // Text that uses this face waits for the font, so it goes ahead of images. Faces
+        // limited by unicode-range are asked for even when the text has no character in
+        // their range, so those keep the default priority.
+        if (m_face && m_face->ranges().isEmpty())
+            m_font->setLoadPriority(ResourceLoadPriorityHigh);
+
         // Kick off the load. Do it soon rather than now, because we may be in the middle of layout,
         // and the loader may invoke arbitrary delegate or event handler code.
         fontSelector->beginLoadingFontSoon(m_font.get());
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CompiledSelector.h"
+
+#include "CSSSelectorList.h"
+#include "Document.h"
+#include "Element.h"
+#include "InspectorInstrumentation.h"
+#include "RenderStyle.h"
+#include <algorithm>
+
+namespace WebCore {
+
+bool CompiledSelector::isCheaperCheck(const Check& a, const Check& b)
+{
+    return a.type < b.type;
+}
+
+bool CompiledSelector::compileCheck(const CSSSelector* selector, bool isSubSelector, Check& check)
+{
+    check.selector = selector;
+    check.isNegated = false;
+    check.isSubSelector = isSubSelector;
+
+    if (selector->m_match == CSSSelector::Id)
+        check.type = CheckId;
+    else if (selector->m_match == CSSSelector::Class)
+        check.type = CheckClass;
+    else if (selector->m_match == CSSSelector::Tag)
+        check.type = CheckTag;
+    else if (selector->isAttributeSelector())
+        check.type = CheckAttribute;
+    else if (selector->m_match == CSSSelector::PseudoClass) {
+        switch (selector->pseudoType()) {
+        case CSSSelector::PseudoLink:
+        case CSSSelector::PseudoAnyLink:
+            check.type = CheckLink;
+            break;
+        case CSSSelector::PseudoVisited:
+            check.type = CheckVisited;
+            break;
+        case CSSSelector::PseudoFocus:
+            check.type = CheckFocus;
+            break;
+        case CSSSelector::PseudoHover:
+            check.type = CheckHover;
+            break;
+        case CSSSelector::PseudoActive:
+            check.type = CheckActive;
+            break;
+        case CSSSelector::PseudoRoot:
+            check.type = CheckRoot;
+            break;
+        case CSSSelector::PseudoNot: {
+            // Only negations of a single id, class, tag or attribute are compiled.
+            const CSSSelectorList* selectorList = selector->selectorList();
+            if (!selectorList)
+                return false;
+            const CSSSelector* negatedSelector = selectorList->first();
+            if (negatedSelector->tagHistory() || CSSSelectorList::next(negatedSelector))
+                return false;
+            if (negatedSelector->m_match == CSSSelector::PseudoClass || !compileCheck(negatedSelector, true, check))
+                return false;
+            check.isNegated = true;
+            break;
+        }
+        default:
+            return false;
+        }
+    } else
+        return false;
+    return true;
+}
+
+PassOwnPtr<CompiledSelector> CompiledSelector::compile(const CSSSelector* selector)
+{
+    OwnPtr<CompiledSelector> compiledSelector = adoptPtr(new CompiledSelector);
+    Vector<Check, 4>& checks = compiledSelector->m_checks;
+
+    const CSSSelector* component = selector;
+    while (component) {
+        Compound compound;
+        compound.firstCheck = checks.size();
+        unsigned componentCount = 0;
+        for (;; component = component->tagHistory()) {
+            Check check;
+            if (!compileCheck(component, componentCount > 0, check))
+                return nullptr;
+            ++componentCount;
+            // The universal selector matches everything.
+            if (check.type != CheckTag || check.isNegated || component->tagQName() != anyQName())
+                checks.append(check);
+            if (component->relation() != CSSSelector::SubSelector || !component->tagHistory())
+                break;
+        }
+        compound.checkCount = checks.size() - compound.firstCheck;
+        compound.relation = component->relation();
+        compound.hasSingleComponent = componentCount == 1;
+        if (component->tagHistory() && compound.relation == CSSSelector::ShadowDescendant)
+            return nullptr;
+        std::stable_sort(checks.begin() + compound.firstCheck, checks.end(), isCheaperCheck);
+        compiledSelector->m_compounds.append(compound);
+        component = component->tagHistory();
+    }
+
+    checks.shrinkToFit();
+    compiledSelector->m_compounds.shrinkToFit();
+    return compiledSelector.release();
+}
+
+static inline bool matchesHoverOrActive(CSSSelector::PseudoType pseudoType, Element* element, RenderStyle* elementStyle, bool isSubSelector, SelectorChecker::Mode mode)
+{
+    // In quirks mode :hover and :active on their own only match links, see SelectorChecker::checkOne().
+    if (!isSubSelector && !element->isLink() && element->document().inQuirksMode())
+        return false;
+    if (pseudoType == CSSSelector::PseudoHover) {
+        if (mode == SelectorChecker::ResolvingStyle) {
+            if (elementStyle)
+                elementStyle->setAffectedByHover();
+            else
+                element->setChildrenAffectedByHover(true);
+        }
+        return element->hovered() || InspectorInstrumentation::forcePseudoState(element, CSSSelector::PseudoHover);
+    }
+    if (mode == SelectorChecker::ResolvingStyle) {
+        if (elementStyle)
+            elementStyle->setAffectedByActive();
+        else
+            element->setChildrenAffectedByActive(true);
+    }
+    return element->active() || InspectorInstrumentation::forcePseudoState(element, CSSSelector::PseudoActive);
+}
+
+bool CompiledSelector::matchesCompound(const Compound& compound, Element* element, RenderStyle* elementStyle, SelectorChecker::VisitedMatchType visitedMatchType, SelectorChecker::Mode mode) const
+{
+    const Check* checks = m_checks.data() + compound.firstCheck;
+    for (unsigned i = 0; i < compound.checkCount; ++i) {
+        const Check& check = checks[i];
+        const CSSSelector* selector = check.selector;
+        bool result;
+        switch (check.type) {
+        case CheckId:
+            result = element->hasID() && element->idForStyleResolution().impl() == selector->value().impl();
+            break;
+        case CheckClass:
+            result = element->hasClass() && element->classNames().contains(selector->value());
+            break;
+        case CheckTag:
+            result = SelectorChecker::tagMatches(element, selector->tagQName());
+            break;
+        case CheckAttribute:
+            result = SelectorChecker::attributeSelectorMatches(element, selector, element->document().isHTMLDocument());
+            break;
+        case CheckLink:
+            result = element->isLink();
+            break;
+        case CheckVisited:
+            result = element->isLink() && visitedMatchType == SelectorChecker::VisitedMatchEnabled;
+            break;
+        case CheckFocus:
+            result = SelectorChecker::matchesFocusPseudoClass(element);
+            break;
+        case CheckHover:
+        case CheckActive:
+            result = matchesHoverOrActive(selector->pseudoType(), element, elementStyle, check.isSubSelector, mode);
+            break;
+        case CheckRoot:
+            result = element == element->document().documentElement();
+            break;
+        default:
+            ASSERT_NOT_REACHED();
+            result = false;
+        }
+        if (result == check.isNegated)
+            return false;
+    }
+    return true;
+}
+
+SelectorChecker::Match CompiledSelector::match(unsigned compoundIndex, Element* element, RenderStyle* elementStyle, SelectorChecker::VisitedMatchType visitedMatchType, SelectorChecker::Mode mode) const
+{
+    const Compound& compound = m_compounds[compoundIndex];
+    if (!matchesCompound(compound, element, elementStyle, visitedMatchType, mode))
+        return SelectorChecker::SelectorFailsLocally;
+    if (compoundIndex + 1 == m_compounds.size())
+        return SelectorChecker::SelectorMatches;
+
+    ++compoundIndex;
+    CSSSelector::Relation relation = compound.relation;
+    if (compound.hasSingleComponent && (element->isLink() || (relation != CSSSelector::Descendant && relation != CSSSelector::Child)))
+        visitedMatchType = SelectorChecker::VisitedMatchDisabled;
+
+    switch (relation) {
+    case CSSSelector::Descendant:
+        for (Element* ancestor = element->parentElement(); ancestor; ancestor = ancestor->parentElement()) {
+            SelectorChecker::Match result = match(compoundIndex, ancestor, 0, visitedMatchType, mode);
+            if (result == SelectorChecker::SelectorMatches || result == SelectorChecker::SelectorFailsCompletely)
+                return result;
+        }
+        return SelectorChecker::SelectorFailsCompletely;
+    case CSSSelector::Child: {
+        Element* parent = element->parentElement();
+        if (!parent)
+            return SelectorChecker::SelectorFailsCompletely;
+        return match(compoundIndex, parent, 0, visitedMatchType, mode);
+    }
+    case CSSSelector::DirectAdjacent: {
+        if (mode == SelectorChecker::ResolvingStyle) {
+            if (Element* parent = element->parentElement())
+                parent->setChildrenAffectedByDirectAdjacentRules();
+        }
+        Element* sibling = element->previousElementSibling();
+        if (!sibling)
+            return SelectorChecker::SelectorFailsAllSiblings;
+        return match(compoundIndex, sibling, 0, visitedMatchType, mode);
+    }
+    case CSSSelector::IndirectAdjacent:
+        if (mode == SelectorChecker::ResolvingStyle) {
+            if (Element* parent = element->parentElement())
+                parent->setChildrenAffectedByForwardPositionalRules();
+        }
+        for (Element* sibling = element->previousElementSibling(); sibling; sibling = sibling->previousElementSibling()) {
+            SelectorChecker::Match result = match(compoundIndex, sibling, 0, visitedMatchType, mode);
+            if (result == SelectorChecker::SelectorMatches || result == SelectorChecker::SelectorFailsAllSiblings || result == SelectorChecker::SelectorFailsCompletely)
+                return result;
+        }
+        return SelectorChecker::SelectorFailsAllSiblings;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+    return SelectorChecker::SelectorFailsCompletely;
+}
+
+bool CompiledSelector::matches(Element* element, RenderStyle* elementStyle, SelectorChecker::Mode mode) const
+{
+    return match(0, element, elementStyle, SelectorChecker::VisitedMatchEnabled, mode) == SelectorChecker::SelectorMatches;
+}
+
+} // namespace WebCore
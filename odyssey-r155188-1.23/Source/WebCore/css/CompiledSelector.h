@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CompiledSelector_h
+#define CompiledSelector_h
+
+#include "CSSSelector.h"
+#include "SelectorChecker.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Element;
+class RenderStyle;
+
+// A selector flattened into a list of compound selectors, each a short list of checks sorted
+// cheapest first, so that matching does not have to walk and recurse through CSSSelector
+// components. Only selectors whose matching has no side effects other than the affectedBy flags
+// reproduced here are compiled; everything else is left to SelectorChecker.
+class CompiledSelector {
+    WTF_MAKE_NONCOPYABLE(CompiledSelector); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<CompiledSelector> compile(const CSSSelector*);
+
+    // Equivalent to SelectorChecker::match() with VisitedMatchEnabled, no scope and no pseudo element.
+    bool matches(Element*, RenderStyle* elementStyle, SelectorChecker::Mode) const;
+
+private:
+    CompiledSelector() { }
+
+    enum CheckType {
+        CheckId,
+        CheckClass,
+        CheckTag,
+        CheckAttribute,
+        CheckLink,
+        CheckVisited,
+        CheckFocus,
+        CheckHover,
+        CheckActive,
+        CheckRoot
+    };
+
+    struct Check {
+        const CSSSelector* selector;
+        unsigned type : 4; // CheckType
+        unsigned isNegated : 1;
+        // The interpreter relaxes :hover and :active in quirks mode for all but the first component of a compound.
+        unsigned isSubSelector : 1;
+    };
+
+    struct Compound {
+        unsigned firstCheck;
+        unsigned checkCount;
+        CSSSelector::Relation relation; // To the compound on the left.
+        // Mirrors the interpreter, which only disables :visited matching after single component compounds.
+        bool hasSingleComponent;
+    };
+
+    static bool compileCheck(const CSSSelector*, bool isSubSelector, Check&);
+    static bool isCheaperCheck(const Check&, const Check&);
+    bool matchesCompound(const Compound&, Element*, RenderStyle* elementStyle, SelectorChecker::VisitedMatchType, SelectorChecker::Mode) const;
+    SelectorChecker::Match match(unsigned compoundIndex, Element*, RenderStyle* elementStyle, SelectorChecker::VisitedMatchType, SelectorChecker::Mode) const;
+
+    Vector<Check, 4> m_checks;
+    Vector<Compound, 2> m_compounds;
+};
+
+} // namespace WebCore
+
+#endif // CompiledSelector_h
@@ -35,6 +35,7 @@
 #include "CSSSelector.h"
 #include "CSSSelectorList.h"
 #include "CSSValueKeywords.h"
+#include "CompiledSelector.h"
 #include "HTMLElement.h"
 #include "RenderRegion.h"
 #include "SVGElement.h"
@@ -365,6 +366,15 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, const Co
         return selectorCheckerFastPath.matches();
     }
 
+    if (!scope) {
+        if (const CompiledSelector* compiledSelector = ruleData.rule()->compiledSelector(ruleData.selectorIndex())) {
+            // Compiled selectors never include pseudo elements.
+            if (m_pseudoStyleRequest.pseudoId != NOPSEUDO)
+                return false;
+            return compiledSelector->matches(state.element(), state.style(), m_mode);
+        }
+    }
+
     // Slow path.
     SelectorChecker selectorChecker(document(), m_mode);
     SelectorChecker::SelectorCheckingContext context(ruleData.selector(), state.element(), SelectorChecker::VisitedMatchEnabled);
@@ -30,9 +30,151 @@
 #include "RuleFeature.h"
 
 #include "CSSSelector.h"
+#include "CSSSelectorList.h"
+#include "Element.h"
 
 namespace WebCore {
 
+void DescendantInvalidationSet::combine(const DescendantInvalidationSet& other)
+{
+    m_invalidatesSiblings = m_invalidatesSiblings || other.m_invalidatesSiblings;
+    if (m_wholeSubtreeInvalid)
+        return;
+    if (other.m_wholeSubtreeInvalid) {
+        m_wholeSubtreeInvalid = true;
+        m_classes.clear();
+        m_ids.clear();
+        m_tagNames.clear();
+        m_attributes.clear();
+        return;
+    }
+    HashSet<AtomicStringImpl*>::const_iterator end = other.m_classes.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = other.m_classes.begin(); it != end; ++it)
+        m_classes.add(*it);
+    end = other.m_ids.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = other.m_ids.begin(); it != end; ++it)
+        m_ids.add(*it);
+    end = other.m_tagNames.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = other.m_tagNames.begin(); it != end; ++it)
+        m_tagNames.add(*it);
+    end = other.m_attributes.end();
+    for (HashSet<AtomicStringImpl*>::const_iterator it = other.m_attributes.begin(); it != end; ++it)
+        m_attributes.add(*it);
+}
+
+bool DescendantInvalidationSet::invalidatesElement(const Element* element) const
+{
+    if (m_wholeSubtreeInvalid)
+        return true;
+    if (!m_tagNames.isEmpty() && m_tagNames.contains(element->localName().impl()))
+        return true;
+    if (!m_ids.isEmpty() && element->hasID() && m_ids.contains(element->idForStyleResolution().impl()))
+        return true;
+    if (!m_classes.isEmpty() && element->hasClass()) {
+        const SpaceSplitString& classNames = element->classNames();
+        for (unsigned i = 0; i < classNames.size(); ++i) {
+            if (m_classes.contains(classNames[i].impl()))
+                return true;
+        }
+    }
+    if (!m_attributes.isEmpty()) {
+        element->synchronizeAllAttributes();
+        if (!element->hasAttributesWithoutUpdate())
+            return false;
+        unsigned attributeCount = element->attributeCount();
+        for (unsigned i = 0; i < attributeCount; ++i) {
+            if (m_attributes.contains(element->attributeAt(i).localName().impl()))
+                return true;
+        }
+    }
+    return false;
+}
+
+static DescendantInvalidationSet& ensureInvalidationSet(InvalidationSetMap& map, AtomicStringImpl* key)
+{
+    OwnPtr<DescendantInvalidationSet>& invalidationSet = map.add(key, nullptr).iterator->value;
+    if (!invalidationSet)
+        invalidationSet = adoptPtr(new DescendantInvalidationSet);
+    return *invalidationSet;
+}
+
+static void addInvalidationSets(InvalidationSetMap& map, const InvalidationSetMap& other)
+{
+    InvalidationSetMap::const_iterator end = other.end();
+    for (InvalidationSetMap::const_iterator it = other.begin(); it != end; ++it)
+        ensureInvalidationSet(map, it->key).combine(*it->value);
+}
+
+static void addInvalidationSetsForFeatures(RuleFeatureSet& features, const CSSSelector* selector, const DescendantInvalidationSet& descendantFeatures)
+{
+    if (selector->m_match == CSSSelector::Id)
+        ensureInvalidationSet(features.idInvalidationSets, selector->value().impl()).combine(descendantFeatures);
+    else if (selector->m_match == CSSSelector::Class)
+        ensureInvalidationSet(features.classInvalidationSets, selector->value().impl()).combine(descendantFeatures);
+    else if (selector->isAttributeSelector())
+        ensureInvalidationSet(features.attributeInvalidationSets, selector->attribute().localName().impl()).combine(descendantFeatures);
+
+    if (const CSSSelectorList* selectorList = selector->selectorList()) {
+        for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+            for (const CSSSelector* component = subSelector; component; component = component->tagHistory())
+                addInvalidationSetsForFeatures(features, component, descendantFeatures);
+        }
+    }
+}
+
+void RuleFeatureSet::collectInvalidationSetsFromSelector(const CSSSelector* selector)
+{
+    // Find the most selective feature of the subject compound. A descendant that does not have
+    // it cannot start matching or stop matching when an ancestor changes.
+    const CSSSelector* subjectId = 0;
+    const CSSSelector* subjectClass = 0;
+    const CSSSelector* subjectAttribute = 0;
+    const CSSSelector* subjectTag = 0;
+    const CSSSelector* component = selector;
+    for (; component; component = component->tagHistory()) {
+        if (component->m_match == CSSSelector::Id) {
+            if (!subjectId)
+                subjectId = component;
+        } else if (component->m_match == CSSSelector::Class) {
+            if (!subjectClass)
+                subjectClass = component;
+        } else if (component->isAttributeSelector()) {
+            if (!subjectAttribute)
+                subjectAttribute = component;
+        } else if (component->m_match == CSSSelector::Tag && component->tagQName().localName() != starAtom) {
+            if (!subjectTag)
+                subjectTag = component;
+        }
+        if (component->relation() != CSSSelector::SubSelector)
+            break;
+    }
+    // Features of a single compound selector only affect the element that has them.
+    if (!component || !component->tagHistory())
+        return;
+
+    DescendantInvalidationSet descendantFeatures;
+    if (subjectId)
+        descendantFeatures.addId(subjectId->value().impl());
+    else if (subjectClass)
+        descendantFeatures.addClass(subjectClass->value().impl());
+    else if (subjectAttribute)
+        descendantFeatures.addAttribute(subjectAttribute->attribute().localName().impl());
+    else if (subjectTag)
+        descendantFeatures.addTagName(subjectTag->tagQName().localName().impl());
+    else
+        descendantFeatures.setWholeSubtreeInvalid();
+
+    CSSSelector::Relation relation = component->relation();
+    for (component = component->tagHistory(); component; component = component->tagHistory()) {
+        if (relation == CSSSelector::DirectAdjacent || relation == CSSSelector::IndirectAdjacent)
+            descendantFeatures.setInvalidatesSiblings();
+        else if (relation == CSSSelector::ShadowDescendant)
+            descendantFeatures.setWholeSubtreeInvalid();
+        addInvalidationSetsForFeatures(*this, component, descendantFeatures);
+        relation = component->relation();
+    }
+}
+
 void RuleFeatureSet::collectFeaturesFromSelector(const CSSSelector* selector)
 {
     if (selector->m_match == CSSSelector::Id)
@@ -65,6 +207,9 @@ void RuleFeatureSet::add(const RuleFeatureSet& other)
     end = other.attrsInRules.end();
     for (HashSet<AtomicStringImpl*>::const_iterator it = other.attrsInRules.begin(); it != end; ++it)
         attrsInRules.add(*it);
+    addInvalidationSets(classInvalidationSets, other.classInvalidationSets);
+    addInvalidationSets(idInvalidationSets, other.idInvalidationSets);
+    addInvalidationSets(attributeInvalidationSets, other.attributeInvalidationSets);
     siblingRules.appendVector(other.siblingRules);
     uncommonAttributeRules.appendVector(other.uncommonAttributeRules);
     usesFirstLineRules = usesFirstLineRules || other.usesFirstLineRules;
@@ -76,6 +221,9 @@ void RuleFeatureSet::clear()
     idsInRules.clear();
     classesInRules.clear();
     attrsInRules.clear();
+    classInvalidationSets.clear();
+    idInvalidationSets.clear();
+    attributeInvalidationSets.clear();
     siblingRules.clear();
     uncommonAttributeRules.clear();
     usesFirstLineRules = false;
@@ -25,12 +25,14 @@
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/text/AtomicString.h>
 
 namespace WebCore {
 
-class StyleRule;
 class CSSSelector;
+class Element;
+class StyleRule;
 
 struct RuleFeature {
     RuleFeature(StyleRule* rule, unsigned selectorIndex, bool hasDocumentSecurityOrigin)
@@ -44,6 +46,43 @@ struct RuleFeature {
     bool hasDocumentSecurityOrigin;
 };
 
+// Describes which descendants of an element may change style when a given class, id or
+// attribute changes on it. A descendant can only be affected if it has one of the listed
+// features; when no such feature could be found the whole subtree has to be restyled.
+// A change that can also affect siblings invalidates the element the way it always did.
+class DescendantInvalidationSet {
+public:
+    DescendantInvalidationSet()
+        : m_wholeSubtreeInvalid(false)
+        , m_invalidatesSiblings(false)
+    { }
+
+    void combine(const DescendantInvalidationSet&);
+
+    void addClass(AtomicStringImpl* className) { m_classes.add(className); }
+    void addId(AtomicStringImpl* id) { m_ids.add(id); }
+    void addTagName(AtomicStringImpl* tagName) { m_tagNames.add(tagName); }
+    void addAttribute(AtomicStringImpl* attributeName) { m_attributes.add(attributeName); }
+
+    bool wholeSubtreeInvalid() const { return m_wholeSubtreeInvalid; }
+    void setWholeSubtreeInvalid() { m_wholeSubtreeInvalid = true; }
+    bool invalidatesSiblings() const { return m_invalidatesSiblings; }
+    void setInvalidatesSiblings() { m_invalidatesSiblings = true; }
+
+    bool isEmpty() const { return !m_wholeSubtreeInvalid && !m_invalidatesSiblings && m_classes.isEmpty() && m_ids.isEmpty() && m_tagNames.isEmpty() && m_attributes.isEmpty(); }
+    bool invalidatesElement(const Element*) const;
+
+private:
+    HashSet<AtomicStringImpl*> m_classes;
+    HashSet<AtomicStringImpl*> m_ids;
+    HashSet<AtomicStringImpl*> m_tagNames;
+    HashSet<AtomicStringImpl*> m_attributes;
+    bool m_wholeSubtreeInvalid;
+    bool m_invalidatesSiblings;
+};
+
+typedef HashMap<AtomicStringImpl*, OwnPtr<DescendantInvalidationSet> > InvalidationSetMap;
+
 struct RuleFeatureSet {
     RuleFeatureSet()
         : usesFirstLineRules(false)
@@ -54,10 +93,18 @@ struct RuleFeatureSet {
     void clear();
 
     void collectFeaturesFromSelector(const CSSSelector*);
+    void collectInvalidationSetsFromSelector(const CSSSelector*);
+
+    const DescendantInvalidationSet* classInvalidationSet(const AtomicString& className) const { return classInvalidationSets.get(className.impl()); }
+    const DescendantInvalidationSet* idInvalidationSet(const AtomicString& id) const { return idInvalidationSets.get(id.impl()); }
+    const DescendantInvalidationSet* attributeInvalidationSet(const AtomicString& attributeName) const { return attributeInvalidationSets.get(attributeName.impl()); }
 
     HashSet<AtomicStringImpl*> idsInRules;
     HashSet<AtomicStringImpl*> classesInRules;
     HashSet<AtomicStringImpl*> attrsInRules;
+    InvalidationSetMap classInvalidationSets;
+    InvalidationSetMap idInvalidationSets;
+    InvalidationSetMap attributeInvalidationSets;
     Vector<RuleFeature> siblingRules;
     Vector<RuleFeature> uncommonAttributeRules;
     bool usesFirstLineRules;
@@ -146,6 +146,24 @@ RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, A
     SelectorFilter::collectIdentifierHashes(selector(), m_descendantSelectorIdentifierHashes, maximumIdentifierCount);
 }
 
+RuleData::RuleData(const RuleData& compiledRuleData, unsigned position, bool hasDocumentSecurityOrigin)
+    : m_rule(compiledRuleData.m_rule)
+    , m_selectorIndex(compiledRuleData.m_selectorIndex)
+    , m_position(position)
+    , m_hasFastCheckableSelector(compiledRuleData.m_hasFastCheckableSelector)
+    , m_specificity(compiledRuleData.m_specificity)
+    , m_hasMultipartSelector(compiledRuleData.m_hasMultipartSelector)
+    , m_hasRightmostSelectorMatchingHTMLBasedOnRuleHash(compiledRuleData.m_hasRightmostSelectorMatchingHTMLBasedOnRuleHash)
+    , m_containsUncommonAttributeSelector(compiledRuleData.m_containsUncommonAttributeSelector)
+    , m_linkMatchType(compiledRuleData.m_linkMatchType)
+    , m_hasDocumentSecurityOrigin(hasDocumentSecurityOrigin)
+    , m_propertyWhitelistType(compiledRuleData.m_propertyWhitelistType)
+{
+    ASSERT(m_position == position);
+    for (unsigned i = 0; i < maximumIdentifierCount; ++i)
+        m_descendantSelectorIdentifierHashes[i] = compiledRuleData.m_descendantSelectorIdentifierHashes[i];
+}
+
 static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData& ruleData)
 {
     bool foundSiblingSelector = false;
@@ -161,6 +179,7 @@ static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData
         } else if (!foundSiblingSelector && selector->isSiblingSelector())
             foundSiblingSelector = true;
     }
+    features.collectInvalidationSetsFromSelector(ruleData.selector());
     if (foundSiblingSelector)
         features.siblingRules.append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
     if (ruleData.containsUncommonAttributeSelector())
@@ -177,7 +196,7 @@ void RuleSet::addToRuleSet(AtomicStringImpl* key, AtomRuleMap& map, const RuleDa
     rules->append(ruleData);
 }
 
-bool RuleSet::findBestRuleSetAndAdd(const CSSSelector* component, RuleData& ruleData)
+bool RuleSet::findBestRuleSetAndAdd(const CSSSelector* component, const RuleData& ruleData)
 {
     if (component->m_match == CSSSelector::Id) {
         addToRuleSet(component->value().impl(), m_idRules, ruleData);
@@ -232,7 +251,11 @@ bool RuleSet::findBestRuleSetAndAdd(const CSSSelector* component, RuleData& rule
 
 void RuleSet::addRule(StyleRule* rule, unsigned selectorIndex, AddRuleFlags addRuleFlags)
 {
-    RuleData ruleData(rule, selectorIndex, m_ruleCount++, addRuleFlags);
+    addRuleData(RuleData(rule, selectorIndex, m_ruleCount++, addRuleFlags));
+}
+
+void RuleSet::addRuleData(const RuleData& ruleData)
+{
     collectFeaturesFromRuleData(m_features, ruleData);
 
     if (!findBestRuleSetAndAdd(ruleData.selector(), ruleData)) {
@@ -270,20 +293,84 @@ void RuleSet::addRegionRule(StyleRuleRegion* regionRule, bool hasDocumentSecurit
     m_regionSelectorsAndRuleSets.append(RuleSetSelectorPair(regionRule->selectorList().first(), regionRuleSet.release()));
 }
 
-void RuleSet::addChildRules(const Vector<RefPtr<StyleRuleBase> >& rules, const MediaQueryEvaluator& medium, StyleResolver* resolver, const ContainerNode* scope, bool hasDocumentSecurityOrigin, AddRuleFlags addRuleFlags)
+// Compiled rule data holds one RuleData per selector of every style rule in the sheet, in
+// document order and including the rules inside conditional group rules. Rules inside
+// @-webkit-region are analyzed with different flags and are not compiled.
+static void compileChildRules(const Vector<RefPtr<StyleRuleBase> >& rules, Vector<RuleData>& compiledRuleData)
 {
     for (unsigned i = 0; i < rules.size(); ++i) {
         StyleRuleBase* rule = rules[i].get();
+        if (rule->isStyleRule()) {
+            StyleRule* styleRule = static_cast<StyleRule*>(rule);
+            for (size_t selectorIndex = 0; selectorIndex != notFound; selectorIndex = styleRule->selectorList().indexOfNextSelectorAfter(selectorIndex))
+                compiledRuleData.append(RuleData(styleRule, selectorIndex, 0, RuleCanUseFastCheckSelector));
+        } else if (rule->isMediaRule())
+            compileChildRules(static_cast<StyleRuleMedia*>(rule)->childRules(), compiledRuleData);
+#if ENABLE(CSS3_CONDITIONAL_RULES)
+        else if (rule->isSupportsRule())
+            compileChildRules(static_cast<StyleRuleSupports*>(rule)->childRules(), compiledRuleData);
+#endif
+    }
+}
 
+static unsigned compiledRuleDataCount(const Vector<RefPtr<StyleRuleBase> >& rules)
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < rules.size(); ++i) {
+        StyleRuleBase* rule = rules[i].get();
         if (rule->isStyleRule()) {
             StyleRule* styleRule = static_cast<StyleRule*>(rule);
-            addStyleRule(styleRule, addRuleFlags);
+            for (size_t selectorIndex = 0; selectorIndex != notFound; selectorIndex = styleRule->selectorList().indexOfNextSelectorAfter(selectorIndex))
+                ++count;
+        } else if (rule->isMediaRule())
+            count += compiledRuleDataCount(static_cast<StyleRuleMedia*>(rule)->childRules());
+#if ENABLE(CSS3_CONDITIONAL_RULES)
+        else if (rule->isSupportsRule())
+            count += compiledRuleDataCount(static_cast<StyleRuleSupports*>(rule)->childRules());
+#endif
+    }
+    return count;
+}
+
+static const Vector<RuleData>& ensureCompiledRuleData(StyleSheetContents* sheet)
+{
+    if (!sheet->compiledRuleData()) {
+        OwnPtr<Vector<RuleData> > compiledRuleData = adoptPtr(new Vector<RuleData>);
+        compileChildRules(sheet->childRules(), *compiledRuleData);
+        compiledRuleData->shrinkToFit();
+        sheet->setCompiledRuleData(compiledRuleData.release());
+    }
+    return *sheet->compiledRuleData();
+}
+
+void RuleSet::addCompiledStyleRule(StyleRule* rule, bool hasDocumentSecurityOrigin, CompiledRuleDataIterator& compiledRuleData)
+{
+    for (size_t selectorIndex = 0; selectorIndex != notFound; selectorIndex = rule->selectorList().indexOfNextSelectorAfter(selectorIndex)) {
+        ASSERT(compiledRuleData->rule() == rule);
+        ASSERT(compiledRuleData->selectorIndex() == selectorIndex);
+        addRuleData(RuleData(*compiledRuleData++, m_ruleCount++, hasDocumentSecurityOrigin));
+    }
+}
+
+void RuleSet::addChildRules(const Vector<RefPtr<StyleRuleBase> >& rules, const MediaQueryEvaluator& medium, StyleResolver* resolver, const ContainerNode* scope, bool hasDocumentSecurityOrigin, AddRuleFlags addRuleFlags, CompiledRuleDataIterator* compiledRuleData)
+{
+    for (unsigned i = 0; i < rules.size(); ++i) {
+        StyleRuleBase* rule = rules[i].get();
+
+        if (rule->isStyleRule()) {
+            StyleRule* styleRule = static_cast<StyleRule*>(rule);
+            if (compiledRuleData)
+                addCompiledStyleRule(styleRule, hasDocumentSecurityOrigin, *compiledRuleData);
+            else
+                addStyleRule(styleRule, addRuleFlags);
         } else if (rule->isPageRule())
             addPageRule(static_cast<StyleRulePage*>(rule));
         else if (rule->isMediaRule()) {
             StyleRuleMedia* mediaRule = static_cast<StyleRuleMedia*>(rule);
             if ((!mediaRule->mediaQueries() || medium.eval(mediaRule->mediaQueries(), resolver)))
-                addChildRules(mediaRule->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags);
+                addChildRules(mediaRule->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags, compiledRuleData);
+            else if (compiledRuleData)
+                *compiledRuleData += compiledRuleDataCount(mediaRule->childRules());
         } else if (rule->isFontFaceRule() && resolver) {
             // Add this font face to our set.
             // FIXME(BUG 72461): We don't add @font-face rules of scoped style sheets for the moment.
@@ -319,8 +406,13 @@ void RuleSet::addChildRules(const Vector<RefPtr<StyleRuleBase> >& rules, const M
         }
 #endif
 #if ENABLE(CSS3_CONDITIONAL_RULES)
-        else if (rule->isSupportsRule() && static_cast<StyleRuleSupports*>(rule)->conditionIsSupported())
-            addChildRules(static_cast<StyleRuleSupports*>(rule)->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags);
+        else if (rule->isSupportsRule()) {
+            StyleRuleSupports* supportsRule = static_cast<StyleRuleSupports*>(rule);
+            if (supportsRule->conditionIsSupported())
+                addChildRules(supportsRule->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags, compiledRuleData);
+            else if (compiledRuleData)
+                *compiledRuleData += compiledRuleDataCount(supportsRule->childRules());
+        }
 #endif
     }
 }
@@ -339,7 +431,15 @@ void RuleSet::addRulesFromSheet(StyleSheetContents* sheet, const MediaQueryEvalu
     bool hasDocumentSecurityOrigin = resolver && resolver->document().securityOrigin()->canRequest(sheet->baseURL());
     AddRuleFlags addRuleFlags = static_cast<AddRuleFlags>((hasDocumentSecurityOrigin ? RuleHasDocumentSecurityOrigin : 0) | (!scope ? RuleCanUseFastCheckSelector : 0));
 
-    addChildRules(sheet->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags);
+    // Sheets held by a cache are likely to be added to other documents too, so analyze their
+    // selectors once. Scoped sheets can't use the fast path and are analyzed each time.
+    if (!scope && sheet->isInMemoryCache()) {
+        const Vector<RuleData>& compiledRuleData = ensureCompiledRuleData(sheet);
+        CompiledRuleDataIterator iterator = compiledRuleData.begin();
+        addChildRules(sheet->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags, &iterator);
+        ASSERT(iterator == compiledRuleData.end());
+    } else
+        addChildRules(sheet->childRules(), medium, resolver, scope, hasDocumentSecurityOrigin, addRuleFlags, 0);
 
     if (m_autoShrinkToFitEnabled)
         shrinkToFit();
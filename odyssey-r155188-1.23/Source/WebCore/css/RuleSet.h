@@ -58,6 +58,8 @@ public:
     static const unsigned maximumSelectorComponentCount = 8192;
 
     RuleData(StyleRule*, unsigned selectorIndex, unsigned position, AddRuleFlags);
+    // Reuses the selector analysis of a RuleData compiled for a shared style sheet.
+    RuleData(const RuleData& compiledRuleData, unsigned position, bool hasDocumentSecurityOrigin);
 
     unsigned position() const { return m_position; }
     StyleRule* rule() const { return m_rule; }
@@ -146,8 +148,12 @@ public:
     unsigned ruleCount() const { return m_ruleCount; }
 
 private:
-    void addChildRules(const Vector<RefPtr<StyleRuleBase> >&, const MediaQueryEvaluator& medium, StyleResolver*, const ContainerNode* scope, bool hasDocumentSecurityOrigin, AddRuleFlags);
-    bool findBestRuleSetAndAdd(const CSSSelector*, RuleData&);
+    typedef const RuleData* CompiledRuleDataIterator;
+
+    void addChildRules(const Vector<RefPtr<StyleRuleBase> >&, const MediaQueryEvaluator& medium, StyleResolver*, const ContainerNode* scope, bool hasDocumentSecurityOrigin, AddRuleFlags, CompiledRuleDataIterator*);
+    void addCompiledStyleRule(StyleRule*, bool hasDocumentSecurityOrigin, CompiledRuleDataIterator&);
+    void addRuleData(const RuleData&);
+    bool findBestRuleSetAndAdd(const CSSSelector*, const RuleData&);
 
     RuleSet();
 
@@ -369,6 +369,17 @@ static bool anyAttributeMatches(Element* element, const CSSSelector* selector, c
     return false;
 }
 
+bool SelectorChecker::attributeSelectorMatches(Element* element, const CSSSelector* selector, bool documentIsHTML)
+{
+    ASSERT(selector->isAttributeSelector());
+    if (!element->hasAttributes())
+        return false;
+
+    const QualifiedName& attr = selector->attribute();
+    bool caseSensitive = !documentIsHTML || HTMLDocument::isCaseSensitiveAttribute(attr);
+    return anyAttributeMatches(element, selector, attr, caseSensitive);
+}
+
 bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
 {
     Element* const & element = context.element;
@@ -386,13 +397,7 @@ bool SelectorChecker::checkOne(const SelectorCheckingContext& context) const
         return element->hasID() && element->idForStyleResolution() == selector->value();
 
     if (selector->isAttributeSelector()) {
-        if (!element->hasAttributes())
-            return false;
-
-        const QualifiedName& attr = selector->attribute();
-        bool caseSensitive = !m_documentIsHTML || HTMLDocument::isCaseSensitiveAttribute(attr);
-
-        if (!anyAttributeMatches(element, selector, attr, caseSensitive))
+        if (!attributeSelectorMatches(element, selector, m_documentIsHTML))
             return false;
     }
 
@@ -31,6 +31,7 @@
 #include "CSSStyleRule.h"
 #include "CSSSupportsRule.h"
 #include "CSSUnknownRule.h"
+#include "CompiledSelector.h"
 #include "StylePropertySet.h"
 #include "StyleRuleImport.h"
 #include "WebKitCSSFilterRule.h"
@@ -38,6 +39,7 @@
 #include "WebKitCSSKeyframesRule.h"
 #include "WebKitCSSRegionRule.h"
 #include "WebKitCSSViewportRule.h"
+#include <limits>
 
 namespace WebCore {
 
@@ -232,9 +234,14 @@ unsigned StyleRule::averageSizeInBytes()
     return sizeof(StyleRule) + sizeof(CSSSelector) + StylePropertySet::averageSizeInBytes();
 }
 
+// Selectors are only compiled for rules that get past the rule hash and the selector filter this often.
+static const unsigned interpretedMatchesBeforeSelectorCompilation = 16;
+static const unsigned selectorCompilationFailed = std::numeric_limits<unsigned>::max();
+
 StyleRule::StyleRule(int sourceLine, PassRefPtr<StylePropertySet> properties)
     : StyleRuleBase(Style, sourceLine)
     , m_properties(properties)
+    , m_interpretedMatchCount(0)
 {
 }
 
@@ -242,6 +249,7 @@ StyleRule::StyleRule(const StyleRule& o)
     : StyleRuleBase(o)
     , m_properties(o.m_properties->mutableCopy())
     , m_selectorList(o.m_selectorList)
+    , m_interpretedMatchCount(0)
 {
 }
 
@@ -249,6 +257,44 @@ StyleRule::~StyleRule()
 {
 }
 
+const CompiledSelector* StyleRule::compiledSelector(unsigned selectorIndex) const
+{
+    if (!m_compiledSelectors) {
+        if (m_interpretedMatchCount == selectorCompilationFailed || ++m_interpretedMatchCount < interpretedMatchesBeforeSelectorCompilation)
+            return 0;
+        compileSelectors();
+        if (!m_compiledSelectors)
+            return 0;
+    }
+    ASSERT(selectorIndex < m_compiledSelectors->size());
+    return m_compiledSelectors->at(selectorIndex).get();
+}
+
+void StyleRule::compileSelectors() const
+{
+    ASSERT(!m_compiledSelectors);
+    OwnPtr<Vector<OwnPtr<CompiledSelector> > > compiledSelectors = adoptPtr(new Vector<OwnPtr<CompiledSelector> >(m_selectorList.componentCount()));
+    bool hasCompiledSelector = false;
+    for (const CSSSelector* selector = m_selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+        OwnPtr<CompiledSelector> compiledSelector = CompiledSelector::compile(selector);
+        if (!compiledSelector)
+            continue;
+        compiledSelectors->at(selector - m_selectorList.first()) = compiledSelector.release();
+        hasCompiledSelector = true;
+    }
+    if (!hasCompiledSelector) {
+        m_interpretedMatchCount = selectorCompilationFailed;
+        return;
+    }
+    m_compiledSelectors = compiledSelectors.release();
+}
+
+void StyleRule::clearCompiledSelectors()
+{
+    m_compiledSelectors.clear();
+    m_interpretedMatchCount = 0;
+}
+
 MutableStylePropertySet* StyleRule::mutableProperties()
 {
     if (!m_properties->isMutable())
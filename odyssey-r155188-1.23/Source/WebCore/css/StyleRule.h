@@ -31,6 +31,7 @@ namespace WebCore {
 
 class CSSRule;
 class CSSStyleRule;
+class CompiledSelector;
 class CSSStyleSheet;
 class MutableStylePropertySet;
 class StylePropertySet;
@@ -130,13 +131,17 @@ public:
     MutableStylePropertySet* mutableProperties();
     
     void parserAdoptSelectorVector(Vector<OwnPtr<CSSParserSelector> >& selectors) { m_selectorList.adoptSelectorVector(selectors); }
-    void wrapperAdoptSelectorList(CSSSelectorList& selectors) { m_selectorList.adopt(selectors); }
+    void wrapperAdoptSelectorList(CSSSelectorList& selectors) { m_selectorList.adopt(selectors); clearCompiledSelectors(); }
     void parserAdoptSelectorArray(CSSSelector* selectors) { m_selectorList.adoptSelectorArray(selectors); }
 
     PassRefPtr<StyleRule> copy() const { return adoptRef(new StyleRule(*this)); }
 
     Vector<RefPtr<StyleRule> > splitIntoMultipleRulesWithMaximumSelectorComponentCount(unsigned) const;
 
+    // Returns the compiled form of the selector at selectorIndex once the rule has been matched often
+    // enough with SelectorChecker to be worth compiling, or 0 if it is not hot yet or cannot be compiled.
+    const CompiledSelector* compiledSelector(unsigned selectorIndex) const;
+
     static unsigned averageSizeInBytes();
 
 private:
@@ -145,8 +150,14 @@ private:
 
     static PassRefPtr<StyleRule> create(int sourceLine, const Vector<const CSSSelector*>&, PassRefPtr<StylePropertySet>);
 
+    void compileSelectors() const;
+    void clearCompiledSelectors();
+
     RefPtr<StylePropertySet> m_properties;
     CSSSelectorList m_selectorList;
+    // Indexed like the components of m_selectorList.
+    mutable OwnPtr<Vector<OwnPtr<CompiledSelector> > > m_compiledSelectors;
+    mutable unsigned m_interpretedMatchCount;
 };
 
 inline const StyleRule* toStyleRule(const StyleRuleBase* rule)
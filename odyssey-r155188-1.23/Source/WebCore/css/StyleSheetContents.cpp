@@ -65,7 +65,7 @@ StyleSheetContents::StyleSheetContents(StyleRuleImport* ownerRule, const String&
     , m_didLoadErrorOccur(false)
     , m_usesRemUnits(false)
     , m_isMutable(false)
-    , m_isInMemoryCache(false)
+    , m_memoryCacheCount(0)
     , m_parserContext(context)
 {
 }
@@ -84,7 +84,7 @@ StyleSheetContents::StyleSheetContents(const StyleSheetContents& o)
     , m_didLoadErrorOccur(false)
     , m_usesRemUnits(o.m_usesRemUnits)
     , m_isMutable(false)
-    , m_isInMemoryCache(false)
+    , m_memoryCacheCount(0)
     , m_parserContext(o.m_parserContext)
 {
     ASSERT(o.isCacheable());
@@ -192,6 +192,7 @@ void StyleSheetContents::clearRules()
     }
     m_importRules.clear();
     m_childRules.clear();
+    m_compiledRuleData.clear();
     clearCharsetRule();
 }
 
@@ -283,14 +284,23 @@ const AtomicString& StyleSheetContents::determineNamespace(const AtomicString& p
     return it->value;
 }
 
-void StyleSheetContents::parseAuthorStyleSheet(const CachedCSSStyleSheet* cachedStyleSheet, const SecurityOrigin* securityOrigin)
+String StyleSheetContents::authorStyleSheetText(const CachedCSSStyleSheet* cachedStyleSheet, const CSSParserContext& context, bool* hasValidMIMEType)
 {
     // Check to see if we should enforce the MIME type of the CSS resource in strict mode.
     // Running in iWeb 2 is one example of where we don't want to - <rdar://problem/6099748>
-    bool enforceMIMEType = isStrictParserMode(m_parserContext.mode) && m_parserContext.enforcesCSSMIMETypeInNoQuirksMode;
+    bool enforceMIMEType = isStrictParserMode(context.mode) && context.enforcesCSSMIMETypeInNoQuirksMode;
+    return cachedStyleSheet->sheetText(enforceMIMEType, hasValidMIMEType);
+}
+
+void StyleSheetContents::parseAuthorStyleSheet(const CachedCSSStyleSheet* cachedStyleSheet, const SecurityOrigin* securityOrigin)
+{
     bool hasValidMIMEType = false;
-    String sheetText = cachedStyleSheet->sheetText(enforceMIMEType, &hasValidMIMEType);
+    String sheetText = authorStyleSheetText(cachedStyleSheet, m_parserContext, &hasValidMIMEType);
+    parseAuthorStyleSheet(sheetText, hasValidMIMEType, securityOrigin);
+}
 
+void StyleSheetContents::parseAuthorStyleSheet(const String& sheetText, bool hasValidMIMEType, const SecurityOrigin* securityOrigin)
+{
     CSSParser p(parserContext());
     p.parseSheet(this, sheetText, 0, 0, true);
 
@@ -500,18 +510,29 @@ void StyleSheetContents::unregisterClient(CSSStyleSheet* sheet)
     m_clients.remove(position);
 }
 
+void StyleSheetContents::setMutable()
+{
+    m_isMutable = true;
+    m_compiledRuleData.clear();
+}
+
 void StyleSheetContents::addedToMemoryCache()
 {
-    ASSERT(!m_isInMemoryCache);
     ASSERT(isCacheable());
-    m_isInMemoryCache = true;
+    ++m_memoryCacheCount;
 }
 
 void StyleSheetContents::removedFromMemoryCache()
 {
-    ASSERT(m_isInMemoryCache);
+    ASSERT(m_memoryCacheCount);
+    ASSERT(isCacheable());
+    --m_memoryCacheCount;
+}
+
+void StyleSheetContents::setCompiledRuleData(PassOwnPtr<Vector<RuleData> > compiledRuleData)
+{
     ASSERT(isCacheable());
-    m_isInMemoryCache = false;
+    m_compiledRuleData = compiledRuleData;
 }
 
 void StyleSheetContents::shrinkToFit()
@@ -25,6 +25,7 @@
 #include "KURL.h"
 #include <wtf/HashMap.h>
 #include <wtf/ListHashSet.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/RefCounted.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicStringHash.h>
@@ -35,6 +36,7 @@ class CSSStyleSheet;
 class CachedCSSStyleSheet;
 class Document;
 class Node;
+class RuleData;
 class SecurityOrigin;
 class StyleRuleBase;
 class StyleRuleImport;
@@ -61,6 +63,8 @@ public:
     const AtomicString& determineNamespace(const AtomicString& prefix);
 
     void parseAuthorStyleSheet(const CachedCSSStyleSheet*, const SecurityOrigin*);
+    void parseAuthorStyleSheet(const String& sheetText, bool hasValidMIMEType, const SecurityOrigin*);
+    static String authorStyleSheetText(const CachedCSSStyleSheet*, const CSSParserContext&, bool* hasValidMIMEType);
     bool parseString(const String&);
     bool parseStringAtLine(const String&, int startLineNumber, bool);
 
@@ -130,12 +134,18 @@ public:
     bool hasOneClient() { return m_clients.size() == 1; }
 
     bool isMutable() const { return m_isMutable; }
-    void setMutable() { m_isMutable = true; }
+    void setMutable();
 
-    bool isInMemoryCache() const { return m_isInMemoryCache; }
+    // A sheet may be held by both its CachedCSSStyleSheet and the StyleSheetContentsCache.
+    bool isInMemoryCache() const { return m_memoryCacheCount; }
     void addedToMemoryCache();
     void removedFromMemoryCache();
 
+    // Selector analysis for the style rules of a shared sheet, computed once by RuleSet and
+    // reused by every document that adds the sheet. Dropped as soon as the sheet is mutated.
+    const Vector<RuleData>* compiledRuleData() const { return m_compiledRuleData.get(); }
+    void setCompiledRuleData(PassOwnPtr<Vector<RuleData> >);
+
     void shrinkToFit();
 
 private:
@@ -160,10 +170,12 @@ private:
     bool m_didLoadErrorOccur : 1;
     bool m_usesRemUnits : 1;
     bool m_isMutable : 1;
-    bool m_isInMemoryCache : 1;
+    unsigned m_memoryCacheCount;
     
     CSSParserContext m_parserContext;
 
+    OwnPtr<Vector<RuleData> > m_compiledRuleData;
+
     Vector<CSSStyleSheet*> m_clients;
 };
 
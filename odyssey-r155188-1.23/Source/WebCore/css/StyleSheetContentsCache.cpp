@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "StyleSheetContentsCache.h"
+
+#include "CSSParserMode.h"
+#include "Document.h"
+#include "DocumentStyleSheetCollection.h"
+#include "StyleSheetContents.h"
+#include <wtf/HexNumber.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace WebCore {
+
+// Hashing costs far less than parsing, but tiny sheets are cheap to parse and would only churn the cache.
+static const unsigned minimumSheetLength = 512;
+static const unsigned capacity = 4 * 1024 * 1024;
+
+StyleSheetContentsCache& styleSheetContentsCache()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(StyleSheetContentsCache, cache, ());
+    return cache;
+}
+
+StyleSheetContentsCache::StyleSheetContentsCache()
+    : m_size(0)
+    , m_accessCounter(0)
+{
+}
+
+String StyleSheetContentsCache::keyFor(const String& originalURL, const String& sheetText, int startLineNumber)
+{
+    SHA1 sha1;
+    if (sheetText.is8Bit())
+        sha1.addBytes(sheetText.characters8(), sheetText.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(sheetText.characters16()), sheetText.length() * sizeof(UChar));
+    Vector<uint8_t, 20> digest;
+    sha1.computeHash(digest);
+
+    StringBuilder key;
+    for (size_t i = 0; i < digest.size(); ++i)
+        appendByteAsHex(digest[i], key);
+    key.append(' ');
+    key.appendNumber(sheetText.length());
+    key.append(' ');
+    key.appendNumber(startLineNumber);
+    key.append(' ');
+    key.append(originalURL);
+    return key.toString();
+}
+
+PassRefPtr<StyleSheetContents> StyleSheetContentsCache::find(const String& originalURL, const String& sheetText, int startLineNumber, const CSSParserContext& context, Document& document)
+{
+    if (sheetText.length() < minimumSheetLength || m_entries.isEmpty())
+        return 0;
+
+    EntryMap::iterator it = m_entries.find(keyFor(originalURL, sheetText, startLineNumber));
+    if (it == m_entries.end())
+        return 0;
+
+    Entry& entry = it->value;
+    ASSERT(entry.contents->isCacheable());
+    // Contexts must be identical so we know we would get the same exact result if we parsed again.
+    if (entry.contents->parserContext() != context)
+        return 0;
+    if (entry.contents->hasFailedOrCanceledSubresources()) {
+        remove(it);
+        return 0;
+    }
+
+    entry.lastAccess = ++m_accessCounter;
+    m_statistics.add(entry.size, entry.parseTime);
+    document.styleSheetCollection()->didReuseParsedStyleSheet(entry.size, entry.parseTime);
+    return entry.contents;
+}
+
+void StyleSheetContentsCache::add(const String& sheetText, int startLineNumber, PassRefPtr<StyleSheetContents> prpContents, double parseTime)
+{
+    RefPtr<StyleSheetContents> contents = prpContents;
+    if (sheetText.length() < minimumSheetLength || !contents->isCacheable())
+        return;
+
+    unsigned size = contents->estimatedSizeInBytes();
+    if (size > capacity / 2)
+        return;
+
+    String key = keyFor(contents->originalURL(), sheetText, startLineNumber);
+    EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end())
+        remove(it);
+
+    pruneToSize(capacity - size);
+
+    Entry entry;
+    entry.contents = contents;
+    entry.parseTime = parseTime;
+    entry.lastAccess = ++m_accessCounter;
+    entry.size = size;
+    contents->addedToMemoryCache();
+    m_entries.add(key, entry);
+    m_size += size;
+}
+
+void StyleSheetContentsCache::remove(EntryMap::iterator it)
+{
+    ASSERT(m_size >= it->value.size);
+    m_size -= it->value.size;
+    it->value.contents->removedFromMemoryCache();
+    m_entries.remove(it);
+}
+
+void StyleSheetContentsCache::pruneToSize(unsigned targetSize)
+{
+    // There are only ever a few dozen entries, so a linear search for the least recently used one is fine.
+    while (m_size > targetSize && !m_entries.isEmpty()) {
+        EntryMap::iterator oldest = m_entries.begin();
+        EntryMap::iterator end = m_entries.end();
+        for (EntryMap::iterator it = oldest; it != end; ++it) {
+            if (it->value.lastAccess < oldest->value.lastAccess)
+                oldest = it;
+        }
+        remove(oldest);
+    }
+}
+
+void StyleSheetContentsCache::clear()
+{
+    pruneToSize(0);
+    ASSERT(m_entries.isEmpty());
+    ASSERT(!m_size);
+}
+
+} // namespace WebCore
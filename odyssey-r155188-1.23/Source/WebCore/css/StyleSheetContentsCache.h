@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef StyleSheetContentsCache_h
+#define StyleSheetContentsCache_h
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class Document;
+class StyleSheetContents;
+struct CSSParserContext;
+
+// Work saved by reusing parsed style sheets instead of parsing them again.
+struct SharedStyleSheetStatistics {
+    SharedStyleSheetStatistics()
+        : sheets(0)
+        , bytes(0)
+        , parseTime(0)
+    {
+    }
+
+    void add(unsigned sizeInBytes, double parseTimeInSeconds)
+    {
+        ++sheets;
+        bytes += sizeInBytes;
+        parseTime += parseTimeInSeconds;
+    }
+
+    unsigned sheets;
+    size_t bytes;
+    double parseTime;
+};
+
+// Process-wide cache of parsed, unmodified style sheets keyed by a hash of their text and by
+// everything that can change the parse result. This lets documents share a sheet even when
+// the CachedCSSStyleSheet that parsed it first is gone, and lets identical inline <style>
+// sheets be shared at all. Shared contents are copied on write by CSSStyleSheet.
+class StyleSheetContentsCache {
+    WTF_MAKE_NONCOPYABLE(StyleSheetContentsCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    friend StyleSheetContentsCache& styleSheetContentsCache();
+
+    // Returns a parsed sheet for the text and context, and records the saving on the document.
+    PassRefPtr<StyleSheetContents> find(const String& originalURL, const String& sheetText, int startLineNumber, const CSSParserContext&, Document&);
+
+    // Only cacheable sheets are kept, and only sheets large enough to be worth hashing.
+    void add(const String& sheetText, int startLineNumber, PassRefPtr<StyleSheetContents>, double parseTime);
+
+    void clear();
+
+    const SharedStyleSheetStatistics& statistics() const { return m_statistics; }
+
+private:
+    StyleSheetContentsCache();
+
+    struct Entry {
+        RefPtr<StyleSheetContents> contents;
+        double parseTime;
+        unsigned lastAccess;
+        unsigned size;
+    };
+    typedef HashMap<String, Entry> EntryMap;
+
+    static String keyFor(const String& originalURL, const String& sheetText, int startLineNumber);
+    void remove(EntryMap::iterator);
+    void pruneToSize(unsigned targetSize);
+
+    EntryMap m_entries;
+    unsigned m_size;
+    unsigned m_accessCounter;
+    SharedStyleSheetStatistics m_statistics;
+};
+
+StyleSheetContentsCache& styleSheetContentsCache();
+
+} // namespace WebCore
+
+#endif // StyleSheetContentsCache_h
@@ -420,6 +420,7 @@ Document::Document(Frame* frame, const KURL& url, unsigned documentClasses)
     , m_pendingStyleRecalcShouldForce(false)
     , m_inStyleRecalc(false)
     , m_closeAfterStyleRecalc(false)
+    , m_styleRecalcElementCount(0)
     , m_gotoAnchorNeededAfterStylesheetsLoad(false)
     , m_frameElementsShouldIgnoreScrolling(false)
     , m_containsValidityStyleRules(false)
@@ -432,6 +433,7 @@ Document::Document(Frame* frame, const KURL& url, unsigned documentClasses)
     , m_processingLoadEvent(false)
     , m_loadEventFinished(false)
     , m_startTime(monotonicallyIncreasingTimeMS())
+    , m_parserMainThreadTime(0)
     , m_overMinimumLayoutThreshold(false)
     , m_scriptRunner(ScriptRunner::create(this))
     , m_xmlVersion(ASCIILiteral("1.0"))
@@ -645,6 +647,10 @@ void Document::dispose()
     m_registry.clear();
 #endif
 
+    // Cached querySelectorAll() results point to our children.
+    if (m_selectorQueryCache)
+        m_selectorQueryCache->invalidate();
+
     // removeDetachedChildren() doesn't always unregister IDs,
     // so tear down scope information upfront to avoid having stale references in the map.
     destroyTreeScopeData();
@@ -2391,6 +2397,12 @@ void Document::implicitClose()
     // onLoad event handler, as in Radar 3206524.
     detachParser();
 
+#if !LOG_DISABLED
+    const SharedStyleSheetStatistics& reusedSheets = m_styleSheetCollection->reusedParsedStyleSheets();
+    if (reusedSheets.sheets)
+        LOG(Loading, "Document %p reused %u parsed style sheets (%lu bytes, %.1fms of parsing avoided)", this, reusedSheets.sheets, static_cast<unsigned long>(reusedSheets.bytes), reusedSheets.parseTime * 1000);
+#endif
+
     // FIXME: We kick off the icon loader when the Document is done parsing.
     // There are earlier opportunities we could start it:
     //  -When the <head> finishes parsing
@@ -639,6 +639,10 @@ public:
     bool shouldScheduleLayout();
     bool isLayoutTimerActive();
     int elapsedTime() const;
+
+    // How long the HTML parser kept the main thread busy with this document, in seconds.
+    void addParserMainThreadTime(double time) { m_parserMainThreadTime += time; }
+    double parserMainThreadTime() const { return m_parserMainThreadTime; }
     
     void setTextColor(const Color& color) { m_textColor = color; }
     Color textColor() const { return m_textColor; }
@@ -1156,6 +1160,11 @@ public:
 
     bool inStyleRecalc() { return m_inStyleRecalc; }
 
+    // Number of elements whose style has been resolved in this document, for measuring how much
+    // work style invalidation causes.
+    unsigned styleRecalcElementCount() const { return m_styleRecalcElementCount; }
+    void didResolveElementStyle() { ++m_styleRecalcElementCount; }
+
     // Return a Locale for the default locale if the argument is null or empty.
     Locale& getCachedLocale(const AtomicString& locale = nullAtom);
 
@@ -1356,6 +1365,7 @@ private:
     bool m_pendingStyleRecalcShouldForce;
     bool m_inStyleRecalc;
     bool m_closeAfterStyleRecalc;
+    unsigned m_styleRecalcElementCount;
 
     bool m_gotoAnchorNeededAfterStylesheetsLoad;
     bool m_isDNSPrefetchEnabled;
@@ -1390,6 +1400,7 @@ private:
 
     RefPtr<SerializedScriptValue> m_pendingStateObject;
     double m_startTime;
+    double m_parserMainThreadTime;
     bool m_overMinimumLayoutThreshold;
     
     OwnPtr<ScriptRunner> m_scriptRunner;
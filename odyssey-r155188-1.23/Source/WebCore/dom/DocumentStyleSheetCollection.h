@@ -28,6 +28,7 @@
 #ifndef DocumentStyleSheetCollection_h
 #define DocumentStyleSheetCollection_h
 
+#include "StyleSheetContentsCache.h"
 #include <wtf/FastAllocBase.h>
 #include <wtf/ListHashSet.h>
 #include <wtf/RefPtr.h>
@@ -117,6 +118,10 @@ public:
 
     bool activeStyleSheetsContains(const CSSStyleSheet*) const;
 
+    // Parsed style sheets this document got from the StyleSheetContentsCache instead of parsing them.
+    void didReuseParsedStyleSheet(unsigned sizeInBytes, double parseTime) { m_reusedParsedStyleSheets.add(sizeInBytes, parseTime); }
+    const SharedStyleSheetStatistics& reusedParsedStyleSheets() const { return m_reusedParsedStyleSheets; }
+
 private:
     DocumentStyleSheetCollection(Document*);
 
@@ -167,6 +172,8 @@ private:
     bool m_usesBeforeAfterRules;
     bool m_usesBeforeAfterRulesOverride;
     bool m_usesRemUnits;
+
+    SharedStyleSheetStatistics m_reusedParsedStyleSheets;
 };
 
 }
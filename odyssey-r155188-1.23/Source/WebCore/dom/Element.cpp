@@ -993,14 +993,82 @@ static inline AtomicString makeIdForStyleResolution(const AtomicString& value, b
     return value;
 }
 
-static bool checkNeedsStyleInvalidationForIdChange(const AtomicString& oldId, const AtomicString& newId, StyleResolver* styleResolver)
+// Works out which elements may change style when classes, ids or attributes change on an element,
+// from the features and descendant invalidation sets of the active style sheets. Only those elements
+// are marked for style recalc, instead of forcing a recalc of the whole subtree.
+class FeatureChangeStyleInvalidation {
+public:
+    explicit FeatureChangeStyleInvalidation(const StyleResolver& styleResolver)
+        : m_features(styleResolver.ruleSets().features())
+        , m_invalidatesElement(false)
+    {
+    }
+
+    void classChanged(const AtomicString& className)
+    {
+        if (m_features.classesInRules.contains(className.impl()))
+            m_invalidatesElement = true;
+        if (const DescendantInvalidationSet* invalidationSet = m_features.classInvalidationSet(className))
+            m_descendantInvalidation.combine(*invalidationSet);
+    }
+
+    void idChanged(const AtomicString& id)
+    {
+        if (m_features.idsInRules.contains(id.impl()))
+            m_invalidatesElement = true;
+        if (const DescendantInvalidationSet* invalidationSet = m_features.idInvalidationSet(id))
+            m_descendantInvalidation.combine(*invalidationSet);
+    }
+
+    void attributeChanged(const AtomicString& attributeName)
+    {
+        if (m_features.attrsInRules.contains(attributeName.impl()))
+            m_invalidatesElement = true;
+        if (const DescendantInvalidationSet* invalidationSet = m_features.attributeInvalidationSet(attributeName))
+            m_descendantInvalidation.combine(*invalidationSet);
+    }
+
+    void invalidateStyle(Element&) const;
+
+private:
+    const RuleFeatureSet& m_features;
+    DescendantInvalidationSet m_descendantInvalidation;
+    bool m_invalidatesElement;
+};
+
+void FeatureChangeStyleInvalidation::invalidateStyle(Element& element) const
+{
+    // Sibling invalidation relies on the full style change of the element, see Style::resolveTree.
+    if (m_descendantInvalidation.invalidatesSiblings() || m_descendantInvalidation.wholeSubtreeInvalid()) {
+        element.setNeedsStyleRecalc();
+        return;
+    }
+    if (m_invalidatesElement)
+        element.setNeedsStyleRecalc(InlineStyleChange);
+    if (m_descendantInvalidation.isEmpty())
+        return;
+
+    Element* descendant = ElementTraversal::firstWithin(&element);
+    while (descendant) {
+        if (descendant->styleChangeType() >= FullStyleChange) {
+            descendant = ElementTraversal::nextSkippingChildren(descendant, &element);
+            continue;
+        }
+        if (m_descendantInvalidation.invalidatesElement(descendant))
+            descendant->setNeedsStyleRecalc(InlineStyleChange);
+        descendant = ElementTraversal::next(descendant, &element);
+    }
+}
+
+static void invalidateStyleForIdChange(Element& element, const AtomicString& oldId, const AtomicString& newId, const StyleResolver& styleResolver)
 {
     ASSERT(newId != oldId);
-    if (!oldId.isEmpty() && styleResolver->hasSelectorForId(oldId))
-        return true;
-    if (!newId.isEmpty() && styleResolver->hasSelectorForId(newId))
-        return true;
-    return false;
+    FeatureChangeStyleInvalidation invalidation(styleResolver);
+    if (!oldId.isEmpty())
+        invalidation.idChanged(oldId);
+    if (!newId.isEmpty())
+        invalidation.idChanged(newId);
+    invalidation.invalidateStyle(element);
 }
 
 void Element::attributeChanged(const QualifiedName& name, const AtomicString& newValue, AttributeModificationReason)
@@ -1018,7 +1086,8 @@ void Element::attributeChanged(const QualifiedName& name, const AtomicString& ne
         AtomicString newId = makeIdForStyleResolution(newValue, document().inQuirksMode());
         if (newId != oldId) {
             elementData()->setIdForStyleResolution(newId);
-            shouldInvalidateStyle = testShouldInvalidateStyle && checkNeedsStyleInvalidationForIdChange(oldId, newId, styleResolver);
+            if (testShouldInvalidateStyle)
+                invalidateStyleForIdChange(*this, oldId, newId, *styleResolver);
         }
     } else if (name == classAttr)
         classAttributeChanged(newValue);
@@ -1078,70 +1147,70 @@ static inline bool classStringHasClassName(const AtomicString& newClassString)
     return classStringHasClassName(newClassString.characters16(), length);
 }
 
-template<typename Checker>
-static bool checkSelectorForClassChange(const SpaceSplitString& changedClasses, const Checker& checker)
+static void collectClassChanges(const SpaceSplitString& changedClasses, FeatureChangeStyleInvalidation& invalidation)
 {
     unsigned changedSize = changedClasses.size();
-    for (unsigned i = 0; i < changedSize; ++i) {
-        if (checker.hasSelectorForClass(changedClasses[i]))
-            return true;
-    }
-    return false;
+    for (unsigned i = 0; i < changedSize; ++i)
+        invalidation.classChanged(changedClasses[i]);
 }
 
-template<typename Checker>
-static bool checkSelectorForClassChange(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses, const Checker& checker)
+static void collectClassChanges(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses, FeatureChangeStyleInvalidation& invalidation)
 {
     unsigned oldSize = oldClasses.size();
-    if (!oldSize)
-        return checkSelectorForClassChange(newClasses, checker);
+    if (!oldSize) {
+        collectClassChanges(newClasses, invalidation);
+        return;
+    }
     BitVector remainingClassBits;
     remainingClassBits.ensureSize(oldSize);
     // Class vectors tend to be very short. This is faster than using a hash table.
     unsigned newSize = newClasses.size();
     for (unsigned i = 0; i < newSize; ++i) {
+        bool found = false;
         for (unsigned j = 0; j < oldSize; ++j) {
             if (newClasses[i] == oldClasses[j]) {
                 remainingClassBits.quickSet(j);
-                continue;
+                found = true;
             }
         }
-        if (checker.hasSelectorForClass(newClasses[i]))
-            return true;
+        if (!found)
+            invalidation.classChanged(newClasses[i]);
     }
     for (unsigned i = 0; i < oldSize; ++i) {
         // If the bit is not set the the corresponding class has been removed.
         if (remainingClassBits.quickGet(i))
             continue;
-        if (checker.hasSelectorForClass(oldClasses[i]))
-            return true;
+        invalidation.classChanged(oldClasses[i]);
     }
-    return false;
 }
 
 void Element::classAttributeChanged(const AtomicString& newClassString)
 {
     StyleResolver* styleResolver = document().styleResolverIfExists();
     bool testShouldInvalidateStyle = attached() && styleResolver && styleChangeType() < FullStyleChange;
-    bool shouldInvalidateStyle = false;
 
     if (classStringHasClassName(newClassString)) {
         const bool shouldFoldCase = document().inQuirksMode();
         const SpaceSplitString oldClasses = ensureUniqueElementData().classNames();
         elementData()->setClass(newClassString, shouldFoldCase);
         const SpaceSplitString& newClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, newClasses, *styleResolver);
+        if (testShouldInvalidateStyle) {
+            FeatureChangeStyleInvalidation invalidation(*styleResolver);
+            collectClassChanges(oldClasses, newClasses, invalidation);
+            invalidation.invalidateStyle(*this);
+        }
     } else if (elementData()) {
         const SpaceSplitString& oldClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, *styleResolver);
+        if (testShouldInvalidateStyle) {
+            FeatureChangeStyleInvalidation invalidation(*styleResolver);
+            collectClassChanges(oldClasses, invalidation);
+            invalidation.invalidateStyle(*this);
+        }
         elementData()->clearClass();
     }
 
     if (hasRareData())
         elementRareData()->clearClassListValueForQuirksMode();
-
-    if (shouldInvalidateStyle)
-        setNeedsStyleRecalc();
 }
 
 // Returns true is the given attribute is an event handler.
@@ -2840,9 +2909,12 @@ void Element::willModifyAttribute(const QualifiedName& name, const AtomicString&
             updateLabel(scope, oldValue, newValue);
     }
 
-    if (oldValue != newValue) {
-        if (attached() && document().styleResolverIfExists() && document().styleResolverIfExists()->hasSelectorForAttribute(name.localName()))
-            setNeedsStyleRecalc();
+    if (oldValue != newValue && attached() && styleChangeType() < FullStyleChange) {
+        if (StyleResolver* styleResolver = document().styleResolverIfExists()) {
+            FeatureChangeStyleInvalidation invalidation(*styleResolver);
+            invalidation.attributeChanged(name.localName());
+            invalidation.invalidateStyle(*this);
+        }
     }
 
     if (OwnPtr<MutationObserverInterestGroup> recipients = MutationObserverInterestGroup::createForAttributesMutation(this, name))
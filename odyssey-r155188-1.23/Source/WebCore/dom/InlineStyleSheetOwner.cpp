@@ -30,7 +30,9 @@
 #include "MediaQueryEvaluator.h"
 #include "ScriptableDocumentParser.h"
 #include "StyleSheetContents.h"
+#include "StyleSheetContentsCache.h"
 #include "TextNodeTraversal.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/text/StringBuilder.h>
 #include <wtf/text/TextPosition.h>
 
@@ -152,15 +154,34 @@ void InlineStyleSheetOwner::createSheet(Element* element, const String& text)
 
     m_loading = true;
 
+    int startLineNumber = m_startLineNumber.zeroBasedInt();
+    CSSParserContext parserContext(&document, KURL(), document.inputEncoding());
+    if (RefPtr<StyleSheetContents> sharedSheet = styleSheetContentsCache().find(String(), text, startLineNumber, parserContext, document)) {
+        m_sheet = CSSStyleSheet::createInline(sharedSheet.release(), element);
+        m_sheet->setMediaQueries(mediaQueries.release());
+        m_sheet->setTitle(element->title());
+
+        // A shared sheet has no single owner node to notify, so do what checkLoaded() would have done.
+        m_loading = false;
+        element->sheetLoaded();
+        element->notifyLoadedSheetAndAllCriticalSubresources(false);
+        return;
+    }
+
     m_sheet = CSSStyleSheet::createInline(element, KURL(), document.inputEncoding());
     m_sheet->setMediaQueries(mediaQueries.release());
     m_sheet->setTitle(element->title());
-    m_sheet->contents()->parseStringAtLine(text, m_startLineNumber.zeroBasedInt(), m_isParsingChildren);
+    double parseStartTime = monotonicallyIncreasingTime();
+    m_sheet->contents()->parseStringAtLine(text, startLineNumber, m_isParsingChildren);
+    double parseTime = monotonicallyIncreasingTime() - parseStartTime;
 
     m_loading = false;
 
-    if (m_sheet)
+    if (m_sheet) {
         m_sheet->contents()->checkLoaded();
+        if (m_sheet && m_sheet->contents()->isCacheable())
+            styleSheetContentsCache().add(text, startLineNumber, m_sheet->contents(), parseTime);
+    }
 }
 
 bool InlineStyleSheetOwner::isLoading() const
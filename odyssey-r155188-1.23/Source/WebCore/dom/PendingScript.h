@@ -46,12 +46,14 @@ class PendingScript : public CachedResourceClient {
 public:
     PendingScript()
         : m_watchingForLoad(false)
+        , m_precompiled(false)
         , m_startingPosition(TextPosition::belowRangePosition())
     {
     }
 
     PendingScript(Element* element, CachedScript* cachedScript)
         : m_watchingForLoad(false)
+        , m_precompiled(false)
         , m_element(element)
     {
         setCachedScript(cachedScript);
@@ -60,6 +62,7 @@ public:
     PendingScript(const PendingScript& other)
         : CachedResourceClient(other)
         , m_watchingForLoad(other.m_watchingForLoad)
+        , m_precompiled(other.m_precompiled)
         , m_element(other.m_element)
         , m_startingPosition(other.m_startingPosition)
     {
@@ -74,6 +77,7 @@ public:
             return *this;
 
         m_watchingForLoad = other.m_watchingForLoad;
+        m_precompiled = other.m_precompiled;
         m_element = other.m_element;
         m_startingPosition = other.m_startingPosition;
         setCachedScript(other.cachedScript());
@@ -87,6 +91,9 @@ public:
     bool watchingForLoad() const { return m_watchingForLoad; }
     void setWatchingForLoad(bool b) { m_watchingForLoad = b; }
 
+    bool precompiled() const { return m_precompiled; }
+    void setPrecompiled(bool b) { m_precompiled = b; }
+
     Element* element() const { return m_element.get(); }
     void setElement(Element* element) { m_element = element; }
     PassRefPtr<Element> releaseElementAndClear();
@@ -98,6 +105,7 @@ public:
 
 private:
     bool m_watchingForLoad;
+    bool m_precompiled;
     RefPtr<Element> m_element;
     TextPosition m_startingPosition; // Only used for inline script tags.
     CachedResourceHandle<CachedScript> m_cachedScript; 
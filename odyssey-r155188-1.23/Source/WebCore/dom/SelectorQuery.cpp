@@ -30,6 +30,7 @@
 #include "CSSSelectorList.h"
 #include "Document.h"
 #include "ElementTraversal.h"
+#include "HTMLNames.h"
 #include "SelectorChecker.h"
 #include "SelectorCheckerFastPath.h"
 #include "StaticNodeList.h"
@@ -86,10 +87,15 @@ struct AllElementExtractorSelectorQueryTrait {
     ALWAYS_INLINE static void appendOutputForElement(OutputType& output, Element* element) { output.append(element); }
 };
 
+void SelectorDataList::queryAll(Node* rootNode, Vector<RefPtr<Node> >& result) const
+{
+    execute<AllElementExtractorSelectorQueryTrait>(rootNode, result);
+}
+
 PassRefPtr<NodeList> SelectorDataList::queryAll(Node* rootNode) const
 {
     Vector<RefPtr<Node>> result;
-    execute<AllElementExtractorSelectorQueryTrait>(rootNode, result);
+    queryAll(rootNode, result);
     return StaticNodeList::adopt(result);
 }
 
@@ -135,6 +141,48 @@ static inline bool isTreeScopeRoot(const Node* node)
     return node->isDocumentNode() || node->isShadowRoot();
 }
 
+// For selectors like "#list .item" all matches are inside the element with the id, so only its
+// subtree needs to be searched. Returns the node to search within, or 0 if nothing can match.
+static const Node* filterRootById(const Node* rootNode, const CSSSelector* selector)
+{
+    if (!rootNode->inDocument() || rootNode->document().inQuirksMode())
+        return rootNode;
+
+    // Ids in the rightmost compound are handled by executeFastPathForIdSelector().
+    while (selector->relation() == CSSSelector::SubSelector && selector->tagHistory())
+        selector = selector->tagHistory();
+
+    bool inAdjacentChain = false;
+    CSSSelector::Relation relation = selector->relation();
+    for (selector = selector->tagHistory(); selector; selector = selector->tagHistory()) {
+        if (relation == CSSSelector::ShadowDescendant)
+            return rootNode;
+        if (relation == CSSSelector::DirectAdjacent || relation == CSSSelector::IndirectAdjacent)
+            inAdjacentChain = true;
+        else if (relation != CSSSelector::SubSelector)
+            inAdjacentChain = false;
+        relation = selector->relation();
+
+        if (selector->m_match != CSSSelector::Id)
+            continue;
+        const AtomicString& id = selector->value();
+        if (rootNode->treeScope()->containsMultipleElementsWithId(id))
+            return rootNode;
+        Element* element = rootNode->treeScope()->getElementById(id);
+        if (!element)
+            return 0;
+        const Node* searchRootNode = inAdjacentChain ? element->parentNode() : element;
+        if (!searchRootNode)
+            return 0;
+        if (searchRootNode == rootNode || rootNode->isDescendantOf(searchRootNode))
+            return rootNode;
+        if (isTreeScopeRoot(rootNode) || searchRootNode->isDescendantOf(rootNode))
+            return searchRootNode;
+        return 0;
+    }
+    return rootNode;
+}
+
 template <typename SelectorQueryTrait>
 ALWAYS_INLINE void SelectorDataList::executeFastPathForIdSelector(const Node* rootNode, const SelectorData& selectorData, const CSSSelector* idSelector, typename SelectorQueryTrait::OutputType& output) const
 {
@@ -249,7 +297,11 @@ ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const Node* rootN
 {
     ASSERT(m_selectors.size() == 1);
 
-    for (Element* element = ElementTraversal::firstWithin(rootNode); element; element = ElementTraversal::next(element, rootNode)) {
+    const Node* searchRootNode = filterRootById(rootNode, selectorData.selector);
+    if (!searchRootNode)
+        return;
+
+    for (Element* element = ElementTraversal::firstWithin(searchRootNode); element; element = ElementTraversal::next(element, searchRootNode)) {
         if (selectorMatches(selectorData, element, rootNode)) {
             SelectorQueryTrait::appendOutputForElement(output, element);
             if (SelectorQueryTrait::shouldOnlyMatchFirstElement)
@@ -292,10 +344,111 @@ ALWAYS_INLINE void SelectorDataList::execute(Node* rootNode, typename SelectorQu
     executeSingleMultiSelectorData<SelectorQueryTrait>(rootNode, output);
 }
 
-SelectorQuery::SelectorQuery(const CSSSelectorList& selectorList)
+static bool selectorDependsOnlyOnTreeAndAttributes(const CSSSelector* selector, bool& dependsOnAttributes)
+{
+    for (; selector; selector = selector->tagHistory()) {
+        if (selector->relation() == CSSSelector::ShadowDescendant)
+            return false;
+        if (selector->m_match == CSSSelector::Tag || selector->m_match == CSSSelector::Id || selector->m_match == CSSSelector::Class)
+            continue;
+        if (selector->isAttributeSelector()) {
+            // The style attribute is synchronized lazily, without a DOM tree version change.
+            if (selector->attribute() == HTMLNames::styleAttr)
+                return false;
+            dependsOnAttributes = true;
+            continue;
+        }
+        if (selector->m_match != CSSSelector::PseudoClass)
+            return false;
+        switch (selector->pseudoType()) {
+        case CSSSelector::PseudoNot:
+            if (!selector->selectorList())
+                return false;
+            for (const CSSSelector* subSelector = selector->selectorList()->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                if (!selectorDependsOnlyOnTreeAndAttributes(subSelector, dependsOnAttributes))
+                    return false;
+            }
+            break;
+        case CSSSelector::PseudoEmpty:
+        case CSSSelector::PseudoFirstChild:
+        case CSSSelector::PseudoFirstOfType:
+        case CSSSelector::PseudoLastChild:
+        case CSSSelector::PseudoLastOfType:
+        case CSSSelector::PseudoOnlyChild:
+        case CSSSelector::PseudoOnlyOfType:
+        case CSSSelector::PseudoNthChild:
+        case CSSSelector::PseudoNthOfType:
+        case CSSSelector::PseudoNthLastChild:
+        case CSSSelector::PseudoNthLastOfType:
+        case CSSSelector::PseudoRoot:
+            break;
+        default:
+            // Dynamic state such as :hover or :checked changes without a DOM tree version change.
+            return false;
+        }
+    }
+    return true;
+}
+
+SelectorQuery::SelectorQuery(const CSSSelectorList& selectorList, SelectorQueryResultCacheStatistics& resultCacheStatistics)
     : m_selectorList(selectorList)
+    , m_resultIsCacheable(true)
+    , m_resultDependsOnAttributes(false)
+    , m_cachedResultRootNode(0)
+    , m_cachedResultDOMTreeVersion(0)
+    , m_resultCacheStatistics(resultCacheStatistics)
 {
     m_selectors.initialize(m_selectorList);
+    for (const CSSSelector* selector = m_selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+        if (!selectorDependsOnlyOnTreeAndAttributes(selector, m_resultDependsOnAttributes)) {
+            m_resultIsCacheable = false;
+            break;
+        }
+    }
+}
+
+PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
+{
+    Document& document = rootNode->document();
+    bool resultIsCacheable = m_resultIsCacheable;
+#if ENABLE(SVG)
+    // Animated SVG attributes are also synchronized lazily.
+    if (m_resultDependsOnAttributes && document.svgExtensions())
+        resultIsCacheable = false;
+#endif
+    if (!resultIsCacheable || !rootNode->inDocument())
+        return m_selectors.queryAll(rootNode);
+
+    ++m_resultCacheStatistics.lookups;
+    if (m_cachedResultRootNode == rootNode && m_cachedResultDOMTreeVersion == document.domTreeVersion()) {
+        ++m_resultCacheStatistics.hits;
+        // Every call returns a new list, as script may hold on to or add properties to the previous one.
+        Vector<RefPtr<Node> > result;
+        result.reserveInitialCapacity(m_cachedResult.size());
+        for (size_t i = 0; i < m_cachedResult.size(); ++i)
+            result.uncheckedAppend(m_cachedResult[i]);
+        return StaticNodeList::adopt(result);
+    }
+
+    Vector<RefPtr<Node> > result;
+    m_selectors.queryAll(rootNode, result);
+
+    const size_t maximumCachedResultSize = 1024;
+    if (result.size() <= maximumCachedResultSize) {
+        m_cachedResultRootNode = rootNode;
+        m_cachedResultDOMTreeVersion = document.domTreeVersion();
+        m_cachedResult.resize(result.size());
+        for (size_t i = 0; i < result.size(); ++i)
+            m_cachedResult[i] = result[i].get();
+    } else
+        clearCachedResult();
+    return StaticNodeList::adopt(result);
+}
+
+void SelectorQuery::clearCachedResult() const
+{
+    m_cachedResultRootNode = 0;
+    m_cachedResult.clear();
 }
 
 SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document* document, ExceptionCode& ec)
@@ -323,7 +476,7 @@ SelectorQuery* SelectorQueryCache::add(const AtomicString& selectors, Document*
     if (m_entries.size() == maximumSelectorQueryCacheSize)
         m_entries.remove(m_entries.begin());
     
-    OwnPtr<SelectorQuery> selectorQuery = adoptPtr(new SelectorQuery(selectorList));
+    OwnPtr<SelectorQuery> selectorQuery = adoptPtr(new SelectorQuery(selectorList, m_resultCacheStatistics));
     SelectorQuery* rawSelectorQuery = selectorQuery.get();
     m_entries.add(selectors, selectorQuery.release());
     return rawSelectorQuery;
@@ -48,6 +48,7 @@ public:
     void initialize(const CSSSelectorList&);
     bool matches(Element*) const;
     PassRefPtr<NodeList> queryAll(Node* rootNode) const;
+    void queryAll(Node* rootNode, Vector<RefPtr<Node> >&) const;
     PassRefPtr<Element> queryFirst(Node* rootNode) const;
 
 private:
@@ -69,17 +70,40 @@ private:
     Vector<SelectorData> m_selectors;
 };
 
+struct SelectorQueryResultCacheStatistics {
+    SelectorQueryResultCacheStatistics()
+        : lookups(0)
+        , hits(0)
+    { }
+
+    unsigned lookups;
+    unsigned hits;
+};
+
 class SelectorQuery {
     WTF_MAKE_NONCOPYABLE(SelectorQuery);
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    explicit SelectorQuery(const CSSSelectorList&);
+    SelectorQuery(const CSSSelectorList&, SelectorQueryResultCacheStatistics&);
     bool matches(Element*) const;
     PassRefPtr<NodeList> queryAll(Node* rootNode) const;
     PassRefPtr<Element> queryFirst(Node* rootNode) const;
+    void clearCachedResult() const;
+
 private:
     SelectorDataList m_selectors;
     CSSSelectorList m_selectorList;
+
+    // The last queryAll() result, reused for the same root node until the DOM tree version of the
+    // document changes. Only kept for selectors that depend on nothing but the tree and its attributes,
+    // and for roots in the document. The document owns this cache, so the nodes are not referenced:
+    // removing any of them from the document changes the tree version before they can be destroyed.
+    bool m_resultIsCacheable;
+    bool m_resultDependsOnAttributes;
+    mutable const Node* m_cachedResultRootNode;
+    mutable uint64_t m_cachedResultDOMTreeVersion;
+    mutable Vector<Node*> m_cachedResult;
+    SelectorQueryResultCacheStatistics& m_resultCacheStatistics;
 };
 
 class SelectorQueryCache {
@@ -88,8 +112,11 @@ public:
     SelectorQuery* add(const AtomicString&, Document*, ExceptionCode&);
     void invalidate();
 
+    const SelectorQueryResultCacheStatistics& resultCacheStatistics() const { return m_resultCacheStatistics; }
+
 private:
     HashMap<AtomicString, OwnPtr<SelectorQuery> > m_entries;
+    SelectorQueryResultCacheStatistics m_resultCacheStatistics;
 };
 
 inline bool SelectorQuery::matches(Element* element) const
@@ -97,11 +124,6 @@ inline bool SelectorQuery::matches(Element* element) const
     return m_selectors.matches(element);
 }
 
-inline PassRefPtr<NodeList> SelectorQuery::queryAll(Node* rootNode) const
-{
-    return m_selectors.queryAll(rootNode);
-}
-
 inline PassRefPtr<Element> SelectorQuery::queryFirst(Node* rootNode) const
 {
     return m_selectors.queryFirst(rootNode);
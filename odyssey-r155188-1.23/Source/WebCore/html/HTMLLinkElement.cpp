@@ -51,6 +51,8 @@
 #include "StyleInheritedData.h"
 #include "StyleResolveForDocument.h"
 #include "StyleSheetContents.h"
+#include "StyleSheetContentsCache.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/Ref.h>
 #include <wtf/StdLibExtras.h>
 
@@ -303,7 +305,18 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
 
     CSSParserContext parserContext(&document(), baseURL, charset);
 
-    if (RefPtr<StyleSheetContents> restoredSheet = const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->restoreParsedStyleSheet(parserContext)) {
+    RefPtr<StyleSheetContents> restoredSheet = const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->restoreParsedStyleSheet(parserContext);
+    bool hasValidMIMEType = false;
+    String sheetText;
+    if (!restoredSheet) {
+        // The resource may have been reloaded or its parsed sheet purged while another document still uses an identical sheet.
+        sheetText = StyleSheetContents::authorStyleSheetText(cachedStyleSheet, parserContext, &hasValidMIMEType);
+        restoredSheet = styleSheetContentsCache().find(href, sheetText, 0, parserContext, document());
+        if (restoredSheet)
+            const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->saveParsedStyleSheet(restoredSheet);
+    }
+
+    if (restoredSheet) {
         ASSERT(restoredSheet->isCacheable());
         ASSERT(!restoredSheet->isLoading());
 
@@ -323,14 +336,18 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
     m_sheet->setMediaQueries(MediaQuerySet::createAllowingDescriptionSyntax(m_media));
     m_sheet->setTitle(title());
 
-    styleSheet->parseAuthorStyleSheet(cachedStyleSheet, document().securityOrigin());
+    double parseStartTime = monotonicallyIncreasingTime();
+    styleSheet->parseAuthorStyleSheet(sheetText, hasValidMIMEType, document().securityOrigin());
+    double parseTime = monotonicallyIncreasingTime() - parseStartTime;
 
     m_loading = false;
     styleSheet->notifyLoadedSheet(cachedStyleSheet);
     styleSheet->checkLoaded();
 
-    if (styleSheet->isCacheable())
+    if (styleSheet->isCacheable()) {
+        styleSheetContentsCache().add(sheetText, 0, styleSheet, parseTime);
         const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->saveParsedStyleSheet(styleSheet.release());
+    }
 }
 
 bool HTMLLinkElement::styleSheetIsLoading() const
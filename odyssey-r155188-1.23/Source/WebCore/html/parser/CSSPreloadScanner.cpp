@@ -28,11 +28,15 @@
 #include "config.h"
 #include "CSSPreloadScanner.h"
 
+#include "FontCustomPlatformData.h"
 #include "HTMLIdentifier.h"
 #include "HTMLParserIdioms.h"
 
 namespace WebCore {
 
+// @font-face blocks longer than this are not worth buffering; real ones are a few hundred bytes.
+static const size_t maximumFontFaceBlockLength = 4096;
+
 CSSPreloadScanner::CSSPreloadScanner()
     : m_state(Initial)
     , m_requests(0)
@@ -51,37 +55,65 @@ void CSSPreloadScanner::reset()
 }
 
 template<typename Char>
-void CSSPreloadScanner::scanCommon(const Char* begin, const Char* end, PreloadRequestStream& requests)
+void CSSPreloadScanner::scanCommon(const Char* begin, const Char* end, const KURL& baseURL, PreloadRequestStream& requests)
 {
     m_requests = &requests;
-    for (const Char* it = begin; it != end && m_state != DoneParsingImportRules; ++it)
+    m_baseURL = baseURL;
+    for (const Char* it = begin; it != end; ++it)
         tokenize(*it);
     m_requests = 0;
+    m_baseURL = KURL();
 }
 
-void CSSPreloadScanner::scan(const HTMLToken::DataVector& data, PreloadRequestStream& requests)
+void CSSPreloadScanner::scan(const HTMLToken::DataVector& data, const KURL& baseURL, PreloadRequestStream& requests)
 {
-    scanCommon(data.data(), data.data() + data.size(), requests);
+    scanCommon(data.data(), data.data() + data.size(), baseURL, requests);
 }
 
 #if ENABLE(THREADED_HTML_PARSER)
-void CSSPreloadScanner::scan(const HTMLIdentifier& identifier, PreloadRequestStream& requests)
+void CSSPreloadScanner::scan(const HTMLIdentifier& identifier, const KURL& baseURL, PreloadRequestStream& requests)
 {
     const StringImpl* data = identifier.asStringImpl();
     if (data->is8Bit()) {
         const LChar* begin = data->characters8();
-        scanCommon(begin, begin + data->length(), requests);
+        scanCommon(begin, begin + data->length(), baseURL, requests);
         return;
     }
     const UChar* begin = data->characters16();
-    scanCommon(begin, begin + data->length(), requests);
+    scanCommon(begin, begin + data->length(), baseURL, requests);
 }
 #endif
 
+void CSSPreloadScanner::scan(const String& sheetText, const KURL& baseURL, PreloadRequestStream& requests)
+{
+    if (sheetText.isEmpty())
+        return;
+    if (sheetText.is8Bit()) {
+        const LChar* begin = sheetText.characters8();
+        scanCommon(begin, begin + sheetText.length(), baseURL, requests);
+        return;
+    }
+    const UChar* begin = sheetText.characters16();
+    scanCommon(begin, begin + sheetText.length(), baseURL, requests);
+}
+
+template<unsigned referenceLength>
+static inline bool ruleEqualIgnoringCase(const Vector<UChar>& rule, const char (&reference)[referenceLength])
+{
+    unsigned referenceCharactersLength = referenceLength - 1;
+    return rule.size() == referenceCharactersLength && equalIgnoringCase(reference, rule.data(), referenceCharactersLength);
+}
+
+static inline bool isFontFaceRuleNameCharacter(UChar c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-';
+}
+
 inline void CSSPreloadScanner::tokenize(UChar c)
 {
-    // We are just interested in @import rules, no need for real tokenization here
-    // Searching for other types of resources is probably low payoff.
+    // We are just interested in @import and @font-face rules, no need for real tokenization here.
+    // Searching for other types of resources (background images, etc.) needs style resolution
+    // to be useful, so it is left to the real parser.
     switch (m_state) {
     case Initial:
         if (isHTMLSpace(c))
@@ -91,7 +123,7 @@ inline void CSSPreloadScanner::tokenize(UChar c)
         else if (c == '/')
             m_state = MaybeComment;
         else
-            m_state = DoneParsingImportRules;
+            m_state = AfterImportRules;
         break;
     case MaybeComment:
         if (c == '*')
@@ -125,6 +157,8 @@ inline void CSSPreloadScanner::tokenize(UChar c)
             m_state = AfterRule;
         else if (c == ';')
             m_state = Initial;
+        else if (c == '{')
+            m_state = ruleEqualIgnoringCase(m_rule, "font-face") ? FontFaceBlock : AfterImportRules;
         else
             m_rule.append(c);
         break;
@@ -134,7 +168,7 @@ inline void CSSPreloadScanner::tokenize(UChar c)
         if (c == ';')
             m_state = Initial;
         else if (c == '{')
-            m_state = DoneParsingImportRules;
+            m_state = ruleEqualIgnoringCase(m_rule, "font-face") ? FontFaceBlock : AfterImportRules;
         else {
             m_state = RuleValue;
             m_ruleValue.append(c);
@@ -154,14 +188,57 @@ inline void CSSPreloadScanner::tokenize(UChar c)
         if (c == ';')
             emitRule();
         else if (c == '{')
-            m_state = DoneParsingImportRules;
+            m_state = AfterImportRules;
         else {
             // FIXME: media rules
             m_state = Initial;
         }
         break;
-    case DoneParsingImportRules:
-        ASSERT_NOT_REACHED();
+    case AfterImportRules:
+        // Only @font-face rules are interesting past this point. Comments and strings are not
+        // tracked, so an "@font-face" inside one may trigger a harmless extra preload.
+        if (c == '@')
+            m_state = FontFaceRuleStart;
+        break;
+    case FontFaceRuleStart:
+        m_rule.clear();
+        m_ruleValue.clear();
+        if (isFontFaceRuleNameCharacter(c)) {
+            m_rule.append(c);
+            m_state = FontFaceRule;
+        } else
+            m_state = AfterImportRules;
+        break;
+    case FontFaceRule:
+        if (isFontFaceRuleNameCharacter(c)) {
+            m_rule.append(c);
+            break;
+        }
+        if (!ruleEqualIgnoringCase(m_rule, "font-face"))
+            m_state = c == '@' ? FontFaceRuleStart : AfterImportRules;
+        else if (c == '{')
+            m_state = FontFaceBlock;
+        else if (isHTMLSpace(c))
+            m_state = AfterFontFaceRule;
+        else
+            m_state = AfterImportRules;
+        break;
+    case AfterFontFaceRule:
+        if (isHTMLSpace(c))
+            break;
+        m_state = c == '{' ? FontFaceBlock : AfterImportRules;
+        break;
+    case FontFaceBlock:
+        if (c == '}') {
+            emitFontFaceRule();
+            break;
+        }
+        if (m_ruleValue.size() >= maximumFontFaceBlockLength) {
+            m_ruleValue.clear();
+            m_state = AfterImportRules;
+            break;
+        }
+        m_ruleValue.append(c);
         break;
     }
 }
@@ -210,20 +287,12 @@ static String parseCSSStringOrURL(const UChar* characters, size_t length)
     return String(characters + offset, reducedLength);
 }
 
-template<unsigned referenceLength>
-static inline bool ruleEqualIgnoringCase(const Vector<UChar>& rule, const char (&reference)[referenceLength])
-{
-    unsigned referenceCharactersLength = referenceLength - 1;
-    return rule.size() == referenceCharactersLength && equalIgnoringCase(reference, rule.data(), referenceCharactersLength);
-}
-
 void CSSPreloadScanner::emitRule()
 {
     if (ruleEqualIgnoringCase(m_rule, "import")) {
         String url = parseCSSStringOrURL(m_ruleValue.data(), m_ruleValue.size());
         if (!url.isEmpty()) {
-            KURL baseElementURL; // FIXME: This should be passed in from the HTMLPreloadScaner via scan()!
-            OwnPtr<PreloadRequest> request = PreloadRequest::create("css", url, baseElementURL, CachedResource::CSSStyleSheet);
+            OwnPtr<PreloadRequest> request = PreloadRequest::create("css", url, m_baseURL, CachedResource::CSSStyleSheet);
             // FIXME: Should this be including the charset in the preload request?
             m_requests->append(request.release());
         }
@@ -231,7 +300,140 @@ void CSSPreloadScanner::emitRule()
     } else if (ruleEqualIgnoringCase(m_rule, "charset"))
         m_state = Initial;
     else
-        m_state = DoneParsingImportRules;
+        m_state = AfterImportRules;
+    m_rule.clear();
+    m_ruleValue.clear();
+}
+
+static inline void trimHTMLSpace(const UChar* characters, size_t& start, size_t& end)
+{
+    while (start < end && isHTMLSpace(characters[start]))
+        ++start;
+    while (end > start && isHTMLSpace(characters[end - 1]))
+        --end;
+}
+
+static inline bool startsWithIgnoringCase(const UChar* characters, size_t start, size_t end, const char* prefix)
+{
+    size_t prefixLength = strlen(prefix);
+    return end - start >= prefixLength && equalIgnoringCase(prefix, characters + start, prefixLength);
+}
+
+// Finds the next occurrence of |separator| in [start, end) that is not nested inside
+// parentheses or a quoted string, or returns |end|.
+static size_t findTopLevelSeparator(const UChar* characters, size_t start, size_t end, UChar separator)
+{
+    unsigned parenthesisDepth = 0;
+    UChar quote = 0;
+    for (size_t i = start; i < end; ++i) {
+        UChar c = characters[i];
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+            else if (c == '\\')
+                ++i;
+        } else if (c == '"' || c == '\'')
+            quote = c;
+        else if (c == '(')
+            ++parenthesisDepth;
+        else if (c == ')' && parenthesisDepth)
+            --parenthesisDepth;
+        else if (c == separator && !parenthesisDepth)
+            return i;
+    }
+    return end;
+}
+
+// Returns the argument of a functional notation such as url(...) or format(...) starting
+// at |start|, with surrounding whitespace and quotes removed, and advances |start| past it.
+static String parseFunctionArgument(const UChar* characters, size_t& start, size_t end)
+{
+    size_t open = start;
+    while (open < end && characters[open] != '(')
+        ++open;
+    size_t close = findTopLevelSeparator(characters, open + 1, end, ')');
+    if (open >= end || close >= end)
+        return String();
+    start = close + 1;
+
+    size_t argumentStart = open + 1;
+    size_t argumentEnd = close;
+    trimHTMLSpace(characters, argumentStart, argumentEnd);
+    if (argumentEnd - argumentStart >= 2 && (characters[argumentStart] == '"' || characters[argumentStart] == '\'')
+        && characters[argumentEnd - 1] == characters[argumentStart]) {
+        ++argumentStart;
+        --argumentEnd;
+    }
+    return String(characters + argumentStart, argumentEnd - argumentStart);
+}
+
+// Mirrors CSSFontFaceSrcValue::isSupportedFormat() so that we only fetch the font the
+// real font selector will pick.
+static bool isSupportedFontFormat(const String& url, const String& format)
+{
+    if (format.isEmpty())
+        return !url.endsWith(".eot", false);
+    return FontCustomPlatformData::supportsFormat(format);
+}
+
+void CSSPreloadScanner::emitFontFaceRule()
+{
+    const UChar* characters = m_ruleValue.data();
+    size_t length = m_ruleValue.size();
+
+    // The last src descriptor wins, so remember the range of the last one we see.
+    // Faces limited by unicode-range are subsets the text may never need, so
+    // they are not preloaded at all.
+    size_t srcStart = 0;
+    size_t srcEnd = 0;
+    bool hasUnicodeRange = false;
+    for (size_t declarationStart = 0; declarationStart < length; ) {
+        size_t declarationEnd = findTopLevelSeparator(characters, declarationStart, length, ';');
+        size_t colon = findTopLevelSeparator(characters, declarationStart, declarationEnd, ':');
+        if (colon < declarationEnd) {
+            size_t nameStart = declarationStart;
+            size_t nameEnd = colon;
+            trimHTMLSpace(characters, nameStart, nameEnd);
+            if (nameEnd - nameStart == 3 && equalIgnoringCase("src", characters + nameStart, 3)) {
+                srcStart = colon + 1;
+                srcEnd = declarationEnd;
+            } else if (nameEnd - nameStart == 13 && equalIgnoringCase("unicode-range", characters + nameStart, 13))
+                hasUnicodeRange = true;
+        }
+        declarationStart = declarationEnd + 1;
+    }
+
+    if (hasUnicodeRange)
+        srcEnd = srcStart;
+
+    // Preload the first candidate the font selector would try, unless that is a local font.
+    for (size_t candidateStart = srcStart; candidateStart < srcEnd; ) {
+        size_t candidateEnd = findTopLevelSeparator(characters, candidateStart, srcEnd, ',');
+        size_t position = candidateStart;
+        size_t end = candidateEnd;
+        trimHTMLSpace(characters, position, end);
+        candidateStart = candidateEnd + 1;
+
+        if (startsWithIgnoringCase(characters, position, end, "local("))
+            break;
+        if (!startsWithIgnoringCase(characters, position, end, "url("))
+            continue;
+        String url = parseFunctionArgument(characters, position, end);
+        if (url.isEmpty() || url.startsWith("data:", false))
+            break;
+
+        String format;
+        trimHTMLSpace(characters, position, end);
+        if (startsWithIgnoringCase(characters, position, end, "format("))
+            format = parseFunctionArgument(characters, position, end);
+        if (!isSupportedFontFormat(url, format))
+            continue;
+
+        m_requests->append(PreloadRequest::create("css", url, m_baseURL, CachedResource::FontResource));
+        break;
+    }
+
+    m_state = AfterImportRules;
     m_rule.clear();
     m_ruleValue.clear();
 }
@@ -43,8 +43,11 @@ public:
 
     void reset();
 
-    void scan(const HTMLToken::DataVector&, PreloadRequestStream&);
-    void scan(const HTMLIdentifier&, PreloadRequestStream&);
+    // The base URL is used to resolve relative URLs found in the style sheet; it
+    // is the predicted <base> URL for inline style and the sheet URL otherwise.
+    void scan(const HTMLToken::DataVector&, const KURL& baseURL, PreloadRequestStream&);
+    void scan(const HTMLIdentifier&, const KURL& baseURL, PreloadRequestStream&);
+    void scan(const String&, const KURL& baseURL, PreloadRequestStream&);
 
 private:
     enum State {
@@ -57,21 +60,27 @@ private:
         AfterRule,
         RuleValue,
         AfterRuleValue,
-        DoneParsingImportRules,
+        AfterImportRules,
+        FontFaceRuleStart,
+        FontFaceRule,
+        AfterFontFaceRule,
+        FontFaceBlock,
     };
 
     template<typename Char>
-    void scanCommon(const Char* begin, const Char* end, PreloadRequestStream&);
+    void scanCommon(const Char* begin, const Char* end, const KURL& baseURL, PreloadRequestStream&);
 
     inline void tokenize(UChar);
     void emitRule();
+    void emitFontFaceRule();
 
     State m_state;
     Vector<UChar> m_rule;
     Vector<UChar> m_ruleValue;
 
-    // Only non-zero during scan()
+    // Only valid during scan()
     PreloadRequestStream* m_requests;
+    KURL m_baseURL;
 };
 
 }
@@ -46,6 +46,7 @@
 #include "InspectorInstrumentation.h"
 #include "NestingLevelIncrementer.h"
 #include "Settings.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/Functional.h>
 #include <wtf/Ref.h>
 
@@ -78,6 +79,29 @@ static HTMLTokenizer::State tokenizerStateForContextElement(Element* contextElem
     return HTMLTokenizer::DataState;
 }
 
+// Adds the time from the outermost entry into the parser to its return to the document, so that
+// the cost of parsing on the main thread can be compared with and without the background parser.
+// Scripts that run while the parser processes tokens count too.
+class MainThreadTimeScope : public NestingLevelIncrementer {
+public:
+    MainThreadTimeScope(unsigned& nestingLevel, Document* document)
+        : NestingLevelIncrementer(nestingLevel)
+        , m_document(nestingLevel == 1 ? document : 0)
+        , m_startTime(m_document ? monotonicallyIncreasingTime() : 0)
+    {
+    }
+
+    ~MainThreadTimeScope()
+    {
+        if (m_document)
+            m_document->addParserMainThreadTime(monotonicallyIncreasingTime() - m_startTime);
+    }
+
+private:
+    RefPtr<Document> m_document;
+    double m_startTime;
+};
+
 HTMLDocumentParser::HTMLDocumentParser(HTMLDocument* document, bool reportErrors)
     : ScriptableDocumentParser(document)
     , m_options(document)
@@ -95,6 +119,7 @@ HTMLDocumentParser::HTMLDocumentParser(HTMLDocument* document, bool reportErrors
     , m_endWasDelayed(false)
     , m_haveBackgroundParser(false)
     , m_pumpSessionNestingLevel(0)
+    , m_mainThreadTimeNestingLevel(0)
 {
     ASSERT(shouldUseThreading() || (m_token && m_tokenizer));
 }
@@ -115,6 +140,7 @@ HTMLDocumentParser::HTMLDocumentParser(DocumentFragment* fragment, Element* cont
     , m_endWasDelayed(false)
     , m_haveBackgroundParser(false)
     , m_pumpSessionNestingLevel(0)
+    , m_mainThreadTimeNestingLevel(0)
 {
     ASSERT(!shouldUseThreading());
     bool reportErrors = false; // For now document fragment parsing never reports errors.
@@ -247,6 +273,7 @@ void HTMLDocumentParser::resumeParsingAfterYield()
     // pumpTokenizer can cause this parser to be detached from the Document,
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
 
 #if ENABLE(THREADED_HTML_PARSER)
     if (m_haveBackgroundParser) {
@@ -322,6 +349,7 @@ void HTMLDocumentParser::didReceiveParsedChunkFromBackgroundParser(PassOwnPtr<Pa
     // processParsedChunkFromBackgroundParser can cause this parser to be detached from the Document,
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
 
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willWriteHTML(document(), lineNumber().zeroBasedInt());
 
@@ -628,6 +656,7 @@ void HTMLDocumentParser::insert(const SegmentedString& source)
     // pumpTokenizer can cause this parser to be detached from the Document,
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
 
 #if ENABLE(THREADED_HTML_PARSER)
     if (!m_tokenizer) {
@@ -716,6 +745,7 @@ void HTMLDocumentParser::append(PassRefPtr<StringImpl> inputSource)
     // pumpTokenizer can cause this parser to be detached from the Document,
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
     String source(inputSource);
 
     if (m_preloadScanner) {
@@ -800,6 +830,11 @@ void HTMLDocumentParser::finish()
     // makes sense to call any methods on DocumentParser once it's been stopped.
     // However, FrameLoader::stop calls DocumentParser::finish unconditionally.
 
+    // Ending the parse can detach this parser from the Document,
+    // but we need to ensure it isn't deleted yet.
+    Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
+
 #if ENABLE(THREADED_HTML_PARSER)
     // Empty documents never got an append() call, and thus have never started
     // a background parser. In those cases, we ignore shouldUseThreading()
@@ -882,13 +917,15 @@ void HTMLDocumentParser::resumeParsingAfterScriptExecution()
     ASSERT(!isExecutingScript());
     ASSERT(!isWaitingForScripts());
 
+    // processParsedChunkFromBackgroundParser and pumpTokenizer can cause this parser to be detached
+    // from the Document, but we need to ensure it isn't deleted yet.
+    Ref<HTMLDocumentParser> protect(*this);
+    MainThreadTimeScope timeScope(m_mainThreadTimeNestingLevel, contextForParsingSession());
+
 #if ENABLE(THREADED_HTML_PARSER)
     if (m_haveBackgroundParser) {
         validateSpeculations(m_lastChunkBeforeScript.release());
         ASSERT(!m_lastChunkBeforeScript);
-        // processParsedChunkFromBackgroundParser can cause this parser to be detached from the Document,
-        // but we need to ensure it isn't deleted yet.
-        Ref<HTMLDocumentParser> protect(*this);
         pumpPendingSpeculations();
         return;
     }
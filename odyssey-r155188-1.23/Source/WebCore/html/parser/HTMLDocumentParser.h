@@ -208,6 +208,7 @@ private:
     bool m_endWasDelayed;
     bool m_haveBackgroundParser;
     unsigned m_pumpSessionNestingLevel;
+    unsigned m_mainThreadTimeNestingLevel;
 };
 
 }
@@ -34,8 +34,14 @@
 
 #include "HTMLParserThread.h"
 
+#if OS(MORPHOS)
+#include <proto/exec.h>
+#endif
+
 namespace WebCore {
 
+static HTMLParserThread* s_sharedThread = 0;
+
 HTMLParserThread::HTMLParserThread()
     : m_threadID(0)
 {
@@ -58,17 +64,27 @@ bool HTMLParserThread::start()
 void HTMLParserThread::stop()
 {
     m_queue.kill();
-    waitForThreadCompletion(m_threadID);
+    if (m_threadID)
+        waitForThreadCompletion(m_threadID);
 }
 
 HTMLParserThread* HTMLParserThread::shared()
 {
-    static HTMLParserThread* thread;
-    if (!thread) {
-        thread = HTMLParserThread::create().leakPtr();
-        thread->start();
+    if (!s_sharedThread) {
+        s_sharedThread = HTMLParserThread::create().leakPtr();
+        s_sharedThread->start();
     }
-    return thread;
+    return s_sharedThread;
+}
+
+void HTMLParserThread::shutdown()
+{
+    ASSERT(isMainThread());
+    if (!s_sharedThread)
+        return;
+    s_sharedThread->stop();
+    delete s_sharedThread;
+    s_sharedThread = 0;
 }
 
 void HTMLParserThread::postTask(const Closure& function)
@@ -89,6 +105,11 @@ void HTMLParserThread::runLoop()
         // established before starting the main loop.
         MutexLocker lock(m_threadCreationMutex);
     }
+#if OS(MORPHOS)
+    // Run below the main task so that tokenizing a large page never delays
+    // input handling on single processor machines.
+    SetTaskPri(FindTask(0), -1);
+#endif
     while (OwnPtr<Closure> function = m_queue.waitForMessage())
         (*function)();
 
@@ -53,6 +53,9 @@ public:
     ~HTMLParserThread();
 
     static HTMLParserThread* shared();
+    // Stops and destroys the shared thread, if one was started. Ports whose
+    // child threads must exit before the process does call this on shutdown.
+    static void shutdown();
 
     bool start();
     void stop();
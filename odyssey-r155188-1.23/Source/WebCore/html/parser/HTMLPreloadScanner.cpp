@@ -123,13 +123,7 @@ public:
             String attributeValue = StringImpl::create8BitIfPossible(iter->value);
             processAttribute(attributeName, attributeValue);
         }
-
-        // Resolve between src and srcSet if we have them.
-        if (!m_srcSetAttribute.isEmpty()) {
-            String srcMatchingScale = bestFitSourceForImageAttributes(m_deviceScaleFactor, m_urlToLoad, m_srcSetAttribute);
-            setUrlToLoad(srcMatchingScale, true);
-        }
-
+        resolveSourceSet();
     }
 
 #if ENABLE(THREADED_HTML_PARSER)
@@ -139,6 +133,7 @@ public:
             return;
         for (Vector<CompactHTMLToken::Attribute>::const_iterator iter = attributes.begin(); iter != attributes.end(); ++iter)
             processAttribute(iter->name, iter->value);
+        resolveSourceSet();
     }
 #endif
 
@@ -195,6 +190,15 @@ private:
         }
     }
 
+    void resolveSourceSet()
+    {
+        // Resolve between src and srcSet if we have them.
+        if (m_srcSetAttribute.isEmpty())
+            return;
+        String srcMatchingScale = bestFitSourceForImageAttributes(m_deviceScaleFactor, m_urlToLoad, m_srcSetAttribute);
+        setUrlToLoad(srcMatchingScale, true);
+    }
+
     static bool relAttributeIsStyleSheet(const String& attributeValue)
     {
         LinkRelAttribute rel(attributeValue);
@@ -320,7 +324,7 @@ void TokenPreloadScanner::scanCommon(const Token& token, Vector<OwnPtr<PreloadRe
     case HTMLToken::Character: {
         if (!m_inStyle)
             return;
-        m_cssScanner.scan(token.data(), requests);
+        m_cssScanner.scan(token.data(), m_predictedBaseElementURL, requests);
         return;
     }
     case HTMLToken::EndTag: {
@@ -40,6 +40,7 @@
 #include "MutationObserver.h"
 #include "NestingLevelIncrementer.h"
 #include "NotImplemented.h"
+#include "ScriptController.h"
 #include "ScriptElement.h"
 #include "ScriptSourceCode.h"
 
@@ -199,6 +200,28 @@ void HTMLScriptRunner::executeParsingBlockingScripts()
 {
     while (hasParserBlockingScript() && isPendingScriptReady(m_parserBlockingScript))
         executeParsingBlockingScript();
+
+    // A script that is only waiting for stylesheets can be compiled while they load,
+    // so that running it later does not have to parse it first.
+    if (hasParserBlockingScript() && m_hasScriptsWaitingForStylesheets)
+        precompilePendingScript(m_parserBlockingScript);
+}
+
+void HTMLScriptRunner::precompilePendingScript(PendingScript& pendingScript)
+{
+    if (pendingScript.precompiled())
+        return;
+    if (pendingScript.cachedScript() && !pendingScript.cachedScript()->isLoaded())
+        return;
+    Frame* frame = m_document ? m_document->frame() : 0;
+    if (!frame)
+        return;
+
+    pendingScript.setPrecompiled(true);
+    bool errorOccurred = false;
+    ScriptSourceCode sourceCode = sourceFromPendingScript(pendingScript, errorOccurred);
+    if (!errorOccurred)
+        frame->script().precompileScript(sourceCode);
 }
 
 void HTMLScriptRunner::executeScriptsWaitingForLoad(CachedResource* cachedScript)
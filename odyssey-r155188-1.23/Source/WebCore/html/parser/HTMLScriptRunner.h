@@ -71,6 +71,7 @@ private:
     void executeParsingBlockingScript();
     void executePendingScriptAndDispatchEvent(PendingScript&);
     void executeParsingBlockingScripts();
+    void precompilePendingScript(PendingScript&);
 
     void requestParsingBlockingScript(Element*);
     void requestDeferredScript(Element*);
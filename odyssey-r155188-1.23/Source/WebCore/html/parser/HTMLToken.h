@@ -337,6 +337,13 @@ public:
         m_currentAttribute->value.append(character);
     }
 
+    void appendToAttributeValue(const LChar* characters, unsigned length)
+    {
+        ASSERT(m_type == StartTag || m_type == EndTag);
+        ASSERT(m_currentAttribute->valueRange.start);
+        m_currentAttribute->value.append(characters, length);
+    }
+
     void appendToAttributeValue(size_t i, const String& value)
     {
         ASSERT(!value.isEmpty());
@@ -401,6 +408,12 @@ public:
         m_data.appendVector(characters);
     }
 
+    void appendToCharacter(const LChar* characters, unsigned length)
+    {
+        ASSERT(m_type == Character);
+        m_data.append(characters, length);
+    }
+
     /* Comment Tokens */
 
     const DataVector& comment() const
@@ -36,6 +36,7 @@
 #include "NotImplemented.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/CurrentTime.h>
+#include <wtf/text/ASCIIFastPath.h>
 #include <wtf/text/AtomicString.h>
 #include <wtf/text/CString.h>
 #include <wtf/unicode/Unicode.h>
@@ -81,6 +82,35 @@ static inline bool vectorEqualsString(const Vector<LChar, 32>& vector, const Str
     return equal(string.impl(), vector.data(), vector.size());
 }
 
+// Text, RCDATA, script and attribute value states spend most of their time
+// copying characters they do not act on. This finds the run of 8-bit characters
+// after the current one that can be copied in one go: it ends before |first|
+// or |second|, and before '\r', '\n' and '\0', which have to go through the
+// input stream preprocessor and the line counter one at a time.
+static inline const LChar* plainCharacterRun(SegmentedString& source, UChar currentCharacter, LChar first, LChar second, unsigned& length)
+{
+    length = 0;
+    unsigned available;
+    const LChar* characters = source.currentCharacters8(available);
+    // The current character must be the one the preprocessor handed out
+    // unchanged, so that it has no pending newline to skip.
+    if (!characters || currentCharacter != source.currentChar() || currentCharacter == '\n')
+        return 0;
+
+    const LChar* start = characters + 1;
+    const LChar* end = characters + available;
+    const LChar* position = start;
+    while (true) {
+        position = findControlCharacterOr(position, end, first, second);
+        if (position == end || *position == first || *position == second || *position == '\r' || *position == '\n' || !*position)
+            break;
+        // Tabs and the other control characters need no special handling.
+        ++position;
+    }
+    length = position - start;
+    return start;
+}
+
 static inline bool isEndTagBufferingState(HTMLTokenizer::State state)
 {
     switch (state) {
@@ -158,6 +188,26 @@ void HTMLTokenizer::restoreFromCheckpoint(const Checkpoint& checkpoint)
 
 #endif
 
+inline void HTMLTokenizer::bufferPlainCharacters(SegmentedString& source, UChar currentCharacter, LChar first, LChar second)
+{
+    unsigned length;
+    const LChar* characters = plainCharacterRun(source, currentCharacter, first, second, length);
+    if (!length)
+        return;
+    m_token->appendToCharacter(characters, length);
+    source.advancePastNonNewlines8(length);
+}
+
+inline void HTMLTokenizer::appendPlainCharactersToAttributeValue(SegmentedString& source, UChar currentCharacter, LChar first, LChar second)
+{
+    unsigned length;
+    const LChar* characters = plainCharacterRun(source, currentCharacter, first, second, length);
+    if (!length)
+        return;
+    m_token->appendToAttributeValue(characters, length);
+    source.advancePastNonNewlines8(length);
+}
+
 inline bool HTMLTokenizer::processEntity(SegmentedString& source)
 {
     bool notEnoughCharacters = false;
@@ -247,6 +297,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferPlainCharacters(source, cc, '<', '&');
             HTML_ADVANCE_TO(DataState);
         }
     }
@@ -268,6 +319,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferPlainCharacters(source, cc, '<', '&');
             HTML_ADVANCE_TO(RCDATAState);
         }
     }
@@ -287,6 +339,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferPlainCharacters(source, cc, '<', '<');
             HTML_ADVANCE_TO(RAWTEXTState);
         }
     }
@@ -299,6 +352,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferPlainCharacters(source, cc, '<', '<');
             HTML_ADVANCE_TO(ScriptDataState);
         }
     }
@@ -963,6 +1017,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendPlainCharactersToAttributeValue(source, cc, '"', '&');
             HTML_ADVANCE_TO(AttributeValueDoubleQuotedState);
         }
     }
@@ -981,6 +1036,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             HTML_RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendPlainCharactersToAttributeValue(source, cc, '\'', '&');
             HTML_ADVANCE_TO(AttributeValueSingleQuotedState);
         }
     }
@@ -213,6 +213,9 @@ private:
         m_token->appendToCharacter(character);
     }
 
+    inline void bufferPlainCharacters(SegmentedString&, UChar currentCharacter, LChar first, LChar second);
+    inline void appendPlainCharactersToAttributeValue(SegmentedString&, UChar currentCharacter, LChar first, LChar second);
+
     inline bool emitAndResumeIn(SegmentedString& source, State state)
     {
         saveEndTagNameIfNeeded();
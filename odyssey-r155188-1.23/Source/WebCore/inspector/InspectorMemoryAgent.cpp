@@ -44,12 +44,14 @@
 #include "InspectorState.h"
 #include "InspectorValues.h"
 #include "InstrumentingAgents.h"
+#include "JSDOMWindowBase.h"
 #include "MemoryCache.h"
 #include "Node.h"
 #include "NodeTraversal.h"
 #include "ScriptGCEvent.h"
 #include "ScriptProfiler.h"
 #include "StyledElement.h"
+#include <heap/HeapStatistics.h>
 #include <runtime/ArrayBufferView.h>
 #include <wtf/HashSet.h>
 #include <wtf/NonCopyingSort.h>
@@ -77,6 +79,24 @@ void InspectorMemoryAgent::getDOMCounters(ErrorString*, int* documents, int* nod
     *jsEventListeners = ThreadLocalInspectorCounters::current().counterValue(ThreadLocalInspectorCounters::JSEventListenerCounter);
 }
 
+void InspectorMemoryAgent::setJavaScriptAllocationSamplingInterval(ErrorString* errorString, int interval)
+{
+    if (interval < 0) {
+        *errorString = "Sampling interval must not be negative";
+        return;
+    }
+    JSC::VM* vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+    vm->heap.allocationSampler().setSamplingInterval(interval);
+}
+
+void InspectorMemoryAgent::getJavaScriptAllocationSamples(ErrorString*, String* samples)
+{
+    JSC::VM* vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+    *samples = JSC::HeapStatistics::allocationSamplesAsJSON(&vm->heap);
+}
+
 InspectorMemoryAgent::InspectorMemoryAgent(InstrumentingAgents* instrumentingAgents, InspectorCompositeState* state)
     : InspectorBaseAgent<InspectorMemoryAgent>("Memory", instrumentingAgents, state)
     , m_frontend(0)
@@ -55,6 +55,8 @@ public:
     virtual ~InspectorMemoryAgent();
 
     virtual void getDOMCounters(ErrorString*, int* documents, int* nodes, int* jsEventListeners);
+    virtual void setJavaScriptAllocationSamplingInterval(ErrorString*, int interval);
+    virtual void getJavaScriptAllocationSamples(ErrorString*, String* samples);
 
     virtual void setFrontend(InspectorFrontend*);
     virtual void clearFrontend();
@@ -3340,6 +3340,9 @@ void FrameLoader::dispatchDidCommitLoad()
     if (isLoadingMainFrame()) {
         m_frame.page()->resetSeenPlugins();
         m_frame.page()->resetSeenMediaEngines();
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+        m_frame.page()->resetDecodedImagePixels();
+#endif
     }
 
     InspectorInstrumentation::didCommitLoad(&m_frame, m_documentLoader.get());
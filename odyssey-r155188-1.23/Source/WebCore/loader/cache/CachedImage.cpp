@@ -194,7 +194,18 @@ Image* CachedImage::imageForRenderer(const RenderObject* renderer)
         if (image != Image::nullImage())
             return image;
     }
-#else
+#endif
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Each page that draws the image limits it to its share of the page's
+    // decoded pixel budget; larger draws scale up the down-sampled frame.
+    if (renderer && m_image->isBitmapImage()) {
+        if (Page* page = renderer->frame().page()) {
+            m_pagesCountingDecodedPixels.add(page);
+            static_cast<BitmapImage*>(m_image.get())->setMaxDecodedPixels(page->decodedPixelsAvailableForImage(this, decodedSize() / 4));
+        }
+    }
+#endif
+#if !ENABLE(SVG) && !ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
     UNUSED_PARAM(renderer);
 #endif
     return m_image.get();
@@ -344,6 +355,9 @@ inline void CachedImage::clearImage()
     if (m_image)
         m_image->setImageObserver(0);
     m_image.clear();
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    updatePagesCountingDecodedPixels();
+#endif
 }
 
 bool CachedImage::canBeDrawn() const
@@ -456,6 +470,9 @@ void CachedImage::destroyDecodedData()
         // Invoking addClient() will reconstruct the image object.
         m_image = 0;
         setDecodedSize(0);
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+        updatePagesCountingDecodedPixels();
+#endif
         if (!MemoryCache::shouldMakeResourcePurgeableOnEviction())
             makePurgeable(true);
     } else if (m_image && !errorOccurred())
@@ -468,7 +485,31 @@ void CachedImage::decodedSizeChanged(const Image* image, int delta)
         return;
     
     setDecodedSize(decodedSize() + delta);
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    updatePagesCountingDecodedPixels();
+#endif
+}
+
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+void CachedImage::updatePagesCountingDecodedPixels()
+{
+    if (m_pagesCountingDecodedPixels.isEmpty())
+        return;
+
+    // Once the decoded frames are gone, the pages stop counting the image
+    // until it is drawn again.
+    unsigned decodedPixels = m_image ? decodedSize() / 4 : 0;
+    HashSet<Page*>::iterator end = m_pagesCountingDecodedPixels.end();
+    for (HashSet<Page*>::iterator it = m_pagesCountingDecodedPixels.begin(); it != end; ++it) {
+        if (decodedPixels)
+            (*it)->setDecodedImagePixels(this, decodedPixels);
+        else
+            (*it)->removeDecodedImage(this);
+    }
+    if (!decodedPixels)
+        m_pagesCountingDecodedPixels.clear();
 }
+#endif
 
 void CachedImage::didDraw(const Image* image)
 {
@@ -534,8 +575,15 @@ void CachedImage::resumeAnimatingImagesForLoader(CachedResourceLoader* loader)
 bool CachedImage::currentFrameKnownToBeOpaque(const RenderObject* renderer)
 {
     Image* image = imageForRenderer(renderer);
-    if (image->isBitmapImage())
+    if (image->isBitmapImage()) {
+#if ENABLE(THREADED_IMAGE_DECODING)
+        // Don't decode on the main thread what painting will decode on the
+        // image decoding threads; the background shows until it is done.
+        if (renderer->frame().settings().asynchronousImageDecodingEnabled() && static_cast<BitmapImage*>(image)->canDecodeAsynchronously())
+            return false;
+#endif
         image->nativeImageForCurrentFrame(); // force decode
+    }
     return image->currentFrameKnownToBeOpaque();
 }
 
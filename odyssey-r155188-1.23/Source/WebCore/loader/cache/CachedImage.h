@@ -30,6 +30,7 @@
 #include "LayoutSize.h"
 #include "SVGImageCache.h"
 #include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
@@ -38,6 +39,7 @@ class CachedImageClient;
 class CachedResourceLoader;
 class FloatSize;
 class MemoryCache;
+class Page;
 class RenderObject;
 struct Length;
 
@@ -77,6 +79,11 @@ public:
 
     static void resumeAnimatingImagesForLoader(CachedResourceLoader*);
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Called by a page that no longer counts our decoded pixels.
+    void pageStoppedCountingDecodedPixels(Page* page) { m_pagesCountingDecodedPixels.remove(page); }
+#endif
+
 private:
     virtual void load(CachedResourceLoader*, const ResourceLoaderOptions&) OVERRIDE;
 
@@ -89,6 +96,9 @@ private:
     void notifyObservers(const IntRect* changeRect = 0);
     virtual PurgePriority purgePriority() const OVERRIDE { return PurgeFirst; }
     void checkShouldPaintBrokenImage();
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    void updatePagesCountingDecodedPixels();
+#endif
 
     virtual void switchClientsToRevalidatedResource() OVERRIDE;
     virtual bool mayTryReplaceEncodedData() const OVERRIDE { return true; }
@@ -129,6 +139,10 @@ private:
 #endif
     bool m_shouldPaintBrokenImage;
     size_t m_lastDecodedSize;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // The pages whose decoded pixel budget our decoded frames count against.
+    HashSet<Page*> m_pagesCountingDecodedPixels;
+#endif
 };
 
 }
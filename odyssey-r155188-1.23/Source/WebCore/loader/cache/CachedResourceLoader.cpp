@@ -35,6 +35,7 @@
 #include "CachedResourceRequest.h"
 #include "CachedScript.h"
 #include "CachedXSLStyleSheet.h"
+#include "CSSPreloadScanner.h"
 #include "Console.h"
 #include "ContentSecurityPolicy.h"
 #include "DOMWindow.h"
@@ -772,10 +773,10 @@ void CachedResourceLoader::loadDone(CachedResource* resource)
             m_initiatorMap.remove(initiatorIt);
         }
     }
-#else
-    UNUSED_PARAM(resource);
 #endif // ENABLE(RESOURCE_TIMING)
 
+    preloadResourcesReferencedBy(resource);
+
     if (frame())
         frame()->loader().loadDone();
     performPostLoadActions();
@@ -878,6 +879,11 @@ void CachedResourceLoader::requestPreload(CachedResource::Type type, CachedResou
     request.setCharset(encoding);
     request.setForPreload(true);
 
+    // A page may declare faces its text never uses, so preloaded fonts go after everything
+    // else; CSSFontFaceSource raises the priority of the ones text turns out to need.
+    if (type == CachedResource::FontResource)
+        request.setPriority(ResourceLoadPriorityLow);
+
     CachedResourceHandle<CachedResource> resource = requestResource(type, request);
     if (!resource || (m_preloads && m_preloads->contains(resource.get())))
         return;
@@ -887,11 +893,36 @@ void CachedResourceLoader::requestPreload(CachedResource::Type type, CachedResou
         m_preloads = adoptPtr(new ListHashSet<CachedResource*>);
     m_preloads->add(resource.get());
 
+    // CachedFont waits until a font face asks for it, which is when it would load anyway.
+    if (type == CachedResource::FontResource)
+        static_cast<CachedFont*>(resource.get())->beginLoadIfNeeded(this);
+
 #if PRELOAD_DEBUG
     printf("PRELOADING %s\n",  resource->url().latin1().data());
 #endif
 }
 
+// Style sheets fetched by the preload scanner are scanned again as they arrive so that their
+// own @import and @font-face subresources can be requested before the parser reaches them.
+void CachedResourceLoader::preloadResourcesReferencedBy(CachedResource* resource)
+{
+    if (!resource || resource->type() != CachedResource::CSSStyleSheet || resource->errorOccurred() || resource->wasCanceled())
+        return;
+    if (!m_preloads || !m_preloads->contains(resource))
+        return;
+    if (!m_document || !m_document->parsing() || !m_document->frame())
+        return;
+
+    CSSPreloadScanner scanner;
+    PreloadRequestStream requests;
+    scanner.scan(static_cast<CachedCSSStyleSheet*>(resource)->sheetText(), resource->url(), requests);
+
+    for (PreloadRequestStream::iterator it = requests.begin(); it != requests.end(); ++it) {
+        CachedResourceRequest request = (*it)->resourceRequest(m_document);
+        preload((*it)->resourceType(), request, (*it)->charset());
+    }
+}
+
 bool CachedResourceLoader::isPreloaded(const String& urlString) const
 {
     const KURL& url = m_document->completeURL(urlString);
@@ -922,17 +953,38 @@ void CachedResourceLoader::clearPreloads()
     if (!m_preloads)
         return;
 
+    unsigned used = 0;
     ListHashSet<CachedResource*>::iterator end = m_preloads->end();
     for (ListHashSet<CachedResource*>::iterator it = m_preloads->begin(); it != end; ++it) {
         CachedResource* res = *it;
+        if (res->preloadResult() != CachedResource::PreloadNotReferenced)
+            ++used;
         res->decreasePreloadCount();
         bool deleted = res->deleteIfPossible();
         if (!deleted && res->preloadResult() == CachedResource::PreloadNotReferenced)
             memoryCache()->remove(res);
     }
+
+    unsigned issued = m_preloads->size();
+    PreloadStatistics& statistics = mutablePreloadStatistics();
+    statistics.issued += issued;
+    statistics.used += used;
+    LOG(ResourceLoading, "CachedResourceLoader::clearPreloads %u of %u preloads used (%u of %u since startup)", used, issued, statistics.used, statistics.issued);
+
     m_preloads.clear();
 }
 
+CachedResourceLoader::PreloadStatistics& CachedResourceLoader::mutablePreloadStatistics()
+{
+    DEFINE_STATIC_LOCAL(PreloadStatistics, statistics, ());
+    return statistics;
+}
+
+const CachedResourceLoader::PreloadStatistics& CachedResourceLoader::preloadStatistics()
+{
+    return mutablePreloadStatistics();
+}
+
 void CachedResourceLoader::clearPendingPreloads()
 {
     m_pendingPreloads.clear();
@@ -137,6 +137,15 @@ public:
 
     static const ResourceLoaderOptions& defaultCachedResourceOptions();
 
+    // Process-wide preload scanner effectiveness, accumulated as documents drop their preloads.
+    // A preload counts as used if the document requested it before the preload was cleared.
+    struct PreloadStatistics {
+        PreloadStatistics() : issued(0), used(0) { }
+        unsigned issued;
+        unsigned used;
+    };
+    static const PreloadStatistics& preloadStatistics();
+
 private:
     explicit CachedResourceLoader(DocumentLoader*);
 
@@ -147,6 +156,8 @@ private:
     void storeResourceTimingInitiatorInformation(const CachedResourceHandle<CachedResource>&, const CachedResourceRequest&);
 #endif
     void requestPreload(CachedResource::Type, CachedResourceRequest&, const String& charset);
+    void preloadResourcesReferencedBy(CachedResource*);
+    static PreloadStatistics& mutablePreloadStatistics();
 
     enum RevalidationPolicy { Use, Revalidate, Reload, Load };
     RevalidationPolicy determineRevalidationPolicy(CachedResource::Type, ResourceRequest&, bool forPreload, CachedResource* existingResource, CachedResourceRequest::DeferOption) const;
@@ -42,6 +42,7 @@ namespace WebCore {
 CachedScript::CachedScript(const ResourceRequest& resourceRequest, const String& charset)
     : CachedResource(resourceRequest, Script)
     , m_decoder(TextResourceDecoder::create(ASCIILiteral("application/javascript"), charset))
+    , m_streamedDataLength(0)
 {
     // It's javascript we want.
     // But some websites think their scripts are <some wrong mimetype here>
@@ -82,13 +83,63 @@ const String& CachedScript::script()
     return m_script;
 }
 
+void CachedScript::addDataBuffer(ResourceBuffer* data)
+{
+    ASSERT(m_options.dataBufferingPolicy == BufferData);
+    m_data = data;
+    // Decode each chunk as it arrives so that the text is ready, rather than
+    // decoded all at once, when the last byte comes in.
+    decodeReceivedData(data);
+}
+
+void CachedScript::decodeReceivedData(ResourceBuffer* data)
+{
+    const char* segment;
+    while (unsigned length = data->getSomeData(segment, m_streamedDataLength)) {
+        m_streamedScript.append(m_decoder->decode(segment, length));
+        m_streamedDataLength += length;
+    }
+}
+
 void CachedScript::finishLoading(ResourceBuffer* data)
 {
     m_data = data;
     setEncodedSize(m_data.get() ? m_data->size() : 0);
+
+    if (m_data && m_streamedDataLength && m_streamedDataLength <= m_data->size()) {
+        decodeReceivedData(m_data.get());
+        m_streamedScript.append(m_decoder->flush());
+        m_script = m_streamedScript.toString();
+        setDecodedSize(m_script.sizeInBytes());
+        m_decodedDataDeletionTimer.restart();
+    }
+    clearStreamedScript();
+
     CachedResource::finishLoading(data);
 }
 
+void CachedScript::error(CachedResource::Status status)
+{
+    clearStreamedScript();
+    CachedResource::error(status);
+}
+
+void CachedScript::cancelLoad()
+{
+    clearStreamedScript();
+    CachedResource::cancelLoad();
+}
+
+void CachedScript::clearStreamedScript()
+{
+    // script() decodes the whole data again with the same decoder, which must
+    // not hold on to the end of a partly decoded chunk.
+    if (m_streamedDataLength)
+        m_decoder->flush();
+    m_streamedScript.clear();
+    m_streamedDataLength = 0;
+}
+
 void CachedScript::destroyDecodedData()
 {
     m_script = String();
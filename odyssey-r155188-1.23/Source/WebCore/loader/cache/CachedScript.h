@@ -27,6 +27,7 @@
 #define CachedScript_h
 
 #include "CachedResource.h"
+#include <wtf/text/StringBuilder.h>
 
 namespace WebCore {
 
@@ -54,12 +55,23 @@ namespace WebCore {
 
         virtual void setEncoding(const String&) OVERRIDE;
         virtual String encoding() const OVERRIDE;
+        virtual void addDataBuffer(ResourceBuffer*) OVERRIDE;
         virtual void finishLoading(ResourceBuffer*) OVERRIDE;
+        virtual void error(CachedResource::Status) OVERRIDE;
+        virtual void cancelLoad() OVERRIDE;
+
+        void decodeReceivedData(ResourceBuffer*);
+        void clearStreamedScript();
 
         virtual void destroyDecodedData() OVERRIDE;
 
         String m_script;
         RefPtr<TextResourceDecoder> m_decoder;
+
+        // Text decoded while the script is still loading, and how many
+        // encoded bytes it covers.
+        StringBuilder m_streamedScript;
+        unsigned m_streamedDataLength;
     };
 }
 
@@ -35,6 +35,7 @@
 #include "PublicSuffix.h"
 #include "SecurityOrigin.h"
 #include "SecurityOriginHash.h"
+#include "StyleSheetContentsCache.h"
 #if ENABLE(WORKERS)
 #include "WorkerGlobalScope.h"
 #include "WorkerLoaderProxy.h"
@@ -812,6 +813,8 @@ void MemoryCache::evictResources()
 
     setDisabled(true);
     setDisabled(false);
+
+    styleSheetContentsCache().clear();
 }
 
 void MemoryCache::prune()
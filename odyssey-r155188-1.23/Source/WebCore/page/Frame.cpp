@@ -753,15 +753,23 @@ void Frame::createView(const IntSize& viewportSize, const Color& backgroundColor
 void Frame::setTiledBackingStoreEnabled(bool enabled)
 {
     if (!enabled) {
+        if (!m_tiledBackingStore)
+            return;
         m_tiledBackingStore.clear();
+        if (m_view) {
+            m_view->setPaintsEntireContents(false);
+            m_view->invalidate();
+        }
         return;
     }
     if (m_tiledBackingStore)
         return;
     m_tiledBackingStore = adoptPtr(new TiledBackingStore(this));
     m_tiledBackingStore->setCommitTileUpdatesOnIdleEventLoop(true);
-    if (m_view)
+    if (m_view) {
         m_view->setPaintsEntireContents(true);
+        m_view->invalidate();
+    }
 }
 
 void Frame::tiledBackingStorePaintBegin()
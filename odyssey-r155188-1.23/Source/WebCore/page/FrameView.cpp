@@ -48,6 +48,7 @@
 #include "FrameSelection.h"
 #include "FrameTree.h"
 #include "GraphicsContext.h"
+#include "HTMLCollection.h"
 #include "HTMLDocument.h"
 #include "HTMLFrameElement.h"
 #include "HTMLFrameSetElement.h"
@@ -62,6 +63,7 @@
 #include "RenderEmbeddedObject.h"
 #include "RenderFullScreen.h"
 #include "RenderIFrame.h"
+#include "RenderImage.h"
 #include "RenderLayer.h"
 #include "RenderLayerBacking.h"
 #include "RenderPart.h"
@@ -196,6 +198,9 @@ FrameView::FrameView(Frame& frame)
     , m_inProgrammaticScroll(false)
     , m_safeToPropagateScrollToParent(true)
     , m_deferredRepaintTimer(this, &FrameView::deferredRepaintTimerFired)
+#if ENABLE(THREADED_IMAGE_DECODING)
+    , m_asynchronousImageDecodeTimer(this, &FrameView::asynchronousImageDecodeTimerFired)
+#endif
     , m_disableRepaints(0)
     , m_isTrackingRepaints(false)
     , m_shouldUpdateWhileOffscreen(true)
@@ -293,6 +298,9 @@ void FrameView::reset()
     m_repaintRects.clear();
     m_deferredRepaintDelay = s_initialDeferredRepaintDelayDuringLoading;
     m_deferredRepaintTimer.stop();
+#if ENABLE(THREADED_IMAGE_DECODING)
+    m_asynchronousImageDecodeTimer.stop();
+#endif
     m_isTrackingRepaints = false;
     m_trackedRepaintRects.clear();
     m_lastPaintTime = 0;
@@ -1981,6 +1989,14 @@ void FrameView::scrollPositionChanged()
     frame().eventHandler().sendScrollEvent();
     frame().eventHandler().dispatchFakeMouseMoveEventSoon();
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Decode the images coming into view ahead of painting them, at most
+    // once per burst of scroll steps.
+    static const double asynchronousImageDecodeDelay = 0.05;
+    if (frame().settings().asynchronousImageDecodingEnabled() && !m_asynchronousImageDecodeTimer.isActive())
+        m_asynchronousImageDecodeTimer.startOneShot(asynchronousImageDecodeDelay);
+#endif
+
 #if USE(ACCELERATED_COMPOSITING)
     if (RenderView* renderView = this->renderView()) {
         if (renderView->usesCompositing())
@@ -1989,6 +2005,22 @@ void FrameView::scrollPositionChanged()
 #endif
 }
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+void FrameView::asynchronousImageDecodeTimerFired(Timer<FrameView>*)
+{
+    Document* document = frame().document();
+    if (!document || needsLayout())
+        return;
+
+    RefPtr<HTMLCollection> images = document->images();
+    for (unsigned i = 0; i < images->length(); ++i) {
+        RenderObject* renderer = images->item(i)->renderer();
+        if (renderer && renderer->isRenderImage())
+            toRenderImage(renderer)->decodeImageAsynchronouslyIfNearViewport();
+    }
+}
+#endif
+
 // FIXME: this function is misnamed; its primary purpose is to update RenderLayer positions.
 void FrameView::repaintFixedElementsAfterScrolling()
 {
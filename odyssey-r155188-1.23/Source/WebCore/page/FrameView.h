@@ -521,6 +521,9 @@ private:
 
     bool shouldUseLoadTimeDeferredRepaintDelay() const;
     void deferredRepaintTimerFired(Timer<FrameView>*);
+#if ENABLE(THREADED_IMAGE_DECODING)
+    void asynchronousImageDecodeTimerFired(Timer<FrameView>*);
+#endif
     void doDeferredRepaints();
     void updateDeferredRepaintDelayAfterRepaint();
     double adjustedDeferredRepaintDelay() const;
@@ -607,6 +610,9 @@ private:
     Vector<LayoutRect> m_repaintRects;
     Timer<FrameView> m_deferredRepaintTimer;
     double m_deferredRepaintDelay;
+#if ENABLE(THREADED_IMAGE_DECODING)
+    Timer<FrameView> m_asynchronousImageDecodeTimer;
+#endif
     double m_lastPaintTime;
 
     unsigned m_disableRepaints;
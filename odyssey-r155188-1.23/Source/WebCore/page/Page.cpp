@@ -24,6 +24,7 @@
 #include "AnimationController.h"
 #include "BackForwardController.h"
 #include "BackForwardList.h"
+#include "CachedImage.h"
 #include "Chrome.h"
 #include "ChromeClient.h"
 #include "ClientRectList.h"
@@ -186,6 +187,9 @@ Page::Page(PageClients& pageClients)
     , m_scriptedAnimationsSuspended(false)
     , m_pageThrottler(PageThrottler::create(this))
     , m_console(PageConsole::create(this))
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    , m_totalDecodedImagePixels(0)
+#endif
     , m_lastSpatialNavigationCandidatesCount(0) // NOTE: Only called from Internals for Spatial Navigation testing.
     , m_framesHandlingBeforeUnloadEvent(0)
 {
@@ -229,6 +233,10 @@ Page::~Page()
     if (m_scrollingCoordinator)
         m_scrollingCoordinator->pageDestroyed();
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    resetDecodedImagePixels();
+#endif
+
     backForward()->close();
 
 #ifndef NDEBUG
@@ -1517,6 +1525,50 @@ void Page::resetSeenMediaEngines()
     m_seenMediaEngines.clear();
 }
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+unsigned Page::decodedPixelsAvailableForImage(const CachedImage* image, unsigned decodedPixels)
+{
+    // However many images the page shows, each may be decoded to this size.
+    static const unsigned minimumPixelsPerImage = 512 * 512;
+
+    m_decodedImagePixels.add(image, 0);
+    setDecodedImagePixels(image, decodedPixels);
+
+    unsigned budget = settings().maximumDecodedImagePixels();
+    if (!budget)
+        return 0;
+    unsigned otherImagesPixels = m_totalDecodedImagePixels - decodedPixels;
+    return std::max(budget > otherImagesPixels ? budget - otherImagesPixels : 0, minimumPixelsPerImage);
+}
+
+void Page::setDecodedImagePixels(CachedImage* image, unsigned decodedPixels)
+{
+    HashMap<CachedImage*, unsigned>::iterator it = m_decodedImagePixels.find(image);
+    if (it == m_decodedImagePixels.end())
+        return;
+    m_totalDecodedImagePixels = m_totalDecodedImagePixels - it->value + decodedPixels;
+    it->value = decodedPixels;
+}
+
+void Page::removeDecodedImage(CachedImage* image)
+{
+    HashMap<CachedImage*, unsigned>::iterator it = m_decodedImagePixels.find(image);
+    if (it == m_decodedImagePixels.end())
+        return;
+    m_totalDecodedImagePixels -= it->value;
+    m_decodedImagePixels.remove(it);
+}
+
+void Page::resetDecodedImagePixels()
+{
+    HashMap<CachedImage*, unsigned>::iterator end = m_decodedImagePixels.end();
+    for (HashMap<CachedImage*, unsigned>::iterator it = m_decodedImagePixels.begin(); it != end; ++it)
+        it->key->pageStoppedCountingDecodedPixels(this);
+    m_decodedImagePixels.clear();
+    m_totalDecodedImagePixels = 0;
+}
+#endif
+
 PassOwnPtr<PageActivityAssertionToken> Page::createActivityToken()
 {
     return adoptPtr(new PageActivityAssertionToken(m_pageThrottler.get()));
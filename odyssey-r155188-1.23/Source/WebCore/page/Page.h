@@ -57,6 +57,7 @@ namespace WebCore {
 class AlternativeTextClient;
 class BackForwardController;
 class BackForwardList;
+class CachedImage;
 class Chrome;
 class ChromeClient;
 class ClientRectList;
@@ -393,6 +394,18 @@ public:
     void sawMediaEngine(const String& engineName);
     void resetSeenMediaEngines();
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // Splits Settings::maximumDecodedImagePixels() between the images the page
+    // draws. Starts counting the |decodedPixels| that |image| holds and returns
+    // how many it may decode to, 0 meaning no limit. The image then reports its
+    // decoded pixels until it drops its decoded frames or is destroyed. The
+    // count starts over when the main frame navigates.
+    unsigned decodedPixelsAvailableForImage(CachedImage*, unsigned decodedPixels);
+    void setDecodedImagePixels(CachedImage*, unsigned decodedPixels);
+    void removeDecodedImage(CachedImage*);
+    void resetDecodedImagePixels();
+#endif
+
     PageThrottler* pageThrottler() { return m_pageThrottler.get(); }
     PassOwnPtr<PageActivityAssertionToken> createActivityToken();
 
@@ -551,6 +564,11 @@ private:
     HashSet<String> m_seenPlugins;
     HashSet<String> m_seenMediaEngines;
 
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    HashMap<CachedImage*, unsigned> m_decodedImagePixels;
+    unsigned m_totalDecodedImagePixels;
+#endif
+
     unsigned m_lastSpatialNavigationCandidatesCount;
     unsigned m_framesHandlingBeforeUnloadEvent;
 };
@@ -25,6 +25,11 @@
 #include "NativeImageQt.h"
 #endif
 #include "NotImplemented.h"
+#if USE(CAIRO)
+#include "PlatformContextCairo.h"
+#include "RefPtrCairo.h"
+#include <cairo.h>
+#endif
 
 
 #if USE(TEXTURE_MAPPER)
@@ -42,8 +47,8 @@ void BitmapTextureImageBuffer::updateContents(const void* data, const IntRect& t
     painter->setCompositionMode(QPainter::CompositionMode_Source);
     painter->drawImage(targetRect, image, IntRect(sourceOffset, targetRect.size()));
     painter->restore();
-#elif PLATFORM(CAIRO)
-    RefPtr<cairo_surface_t> surface = adoptRef(cairo_image_surface_create_for_data(static_cast<unsigned char*>(data()),
+#elif USE(CAIRO)
+    RefPtr<cairo_surface_t> surface = adoptRef(cairo_image_surface_create_for_data(static_cast<unsigned char*>(const_cast<void*>(data)),
                                                                                    CAIRO_FORMAT_ARGB32,
                                                                                    targetRect.width(), targetRect.height(),
                                                                                    bytesPerLine));
@@ -90,6 +90,31 @@ void TextureMapperLayer::paint()
     paintRecursive(options);
 }
 
+FloatRect TextureMapperLayer::paintedBoundsIncludingDescendants()
+{
+    computeTransformsRecursive();
+
+    FloatRect bounds;
+    unitePaintedBoundsRecursive(bounds);
+    return bounds;
+}
+
+void TextureMapperLayer::unitePaintedBoundsRecursive(FloatRect& bounds)
+{
+    if (!isVisible())
+        return;
+
+    FloatRect subtreeBounds;
+    if (m_state.drawsContent || m_contentsLayer || m_state.solidColor.isValid() || m_state.showDebugBorders)
+        subtreeBounds = m_currentTransform.combined().mapRect(layerRect());
+    for (size_t i = 0; i < m_children.size(); ++i)
+        m_children[i]->unitePaintedBoundsRecursive(subtreeBounds);
+
+    bounds.unite(subtreeBounds);
+    if (m_state.replicaLayer)
+        bounds.unite(replicaTransform().mapRect(subtreeBounds));
+}
+
 static Color blendWithOpacity(const Color& color, float opacity)
 {
     RGBA32 rgba = color.rgb();
@@ -128,6 +128,11 @@ public:
 
     void paint();
 
+    // Returns the area the layers of this tree draw into, in the coordinates
+    // of the surface the tree is painted into, with the transforms and
+    // animated values the next paint() would use.
+    FloatRect paintedBoundsIncludingDescendants();
+
     void setScrollPositionDeltaIfNeeded(const FloatSize&);
 
     void applyAnimationsRecursively();
@@ -153,6 +158,7 @@ private:
     };
     void computeOverlapRegions(Region& overlapRegion, Region& nonOverlapRegion, ResolveSelfOverlapMode);
 
+    void unitePaintedBoundsRecursive(FloatRect&);
     void paintRecursive(const TextureMapperPaintOptions&);
     void paintUsingOverlapRegions(const TextureMapperPaintOptions&);
     PassRefPtr<BitmapTexture> paintIntoSurface(const TextureMapperPaintOptions&, const IntSize&);
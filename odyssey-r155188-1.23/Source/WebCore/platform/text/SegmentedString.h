@@ -290,6 +290,37 @@ public:
     // have space for at least |count| characters.
     void advance(unsigned count, UChar* consumedCharacters);
 
+    // Lets the tokenizers consume runs of 8-bit characters in bulk. Returns the
+    // characters from the current one up to, but not including, the last one
+    // of the current substring, or 0 when the 8-bit fast path is not in use.
+    const LChar* currentCharacters8(unsigned& length) const
+    {
+        if (!(m_fastPathFlags & Use8BitAdvance)) {
+            length = 0;
+            return 0;
+        }
+        ASSERT(!m_pushedChar1);
+        ASSERT(m_currentString.m_length > 1);
+        length = m_currentString.m_length - 1;
+        return m_currentString.m_data.string8Ptr;
+    }
+
+    // Advances by |count| characters from currentCharacters8(), none of
+    // which may be a newline.
+    void advancePastNonNewlines8(unsigned count)
+    {
+        ASSERT(m_fastPathFlags & Use8BitAdvance);
+        ASSERT(count < static_cast<unsigned>(m_currentString.m_length));
+        ASSERT(!memchr(m_currentString.m_data.string8Ptr, '\n', count));
+        if (!count)
+            return;
+        m_currentString.m_length -= count;
+        m_currentString.m_data.string8Ptr += count;
+        m_currentChar = *m_currentString.m_data.string8Ptr;
+        if (m_currentString.m_length == 1)
+            updateSlowCaseFunctionPointers();
+    }
+
     bool escaped() const { return m_pushedChar1; }
 
     int numberOfCharactersConsumed() const
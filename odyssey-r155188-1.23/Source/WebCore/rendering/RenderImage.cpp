@@ -34,6 +34,7 @@
 #include "FontCache.h"
 #include "Frame.h"
 #include "FrameSelection.h"
+#include "FrameView.h"
 #include "GraphicsContext.h"
 #include "HTMLAreaElement.h"
 #include "HTMLImageElement.h"
@@ -45,6 +46,7 @@
 #include "PaintInfo.h"
 #include "RenderView.h"
 #include "SVGImage.h"
+#include "Settings.h"
 #include <wtf/StackStats.h>
 
 using namespace std;
@@ -316,7 +318,42 @@ void RenderImage::notifyFinished(CachedResource* newImage)
 #else
     UNUSED_PARAM(newImage);
 #endif
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Layout will place the image first if its size changed; it is then
+    // decoded when scrolled to or painted.
+    if (!needsLayout())
+        decodeImageAsynchronouslyIfNearViewport();
+#endif
+}
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+void RenderImage::decodeImageAsynchronouslyIfNearViewport()
+{
+    if (!m_imageResource || !m_imageResource->hasImage() || m_imageResource->errorOccurred())
+        return;
+    if (!frame().settings().asynchronousImageDecodingEnabled() || document().printing())
+        return;
+
+    RefPtr<Image> image = m_imageResource->image();
+    if (!image || !image->isBitmapImage())
+        return;
+    BitmapImage* bitmapImage = static_cast<BitmapImage*>(image.get());
+    if (!bitmapImage->canDecodeAsynchronously())
+        return;
+
+    FrameView& frameView = view().frameView();
+    IntRect nearViewport = frameView.visibleContentRect();
+    nearViewport.inflateX(nearViewport.width());
+    nearViewport.inflateY(nearViewport.height());
+    IntRect contentBox = absoluteContentBox();
+    if (contentBox.isEmpty() || !contentBox.intersects(nearViewport))
+        return;
+
+    float deviceScaleFactor = frame().page() ? frame().page()->deviceScaleFactor() : 1;
+    bitmapImage->decodeAsynchronouslyIfNeeded(static_cast<double>(contentBox.width()) * contentBox.height() * deviceScaleFactor * deviceScaleFactor);
 }
+#endif
 
 void RenderImage::paintReplaced(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
 {
@@ -508,6 +545,21 @@ void RenderImage::paintIntoRect(GraphicsContext* context, const LayoutRect& rect
 #if ENABLE(CSS_IMAGE_ORIENTATION)
     orientationDescription.setImageOrientationEnum(style()->imageOrientation());
     orientationDescription.setRespectImageOrientation(shouldRespectImageOrientation());
+#endif
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Large images are decoded on the image decoding threads, usually started
+    // when their data arrived or they were scrolled near; images that showed
+    // up otherwise start here. What is known of the image is drawn until the
+    // frame is ready and the image repaints itself. Printed pages can't be
+    // repainted, so they wait for the decode.
+    if (img->isBitmapImage() && frame().settings().asynchronousImageDecodingEnabled()
+        && !context->paintingDisabled() && !document().printing()) {
+        BitmapImage* bitmapImage = static_cast<BitmapImage*>(img.get());
+        if (bitmapImage->decodeAsynchronouslyIfNeeded(context, alignedRect)) {
+            bitmapImage->drawPendingFrame(context, alignedRect, style()->colorSpace(), compositeOperator);
+            return;
+        }
+    }
 #endif
     context->drawImage(m_imageResource->image(alignedRect.width(), alignedRect.height()).get(), style()->colorSpace(), alignedRect, compositeOperator, orientationDescription, useLowQualityScaling);
 }
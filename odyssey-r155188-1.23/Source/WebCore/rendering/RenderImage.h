@@ -61,6 +61,13 @@ public:
 
     String altText() const { return m_altText; }
 
+#if ENABLE(THREADED_IMAGE_DECODING)
+    // Starts decoding a large image on the image decoding threads if it is
+    // within a viewport of the visible area, so that it is ready by the time
+    // it is painted.
+    void decodeImageAsynchronouslyIfNearViewport();
+#endif
+
 protected:
     virtual bool needsPreferredWidthsRecalculation() const OVERRIDE FINAL;
     virtual RenderBox* embeddedContentBox() const OVERRIDE FINAL;
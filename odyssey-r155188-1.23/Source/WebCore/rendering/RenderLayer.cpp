@@ -117,6 +117,11 @@
 #include "RenderLayerCompositor.h"
 #endif
 
+#if USE(DISPLAY_LISTS)
+#include "DisplayList.h"
+#include "RenderLayerCachedDisplayList.h"
+#endif
+
 #if ENABLE(SVG)
 #include "SVGNames.h"
 #endif
@@ -190,6 +195,10 @@ RenderLayer::RenderLayer(RenderLayerModelObject& rendererLayerModelObject)
 #if ENABLE(CSS_FILTERS)
     , m_hasFilterInfo(false)
 #endif
+#if USE(DISPLAY_LISTS)
+    , m_hasCachedDisplayList(false)
+    , m_onlyTransformChanged(false)
+#endif
 #if ENABLE(CSS_COMPOSITING)
     , m_blendMode(BlendModeNormal)
 #endif
@@ -259,6 +268,10 @@ RenderLayer::~RenderLayer()
     FilterInfo::remove(*this);
 #endif
 
+#if USE(DISPLAY_LISTS)
+    CachedDisplayList::remove(*this);
+#endif
+
     // Child layers will be deleted by their corresponding render objects, so
     // we don't need to delete them ourselves.
 
@@ -401,6 +414,12 @@ void RenderLayer::updateLayerPositionsAfterLayout(const RenderLayer* rootLayer,
 
 void RenderLayer::updateLayerPositions(RenderGeometryMap* geometryMap, UpdateLayerPositionsFlags flags)
 {
+#if USE(DISPLAY_LISTS)
+    bool onlyTransformChanged = m_onlyTransformChanged;
+    m_onlyTransformChanged = false;
+    DisplayListPreservingRepaints preserveDisplayLists(onlyTransformChanged);
+#endif
+
     updateLayerPosition(); // For relpositioned layers or non-positioned layers,
                            // we need to keep in sync, since we may have shifted relative
                            // to our parent layer.
@@ -446,6 +465,12 @@ void RenderLayer::updateLayerPositions(RenderGeometryMap* geometryMap, UpdateLay
         // as the value not using the cached offset, but we can't due to https://bugs.webkit.org/show_bug.cgi?id=37048
         if (flags & CheckForRepaint) {
             if (!renderer().view().printing()) {
+#if USE(DISPLAY_LISTS)
+                // A layer laid out or moved within a layer whose transform
+                // changed still changes what the latter paints.
+                if (repaintsPreserveDisplayLists() && !onlyTransformChanged && m_repaintStatus != NeedsNormalRepaint)
+                    invalidateDisplayLists();
+#endif
                 if (m_repaintStatus & NeedsFullRepaint) {
                     renderer().repaintUsingContainer(repaintContainer, pixelSnappedIntRect(oldRepaintRect));
                     if (m_repaintRect != oldRepaintRect)
@@ -4015,9 +4040,89 @@ void RenderLayer::paintLayerByApplyingTransform(GraphicsContext* context, const
     // Now do a paint with the root layer shifted to be us.
     LayerPaintingInfo transformedPaintingInfo(this, enclosingIntRect(transform.inverse().mapRect(paintingInfo.paintDirtyRect)), paintingInfo.paintBehavior,
         adjustedSubPixelAccumulation, paintingInfo.subtreePaintRoot, paintingInfo.region, paintingInfo.overlapTestRequests);
+#if USE(DISPLAY_LISTS)
+    if (paintLayerContentsWithDisplayList(context, transformedPaintingInfo, paintFlags))
+        return;
+#endif
     paintLayerContentsAndReflection(context, transformedPaintingInfo, paintFlags);
 }
 
+#if USE(DISPLAY_LISTS)
+
+// Larger layers are rarely fully in view, and recording all of them would
+// cost more than painting the dirty rect directly.
+static const int maximumDisplayListSize = 2048;
+
+bool RenderLayer::canCacheDisplayList(GraphicsContext* context, const LayerPaintingInfo& paintingInfo) const
+{
+    if (context->paintingDisabled() || context->updatingControlTints())
+        return false;
+
+    if (paintingInfo.paintBehavior != PaintBehaviorNormal || paintingInfo.subtreePaintRoot || paintingInfo.region)
+        return false;
+
+    if (!renderer().frame().settings().layerDisplayListCachingEnabled())
+        return false;
+
+    if (renderer().view().printing() || enclosingPaginationLayer() || m_reflection)
+        return false;
+
+#if ENABLE(CSS_FILTERS)
+    if (paintsWithFilters())
+        return false;
+#endif
+
+    // Fixed backgrounds are painted relative to the viewport, which scrolls
+    // without repainting the layer.
+    return !renderer().view().frameView().hasSlowRepaintObjects();
+}
+
+static bool containsWidgets(const RenderObject& renderer)
+{
+    for (const RenderObject* descendant = renderer.firstChild(); descendant; descendant = descendant->nextInPreOrder(&renderer)) {
+        if (descendant->isWidget())
+            return true;
+    }
+    return false;
+}
+
+bool RenderLayer::paintLayerContentsWithDisplayList(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
+{
+    if (!canCacheDisplayList(context, paintingInfo))
+        return false;
+
+    RefPtr<DisplayList> displayList = CachedDisplayList::get(*this, paintFlags, paintingInfo.subPixelAccumulation);
+    if (!displayList) {
+        // Record everything the layer and its descendants paint, in the
+        // coordinates of the layer, so that the list can be replayed for any
+        // later dirty rect and transform.
+        IntRect bounds = enclosingIntRect(calculateLayerBounds(this, 0, DefaultCalculateLayerBoundsFlags & ~IncludeSelfTransform));
+        if (bounds.isEmpty() || bounds.width() > maximumDisplayListSize || bounds.height() > maximumDisplayListSize)
+            return false;
+
+        // Frames and plug-ins invalidate and scroll their content without
+        // going through the render tree.
+        if (containsWidgets(renderer()))
+            return false;
+
+        displayList = DisplayList::create(bounds);
+        // Cached before recording, so that a repaint made while painting
+        // drops it again.
+        CachedDisplayList::set(*this, displayList, paintFlags, paintingInfo.subPixelAccumulation);
+
+        LayerPaintingInfo recordingPaintingInfo(this, bounds, paintingInfo.paintBehavior, paintingInfo.subPixelAccumulation);
+        paintLayerContentsAndReflection(displayList->beginRecording(), recordingPaintingInfo, paintFlags);
+        displayList->endRecording();
+    }
+
+    GraphicsContextStateSaver stateSaver(*context);
+    context->clip(pixelSnappedIntRect(paintingInfo.paintDirtyRect));
+    displayList->replay(context);
+    return true;
+}
+
+#endif
+
 void RenderLayer::paintList(Vector<RenderLayer*>* list, GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
 {
     if (!list)
@@ -5890,6 +5995,33 @@ void RenderLayer::repaintIncludingDescendants()
         curr->repaintIncludingDescendants();
 }
 
+#if USE(DISPLAY_LISTS)
+
+bool RenderLayer::s_repaintsPreserveDisplayLists = false;
+
+bool RenderLayer::hasCachedDisplayLists()
+{
+    return !CachedDisplayList::isEmpty();
+}
+
+void RenderLayer::invalidateDisplayLists()
+{
+    for (RenderLayer* layer = this; layer; layer = layer->parent()) {
+        if (layer->m_hasCachedDisplayList)
+            CachedDisplayList::remove(*layer);
+    }
+}
+
+void RenderLayer::invalidateDisplayListsIncludingDescendants()
+{
+    if (m_hasCachedDisplayList)
+        CachedDisplayList::remove(*this);
+    for (RenderLayer* curr = firstChild(); curr; curr = curr->nextSibling())
+        curr->invalidateDisplayListsIncludingDescendants();
+}
+
+#endif
+
 #if USE(ACCELERATED_COMPOSITING)
 
 void RenderLayer::setBackingNeedsRepaint()
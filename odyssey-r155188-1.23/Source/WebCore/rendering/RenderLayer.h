@@ -48,6 +48,7 @@
 #include "RenderBox.h"
 #include "ScrollableArea.h"
 #include <wtf/OwnPtr.h>
+#include <wtf/TemporaryChange.h>
 
 namespace WebCore {
 
@@ -333,6 +334,32 @@ public:
 
     void repaintIncludingDescendants();
 
+#if USE(DISPLAY_LISTS)
+    // Drops the display lists recorded for this layer and for the layers it
+    // is painted into, as what it paints changed.
+    void invalidateDisplayLists();
+    void invalidateDisplayListsIncludingDescendants();
+    static bool hasCachedDisplayLists();
+
+    // Called before the style of the renderer changes. A change of transform
+    // alone moves what the layer paints without changing it, so the repaints
+    // it causes for the layer and its descendants keep their display lists.
+    void setOnlyTransformChanged(bool onlyTransformChanged) { m_onlyTransformChanged = onlyTransformChanged; }
+
+    // Repaints made while an instance is alive move content without changing it.
+    class DisplayListPreservingRepaints {
+        WTF_MAKE_NONCOPYABLE(DisplayListPreservingRepaints);
+    public:
+        explicit DisplayListPreservingRepaints(bool preserve = true)
+            : m_change(s_repaintsPreserveDisplayLists, s_repaintsPreserveDisplayLists || preserve)
+        {
+        }
+    private:
+        TemporaryChange<bool> m_change;
+    };
+    static bool repaintsPreserveDisplayLists() { return s_repaintsPreserveDisplayLists; }
+#endif
+
 #if USE(ACCELERATED_COMPOSITING)
     // Indicate that the layer contents need to be repainted. Only has an effect
     // if layer compositing is being used,
@@ -935,6 +962,10 @@ private:
     void paintLayerContentsAndReflection(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerByApplyingTransform(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags, const LayoutPoint& translationOffset = LayoutPoint());
     void paintLayerContents(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
+#if USE(DISPLAY_LISTS)
+    bool canCacheDisplayList(GraphicsContext*, const LayerPaintingInfo&) const;
+    bool paintLayerContentsWithDisplayList(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
+#endif
     void paintList(Vector<RenderLayer*>*, GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintPaginatedChildLayer(RenderLayer* childLayer, GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintChildLayerIntoColumns(RenderLayer* childLayer, GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags, const Vector<RenderLayer*>& columnLayers, size_t columnIndex);
@@ -1198,6 +1229,11 @@ private:
     bool m_hasFilterInfo : 1;
 #endif
 
+#if USE(DISPLAY_LISTS)
+    bool m_hasCachedDisplayList : 1;
+    bool m_onlyTransformChanged : 1;
+#endif
+
 #if ENABLE(CSS_COMPOSITING)
     BlendMode m_blendMode;
 #endif
@@ -1272,6 +1308,11 @@ private:
 #endif
 
     class FilterInfo;
+
+#if USE(DISPLAY_LISTS)
+    class CachedDisplayList;
+    static bool s_repaintsPreserveDisplayLists;
+#endif
 };
 
 inline void RenderLayer::clearZOrderLists()
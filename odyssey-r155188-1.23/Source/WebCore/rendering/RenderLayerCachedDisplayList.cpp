@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if USE(DISPLAY_LISTS)
+#include "RenderLayerCachedDisplayList.h"
+
+#include <wtf/NeverDestroyed.h>
+
+namespace WebCore {
+
+// Recorded commands keep snapshots of the images they draw, so only the
+// layers painted most recently keep their lists.
+static const int maximumCachedDisplayLists = 32;
+
+HashMap<const RenderLayer*, OwnPtr<RenderLayer::CachedDisplayList>>& RenderLayer::CachedDisplayList::map()
+{
+    static NeverDestroyed<HashMap<const RenderLayer*, OwnPtr<CachedDisplayList>>> map;
+    return map;
+}
+
+ListHashSet<RenderLayer*>& RenderLayer::CachedDisplayList::recentlyUsed()
+{
+    static NeverDestroyed<ListHashSet<RenderLayer*>> recentlyUsed;
+    return recentlyUsed;
+}
+
+RenderLayer::CachedDisplayList::CachedDisplayList(PassRefPtr<DisplayList> displayList, PaintLayerFlags paintFlags, const LayoutSize& subPixelAccumulation)
+    : m_displayList(displayList)
+    , m_paintFlags(paintFlags)
+    , m_subPixelAccumulation(subPixelAccumulation)
+{
+}
+
+DisplayList* RenderLayer::CachedDisplayList::get(const RenderLayer& layer, PaintLayerFlags paintFlags, const LayoutSize& subPixelAccumulation)
+{
+    ASSERT(layer.m_hasCachedDisplayList == map().contains(&layer));
+
+    if (!layer.m_hasCachedDisplayList)
+        return 0;
+
+    CachedDisplayList* cached = map().get(&layer);
+    if (cached->m_paintFlags != paintFlags || cached->m_subPixelAccumulation != subPixelAccumulation)
+        return 0;
+
+    RenderLayer* mutableLayer = const_cast<RenderLayer*>(&layer);
+    recentlyUsed().remove(mutableLayer);
+    recentlyUsed().add(mutableLayer);
+    return cached->m_displayList.get();
+}
+
+void RenderLayer::CachedDisplayList::set(RenderLayer& layer, PassRefPtr<DisplayList> displayList, PaintLayerFlags paintFlags, const LayoutSize& subPixelAccumulation)
+{
+    ASSERT(layer.m_hasCachedDisplayList == map().contains(&layer));
+
+    map().set(&layer, adoptPtr(new CachedDisplayList(displayList, paintFlags, subPixelAccumulation)));
+    layer.m_hasCachedDisplayList = true;
+    recentlyUsed().remove(&layer);
+    recentlyUsed().add(&layer);
+
+    while (map().size() > maximumCachedDisplayLists)
+        remove(*recentlyUsed().first());
+}
+
+void RenderLayer::CachedDisplayList::remove(RenderLayer& layer)
+{
+    ASSERT(layer.m_hasCachedDisplayList == map().contains(&layer));
+
+    if (!map().remove(&layer))
+        return;
+    layer.m_hasCachedDisplayList = false;
+    recentlyUsed().remove(&layer);
+}
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LISTS)
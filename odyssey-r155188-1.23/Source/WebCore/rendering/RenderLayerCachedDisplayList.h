@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY FABIEN COEURJOLY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL FABIEN COEURJOLY OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RenderLayerCachedDisplayList_h
+#define RenderLayerCachedDisplayList_h
+
+#if USE(DISPLAY_LISTS)
+
+#include "DisplayList.h"
+#include "RenderLayer.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+
+namespace WebCore {
+
+// The drawing commands of a transformed layer and its descendants, recorded
+// in the coordinates of the layer, so that they can be replayed under any
+// transform of the layer and for any dirty rect until its content changes.
+// The number of cached lists is bounded; the least recently painted one is
+// dropped first.
+class RenderLayer::CachedDisplayList {
+    WTF_MAKE_NONCOPYABLE(CachedDisplayList); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns the list recorded for the layer with the same paint flags and
+    // sub-pixel offset, if any, and marks it as the most recently used one.
+    static DisplayList* get(const RenderLayer&, PaintLayerFlags, const LayoutSize& subPixelAccumulation);
+    static void set(RenderLayer&, PassRefPtr<DisplayList>, PaintLayerFlags, const LayoutSize& subPixelAccumulation);
+    static void remove(RenderLayer&);
+
+    static bool isEmpty() { return map().isEmpty(); }
+
+private:
+    CachedDisplayList(PassRefPtr<DisplayList>, PaintLayerFlags, const LayoutSize&);
+
+    static HashMap<const RenderLayer*, OwnPtr<CachedDisplayList>>& map();
+    static ListHashSet<RenderLayer*>& recentlyUsed(); // Least recently used first.
+
+    RefPtr<DisplayList> m_displayList;
+    PaintLayerFlags m_paintFlags;
+    LayoutSize m_subPixelAccumulation;
+};
+
+} // namespace WebCore
+
+#endif // USE(DISPLAY_LISTS)
+
+#endif // RenderLayerCachedDisplayList_h
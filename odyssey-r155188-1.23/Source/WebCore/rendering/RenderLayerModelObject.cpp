@@ -84,6 +84,19 @@ void RenderLayerModelObject::willBeDestroyed()
     RenderObject::willBeDestroyed();
 }
 
+#if USE(DISPLAY_LISTS)
+static bool onlyTransformDiffers(const RenderStyle* oldStyle, const RenderStyle* newStyle)
+{
+    if (oldStyle->transform() == newStyle->transform())
+        return false;
+
+    RefPtr<RenderStyle> styleWithOldTransform = RenderStyle::clone(newStyle);
+    styleWithOldTransform->setTransform(oldStyle->transform());
+    unsigned changedContextSensitiveProperties = ContextSensitivePropertyNone;
+    return styleWithOldTransform->diff(oldStyle, changedContextSensitiveProperties) == StyleDifferenceEqual;
+}
+#endif
+
 void RenderLayerModelObject::styleWillChange(StyleDifference diff, const RenderStyle* newStyle)
 {
     s_wasFloating = isFloating();
@@ -95,6 +108,12 @@ void RenderLayerModelObject::styleWillChange(StyleDifference diff, const RenderS
     // If our z-index changes value or our visibility changes,
     // we need to dirty our stacking context's z-order list.
     RenderStyle* oldStyle = style();
+
+#if USE(DISPLAY_LISTS)
+    bool onlyTransformChanged = s_hadLayer && oldStyle && newStyle && RenderLayer::hasCachedDisplayLists() && onlyTransformDiffers(oldStyle, newStyle);
+    if (s_hadLayer)
+        layer()->setOnlyTransformChanged(onlyTransformChanged);
+#endif
     if (oldStyle && newStyle) {
         if (parent()) {
             // Do a repaint with the old style first, e.g., for example if we go from
@@ -121,8 +140,12 @@ void RenderLayerModelObject::styleWillChange(StyleDifference diff, const RenderS
 #if ENABLE(CSS_FILTERS)
                     || oldStyle->filter() != newStyle->filter()
 #endif
-                    )
-                layer()->repaintIncludingDescendants();
+                    ) {
+#if USE(DISPLAY_LISTS)
+                    RenderLayer::DisplayListPreservingRepaints preserveDisplayLists(onlyTransformChanged);
+#endif
+                    layer()->repaintIncludingDescendants();
+                }
             } else if (newStyle->hasTransform() || newStyle->opacity() < 1 || newStyle->hasFilter()) {
                 // If we don't have a layer yet, but we are going to get one because of transform or opacity,
                 //  then we need to repaint the old position of the object.
@@ -1353,6 +1353,13 @@ RenderLayerModelObject* RenderObject::containerForRepaint() const
 
 void RenderObject::repaintUsingContainer(const RenderLayerModelObject* repaintContainer, const IntRect& r, bool immediate) const
 {
+#if USE(DISPLAY_LISTS)
+    if (RenderLayer::hasCachedDisplayLists() && !RenderLayer::repaintsPreserveDisplayLists()) {
+        if (RenderLayer* layer = enclosingLayer())
+            layer->invalidateDisplayLists();
+    }
+#endif
+
     if (!repaintContainer) {
         view().repaintViewRectangle(r, immediate);
         return;
@@ -3026,7 +3033,18 @@ bool RenderObject::willRenderImage(CachedImage*)
 
     // If we're not in a window (i.e., we're dormant from being put in the b/f cache or in a background tab)
     // then we don't want to render either.
-    return !document().inPageCache() && !document().view()->isOffscreen();
+    if (document().inPageCache() || document().view()->isOffscreen())
+        return false;
+
+    // Nor if we're scrolled out of view. Painting the image once it is scrolled
+    // back in resumes its animation. Scrolling over tiles that are already
+    // rasterized paints nothing, so keep animating while the page is tiled.
+#if USE(TILED_BACKING_STORE)
+    if (frame().page() && frame().page()->mainFrame().tiledBackingStore())
+        return true;
+#endif
+    LayoutRect visibleRect = view().frameView().visibleContentRect();
+    return visibleRect.intersects(absoluteClippedOverflowRect());
 }
 
 int RenderObject::maximalOutlineSize(PaintPhase p) const
@@ -542,6 +542,12 @@ bool RenderView::shouldRepaint(const LayoutRect& r) const
 
 void RenderView::repaintRootContents()
 {
+#if USE(DISPLAY_LISTS)
+    // Renderers do not repaint themselves while the whole view is repainted.
+    if (RenderLayer::hasCachedDisplayLists())
+        layer()->invalidateDisplayListsIncludingDescendants();
+#endif
+
 #if USE(ACCELERATED_COMPOSITING)
     if (layer()->isComposited()) {
         layer()->setBackingNeedsRepaint();
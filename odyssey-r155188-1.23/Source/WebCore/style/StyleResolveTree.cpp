@@ -585,6 +585,7 @@ static Change resolveLocal(Element& current, Change inheritedChange)
     RefPtr<RenderStyle> currentStyle = current.renderStyle();
 
     Document& document = current.document();
+    document.didResolveElementStyle();
     if (currentStyle) {
         newStyle = current.styleForRenderer();
         localChange = determineChange(currentStyle.get(), newStyle.get(), document.settings());
@@ -85,6 +85,9 @@ InternalSettings::Backup::Backup(Settings& settings)
     , m_originalMediaTypeOverride(settings.mediaTypeOverride())
     , m_originalCanvasUsesAcceleratedDrawing(settings.canvasUsesAcceleratedDrawing())
     , m_originalMockScrollbarsEnabled(settings.mockScrollbarsEnabled())
+    , m_originalTiledBackingStoreEnabled(settings.tiledBackingStoreEnabled())
+    , m_originalLayerDisplayListCachingEnabled(settings.layerDisplayListCachingEnabled())
+    , m_originalAcceleratedCompositingEnabled(settings.acceleratedCompositingEnabled())
     , m_langAttributeAwareFormControlUIEnabled(RuntimeEnabledFeatures::langAttributeAwareFormControlUIEnabled())
     , m_imagesEnabled(settings.areImagesEnabled())
     , m_minimumTimerInterval(settings.minDOMTimerInterval())
@@ -120,6 +123,9 @@ void InternalSettings::Backup::restoreTo(Settings& settings)
     settings.setMediaTypeOverride(m_originalMediaTypeOverride);
     settings.setCanvasUsesAcceleratedDrawing(m_originalCanvasUsesAcceleratedDrawing);
     settings.setMockScrollbarsEnabled(m_originalMockScrollbarsEnabled);
+    settings.setTiledBackingStoreEnabled(m_originalTiledBackingStoreEnabled);
+    settings.setLayerDisplayListCachingEnabled(m_originalLayerDisplayListCachingEnabled);
+    settings.setAcceleratedCompositingEnabled(m_originalAcceleratedCompositingEnabled);
     RuntimeEnabledFeatures::setLangAttributeAwareFormControlUIEnabled(m_langAttributeAwareFormControlUIEnabled);
     settings.setImagesEnabled(m_imagesEnabled);
     settings.setMinDOMTimerInterval(m_minimumTimerInterval);
@@ -197,6 +203,24 @@ void InternalSettings::setMockScrollbarsEnabled(bool enabled, ExceptionCode& ec)
     settings()->setMockScrollbarsEnabled(enabled);
 }
 
+void InternalSettings::setTiledBackingStoreEnabled(bool enabled, ExceptionCode& ec)
+{
+    InternalSettingsGuardForSettings();
+    settings()->setTiledBackingStoreEnabled(enabled);
+}
+
+void InternalSettings::setLayerDisplayListCachingEnabled(bool enabled, ExceptionCode& ec)
+{
+    InternalSettingsGuardForSettings();
+    settings()->setLayerDisplayListCachingEnabled(enabled);
+}
+
+void InternalSettings::setAcceleratedCompositingEnabled(bool enabled, ExceptionCode& ec)
+{
+    InternalSettingsGuardForSettings();
+    settings()->setAcceleratedCompositingEnabled(enabled);
+}
+
 static bool urlIsWhitelistedForSetShadowDOMEnabled(const String& url)
 {
     // This check is just for preventing fuzzers from crashing because of unintended API calls.
@@ -69,6 +69,9 @@ public:
         String m_originalMediaTypeOverride;
         bool m_originalCanvasUsesAcceleratedDrawing;
         bool m_originalMockScrollbarsEnabled;
+        bool m_originalTiledBackingStoreEnabled;
+        bool m_originalLayerDisplayListCachingEnabled;
+        bool m_originalAcceleratedCompositingEnabled;
         bool m_originalUsesOverlayScrollbars;
         bool m_langAttributeAwareFormControlUIEnabled;
         bool m_imagesEnabled;
@@ -97,6 +100,9 @@ public:
     void setUsesOverlayScrollbars(bool enabled, ExceptionCode&);
     void setTouchEventEmulationEnabled(bool enabled, ExceptionCode&);
     void setShadowDOMEnabled(bool enabled, ExceptionCode&);
+    void setTiledBackingStoreEnabled(bool enabled, ExceptionCode&);
+    void setLayerDisplayListCachingEnabled(bool enabled, ExceptionCode&);
+    void setAcceleratedCompositingEnabled(bool enabled, ExceptionCode&);
     void setAuthorShadowDOMForAnyElementEnabled(bool);
     void setStyleScopedEnabled(bool);
     void setStandardFontFamily(const String& family, const String& script, ExceptionCode&);
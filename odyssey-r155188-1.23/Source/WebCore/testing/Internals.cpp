@@ -29,11 +29,16 @@
 
 #include "AnimationController.h"
 #include "BackForwardController.h"
+#include "BitmapImage.h"
+#include "CSSParser.h"
+#include "CSSSelectorList.h"
+#include "CachedImage.h"
 #include "CachedResourceLoader.h"
 #include "Chrome.h"
 #include "ChromeClient.h"
 #include "ClientRect.h"
 #include "ClientRectList.h"
+#include "CompiledSelector.h"
 #include "ComposedShadowTreeWalker.h"
 #include "ContentDistributor.h"
 #include "Cursor.h"
@@ -51,6 +56,7 @@
 #include "FrameLoader.h"
 #include "FrameView.h"
 #include "HTMLContentElement.h"
+#include "HTMLImageElement.h"
 #include "HTMLInputElement.h"
 #include "HTMLNames.h"
 #include "HTMLSelectElement.h"
@@ -85,8 +91,11 @@
 #include "RuntimeEnabledFeatures.h"
 #include "SchemeRegistry.h"
 #include "ScrollingCoordinator.h"
+#include "SelectorChecker.h"
+#include "SelectorQuery.h"
 #include "SerializedScriptValue.h"
 #include "Settings.h"
+#include "SharedBuffer.h"
 #include "ShadowRoot.h"
 #include "SpellChecker.h"
 #include "StaticNodeList.h"  
@@ -126,6 +135,10 @@
 #include <wtf/dtoa.h>
 #endif
 
+#if USE(CAIRO)
+#include "ScaledImageCache.h"
+#endif
+
 #if ENABLE(ENCRYPTED_MEDIA_V2)
 #include "CDM.h"
 #include "MockCDM.h"
@@ -1234,6 +1247,196 @@ unsigned Internals::touchEventHandlerCount(Document* document, ExceptionCode& ec
     return count;
 }
 
+unsigned Internals::styleRecalcElementCount(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->styleRecalcElementCount();
+}
+
+unsigned Internals::selectorQueryResultCacheLookupCount(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->selectorQueryCache().resultCacheStatistics().lookups;
+}
+
+unsigned Internals::selectorQueryResultCacheHitCount(Document* document, ExceptionCode& ec)
+{
+    if (!document) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    return document->selectorQueryCache().resultCacheStatistics().hits;
+}
+
+static bool parseSelectorForElement(Element* element, const String& selector, CSSSelectorList& selectorList, ExceptionCode& ec)
+{
+    if (!element) {
+        ec = INVALID_ACCESS_ERR;
+        return false;
+    }
+
+    CSSParser parser(&element->document());
+    parser.parseSelector(selector, selectorList);
+    if (!selectorList.first() || selectorList.hasInvalidSelector()) {
+        ec = SYNTAX_ERR;
+        return false;
+    }
+    return true;
+}
+
+bool Internals::selectorMatchesInterpreted(Element* element, const String& selector, ExceptionCode& ec)
+{
+    CSSSelectorList selectorList;
+    if (!parseSelectorForElement(element, selector, selectorList, ec))
+        return false;
+
+    SelectorChecker selectorChecker(element->document(), SelectorChecker::QueryingRules);
+    for (const CSSSelector* current = selectorList.first(); current; current = CSSSelectorList::next(current)) {
+        SelectorChecker::SelectorCheckingContext context(current, element, SelectorChecker::VisitedMatchEnabled);
+        PseudoId ignoreDynamicPseudo = NOPSEUDO;
+        if (selectorChecker.match(context, ignoreDynamicPseudo) == SelectorChecker::SelectorMatches && ignoreDynamicPseudo == NOPSEUDO)
+            return true;
+    }
+    return false;
+}
+
+bool Internals::selectorMatchesCompiled(Element* element, const String& selector, ExceptionCode& ec)
+{
+    CSSSelectorList selectorList;
+    if (!parseSelectorForElement(element, selector, selectorList, ec))
+        return false;
+
+    bool matches = false;
+    for (const CSSSelector* current = selectorList.first(); current; current = CSSSelectorList::next(current)) {
+        OwnPtr<CompiledSelector> compiledSelector = CompiledSelector::compile(current);
+        if (!compiledSelector) {
+            ec = NOT_SUPPORTED_ERR;
+            return false;
+        }
+        matches = matches || compiledSelector->matches(element, 0, SelectorChecker::QueryingRules);
+    }
+    return matches;
+}
+
+void Internals::setElementHovered(Element* element, bool hovered, ExceptionCode& ec)
+{
+    if (!element) {
+        ec = INVALID_ACCESS_ERR;
+        return;
+    }
+    element->setHovered(hovered);
+}
+
+void Internals::setElementActive(Element* element, bool active, ExceptionCode& ec)
+{
+    if (!element) {
+        ec = INVALID_ACCESS_ERR;
+        return;
+    }
+    element->setActive(active);
+}
+
+unsigned Internals::scaledImageCacheLookupCount() const
+{
+#if USE(CAIRO)
+    return ScaledImageCache::shared().statistics().lookups;
+#else
+    return 0;
+#endif
+}
+
+unsigned Internals::scaledImageCacheHitCount() const
+{
+#if USE(CAIRO)
+    return ScaledImageCache::shared().statistics().hits;
+#else
+    return 0;
+#endif
+}
+
+double Internals::scaledImageCacheResampleTimeSaved() const
+{
+#if USE(CAIRO)
+    return ScaledImageCache::shared().statistics().resampleTimeSaved * 1000;
+#else
+    return 0;
+#endif
+}
+
+static BitmapImage* bitmapImageForElement(Element* element)
+{
+    if (!element || !element->hasTagName(imgTag))
+        return 0;
+    CachedImage* cachedImage = static_cast<HTMLImageElement*>(element)->cachedImage();
+    if (!cachedImage || !cachedImage->image()->isBitmapImage())
+        return 0;
+    return static_cast<BitmapImage*>(cachedImage->image());
+}
+
+unsigned Internals::imageDecodedSize(Element* element, ExceptionCode& ec)
+{
+    BitmapImage* image = bitmapImageForElement(element);
+    if (!image) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+    return image->decodedSize();
+}
+
+double Internals::imageFrameDecodeWallTime(Element* element, ExceptionCode& ec)
+{
+    BitmapImage* image = bitmapImageForElement(element);
+    if (!image) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+    return image->frameDecodeWallTime() * 1000;
+}
+
+double Internals::imageTimeToFirstPixels(Element* element, ExceptionCode& ec)
+{
+    BitmapImage* image = bitmapImageForElement(element);
+    if (!image) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+    return image->timeToFirstPixels() * 1000;
+}
+
+double Internals::replayImageLoad(Element* element, unsigned chunkSize, ExceptionCode& ec)
+{
+    BitmapImage* image = bitmapImageForElement(element);
+    if (!image || !image->data() || !chunkSize) {
+        ec = INVALID_ACCESS_ERR;
+        return 0;
+    }
+
+    // Hands a new image the encoded data a chunk at a time, as a slow load
+    // would, and decodes what it has after each chunk, as a paint would.
+    SharedBuffer* encodedData = image->data();
+    RefPtr<SharedBuffer> data = SharedBuffer::create();
+    RefPtr<BitmapImage> replay = BitmapImage::create();
+    unsigned offset = 0;
+    while (offset < encodedData->size()) {
+        const char* segment;
+        unsigned length = std::min(encodedData->getSomeData(segment, offset), chunkSize);
+        data->append(segment, length);
+        offset += length;
+        replay->setData(data, offset == encodedData->size());
+        replay->nativeImageForCurrentFrame();
+    }
+    return replay->timeToFirstPixels() * 1000;
+}
+
 #if ENABLE(TOUCH_EVENT_TRACKING)
 PassRefPtr<ClientRectList> Internals::touchEventTargetClientRects(Document* document, ExceptionCode& ec)
 {
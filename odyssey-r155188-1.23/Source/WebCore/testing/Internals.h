@@ -182,6 +182,22 @@ public:
 
     unsigned wheelEventHandlerCount(Document*, ExceptionCode&);
     unsigned touchEventHandlerCount(Document*, ExceptionCode&);
+    unsigned styleRecalcElementCount(Document*, ExceptionCode&);
+    unsigned selectorQueryResultCacheLookupCount(Document*, ExceptionCode&);
+    unsigned selectorQueryResultCacheHitCount(Document*, ExceptionCode&);
+    // Whether a selector in |selector| matches |element|, checked by SelectorChecker or by
+    // CompiledSelector. The latter raises NOT_SUPPORTED_ERR if a selector cannot be compiled.
+    bool selectorMatchesInterpreted(Element*, const String& selector, ExceptionCode&);
+    bool selectorMatchesCompiled(Element*, const String& selector, ExceptionCode&);
+    void setElementHovered(Element*, bool hovered, ExceptionCode&);
+    void setElementActive(Element*, bool active, ExceptionCode&);
+    unsigned scaledImageCacheLookupCount() const;
+    unsigned scaledImageCacheHitCount() const;
+    double scaledImageCacheResampleTimeSaved() const; // In milliseconds.
+    unsigned imageDecodedSize(Element*, ExceptionCode&);
+    double imageFrameDecodeWallTime(Element*, ExceptionCode&); // In milliseconds.
+    double imageTimeToFirstPixels(Element*, ExceptionCode&); // In milliseconds.
+    double replayImageLoad(Element*, unsigned chunkSize, ExceptionCode&); // Time to first pixels, in milliseconds.
 #if ENABLE(TOUCH_EVENT_TRACKING)
     PassRefPtr<ClientRectList> touchEventTargetClientRects(Document*, ExceptionCode&);
 #endif
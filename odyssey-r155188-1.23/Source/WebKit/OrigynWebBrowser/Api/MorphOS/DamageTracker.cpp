@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "DamageTracker.h"
+
+namespace WebCore {
+
+// What painting and blitting one more rect costs, counted in pixels: walking
+// the render tree, setting up the clip and one MUI redraw.
+static const int64_t fixedCostPerRect = 128 * 128;
+
+// More rects than this are always merged, however much they waste.
+static const size_t maximumRects = 16;
+
+// Each merge compares every pair of rects: damage more fragmented than this
+// is painted as its bounds.
+static const size_t maximumRectsToMerge = 64;
+
+static inline int64_t rectArea(const IntRect& rect)
+{
+    return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+void DamageTracker::add(const IntRect& rect)
+{
+    if (rect.isEmpty())
+        return;
+    m_region.unite(Region(rect));
+}
+
+Vector<IntRect> DamageTracker::takeRects()
+{
+    Vector<IntRect> rects = m_region.rects();
+    IntRect bounds = m_region.bounds();
+    clear();
+
+    if (rects.size() > maximumRectsToMerge) {
+        rects.clear();
+        rects.append(bounds);
+        return rects;
+    }
+
+    // Merge the pair that paints the fewest pixels that are not damaged, as
+    // long as those cost less than painting the rects apart.
+    while (rects.size() > 1) {
+        size_t first = 0;
+        size_t second = 1;
+        int64_t leastWaste = -1;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                int64_t waste = rectArea(unionRect(rects[i], rects[j])) - rectArea(rects[i]) - rectArea(rects[j]) + rectArea(intersection(rects[i], rects[j]));
+                if (leastWaste < 0 || waste < leastWaste) {
+                    leastWaste = waste;
+                    first = i;
+                    second = j;
+                }
+            }
+        }
+
+        if (leastWaste > fixedCostPerRect && rects.size() <= maximumRects)
+            break;
+
+        rects[first].unite(rects[second]);
+        rects.remove(second);
+    }
+
+    return rects;
+}
+
+} // namespace WebCore
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef DamageTracker_h
+#define DamageTracker_h
+
+#include "IntRect.h"
+#include "Region.h"
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// The parts of the view that must be painted and blitted again.
+//
+// Damage is kept exactly, as a Region, until it is painted. It is then handed
+// out as a few rects: painting and blitting a rect has a fixed cost on top of
+// the cost of its pixels, so close rects are merged when the pixels painted
+// in between cost less than painting them apart.
+class DamageTracker {
+public:
+    void add(const IntRect&);
+    void translate(const IntSize& delta) { m_region.translate(delta); }
+    void clear() { m_region = Region(); }
+
+    bool isEmpty() const { return m_region.isEmpty(); }
+    IntRect bounds() const { return m_region.bounds(); }
+    unsigned area() const { return m_region.totalArea(); }
+    size_t rectCount() const { return m_region.rects().size(); }
+
+    // Returns the rects to paint and blit, and clears the damage.
+    Vector<IntRect> takeRects();
+
+private:
+    Region m_region;
+};
+
+} // namespace WebCore
+
+#endif // DamageTracker_h
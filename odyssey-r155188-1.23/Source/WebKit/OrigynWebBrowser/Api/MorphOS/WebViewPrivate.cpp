@@ -60,6 +60,7 @@
 #include "Page.h"
 #include "PageCache.h"
 #include "PageGroup.h"
+#include "Path.h"
 #include "PopupMenu.h"
 #include "ProgressTracker.h"
 #include "PlatformKeyboardEvent.h"
@@ -69,6 +70,10 @@
 #include "Scrollbar.h"
 #include "Settings.h"
 #include "SharedTimer.h"
+#include "StyleSheetContentsCache.h"
+#if USE(TILED_BACKING_STORE)
+#include "TiledBackingStore.h"
+#endif
 #include "TopSitesManager.h"
 #include "WebDocumentLoader.h"
 #include "WebError.h"
@@ -698,6 +703,12 @@ WebViewPrivate::WebViewPrivate(WebView *webView)
     : m_webView(webView)
     , isInitialized(false)
 	, m_closeWindowTimer(this, &WebViewPrivate::closeWindowTimerFired)
+#if USE(TILED_BACKING_STORE)
+	, m_scrollEndTimer(this, &WebViewPrivate::scrollEndTimerFired)
+#endif
+#if USE(ACCELERATED_COMPOSITING)
+	, m_acceleratedCompositingContext(AcceleratedCompositingContext::create(webView))
+#endif
 {
 	webView->setWebNotificationDelegate(MorphOSWebNotificationDelegate::createInstance());
 	webView->setJSActionDelegate(MorphOSJSActionDelegate::createInstance());
@@ -735,100 +746,112 @@ BalRectangle WebViewPrivate::onExpose(BalEventExpose event)
     if (!widget->window)
 		return IntRect();
 
-	volatile double start = 0, layout = 0, paint = 0, blit = 0, inspector = 0; //
-	if(renderBenchmark) start = currentTime(); //
-
-    GraphicsContext ctx(widget->cr);
-	IntRect rect(m_webView->dirtyRegion());
+	IntRect rect;
 
-	//D(bug("WebViewPrivate::onExpose(%d,%d,%d,%d)\n", rect.x(), rect.y(), rect.width(), rect.height()));
-
-	if (frame->contentRenderer() && frame->view() && !rect.isEmpty() && !getv(widget->browser, MA_OWBBrowser_VideoElement))
+	if (frame->contentRenderer() && frame->view() && !m_damage.isEmpty() && !getv(widget->browser, MA_OWBBrowser_VideoElement))
 	{
-		bool coalesce = shouldCoalesce(rect);
-
-		if(renderBenchmark) { D(bug("dirtyRegion [%d %d %d %d] rects %d coalesce %d\n", rect.x(), rect.y(), rect.width(), rect.height(), m_dirtyRegions.size(), coalesce)); } //
+		WebViewPaintStatistics statistics;
+		statistics.frameNumber = m_paintStatistics.frameNumber + 1;
+		double start = currentTime();
 
-		if(coalesce)
-		{
-			if(renderBenchmark) { D(bug("*** Coalescing rects\n")); } //
+		// What the layout repaints is painted in this expose too.
+		frame->view()->updateLayoutAndStyleIfNeededRecursive();
 
-			clearDirtyRegion();
+		statistics.damageBounds = dirtyRegion();
+		statistics.damagedRects = m_damage.rectCount();
+		statistics.damagedArea = m_damage.area();
 
-			frame->view()->updateLayoutAndStyleIfNeededRecursive();
+		Vector<IntRect> rects = m_damage.takeRects();
+		Vector<IntRect> paintRects;
+		Path clipPath;
+		for(size_t i = 0; i < rects.size(); i++)
+		{
+			IntRect paintRect = intersection(rects[i], m_rect);
+			if (paintRect.isEmpty())
+				continue;
+			paintRects.append(paintRect);
+			clipPath.addRect(paintRect);
+			rect.unite(paintRect);
+			statistics.paintedArea += paintRect.width() * paintRect.height();
+		}
+		statistics.paintedRects = paintRects.size();
 
-			if(renderBenchmark)	{ layout = currentTime() - start; start = currentTime(); D(bug("Painting [%d %d %d %d]\n", rect.x(), rect.y(), rect.width(), rect.height())); } //
+		statistics.layoutTime = currentTime() - start;
+		start = currentTime();
 
+		if (!paintRects.isEmpty())
+		{
+			// The rects are painted in one context, clipped to all of them, and
+			// each is painted as its own dirty rect so that the render tree is
+			// only walked for what it damaged, not for their bounds.
+			GraphicsContext ctx(widget->cr);
 			ctx.save();
-			ctx.clip(rect);
-			frame->view()->paint(&ctx, rect);
+			ctx.clip(clipPath, RULE_NONZERO);
+			for(size_t i = 0; i < paintRects.size(); i++)
+				paintFrame(frame, ctx, paintRects[i]);
 			ctx.restore();
 
-			if(renderBenchmark)	{ paint = currentTime() - start; start = currentTime(); D(bug("Painting inspector [%d %d %d %d]\n", rect.x(), rect.y(), rect.width(), rect.height())); } //
-/*
-#if ENABLE(INSPECTOR)
-			ctx.save();
-			ctx.clip(rect);
-			frame->page()->inspectorController()->drawHighlight(ctx);
-			ctx.restore();
-#endif
+			statistics.paintTime = currentTime() - start;
+			start = currentTime();
 
-			if(renderBenchmark)	{ inspector = currentTime() - start; start = currentTime(); D(bug("Blitting [%d %d %d %d]\n", rect.x(), rect.y(), rect.width(), rect.height())); } //
-*/
-			updateView(widget, rect, false);
+			// Only the painted rects are copied and shown, not their bounds.
+			for(size_t i = 0; i < paintRects.size(); i++)
+				updateView(widget, paintRects[i], false);
+			for(size_t i = 0; i < paintRects.size(); i++)
+				updateView(widget, paintRects[i], true);
 
-			if(renderBenchmark)	{ blit = currentTime() - start; } //
+			statistics.blitTime = currentTime() - start;
 		}
-		else
-		{
-			if(renderBenchmark) { D(bug("*** Not Coalescing rects\n")); } //
-
-			Vector<IntRect> dirtyRegions = m_dirtyRegions; // urg
-			clearDirtyRegion();
-
-			frame->view()->updateLayoutAndStyleIfNeededRecursive();
 
-			if(renderBenchmark)	{ layout = currentTime() - start; start = currentTime(); } //
+		m_paintStatistics = statistics;
 
-			for(size_t i = 0; i < dirtyRegions.size(); i++)
-			{
-				if(renderBenchmark) { D(bug("Painting [%d %d %d %d]\n", dirtyRegions[i].x(), dirtyRegions[i].y(), dirtyRegions[i].width(), dirtyRegions[i].height())); }
-				ctx.save();
-				ctx.clip(dirtyRegions[i]);
-				frame->view()->paint(&ctx, dirtyRegions[i]);
-				ctx.restore();
-/*
-				ctx.save();
-				ctx.clip(dirtyRegions[i]);
-				frame->page()->inspectorController()->drawHighlight(ctx);
-				ctx.restore();
-*/
-				if(renderBenchmark)	{ paint += currentTime() - start; start = currentTime(); D(bug("Blitting [%d %d %d %d]\n", dirtyRegions[i].x(), dirtyRegions[i].y(), dirtyRegions[i].width(), dirtyRegions[i].height())); } //
+		if(renderBenchmark)
+		{
+			D(bug("WebViewPrivate::onExpose(%d,%d,%d,%d) frame %u\n  Damage: %u rects, %u pixels\n  Painted: %u rects, %u pixels\n  Layout: %f ms\n  Paint: %f ms\n  Blit: %f ms\n->Total: %f ms\n\n",
+				rect.x(), rect.y(), rect.width(), rect.height(),
+				statistics.frameNumber,
+				statistics.damagedRects, statistics.damagedArea,
+				statistics.paintedRects, statistics.paintedArea,
+				statistics.layoutTime*1000,
+				statistics.paintTime*1000,
+				statistics.blitTime*1000,
+				statistics.totalTime()*1000
+				));
+		}
+	}
 
-				updateView(widget, dirtyRegions[i], false);
+	return rect;
+}
 
-				if(renderBenchmark)	{ blit += currentTime() - start; start = currentTime(); } //
-			}
-		}
+void WebViewPrivate::paintFrame(Frame* frame, GraphicsContext& ctx, const IntRect& rect)
+{
+#if USE(TILED_BACKING_STORE)
+	// The tiles hold the contents; only the part of them in view is drawn.
+	if (TiledBackingStore* backingStore = frame->tiledBackingStore())
+	{
+		FrameView* view = frame->view();
+		backingStore->coverWithTilesIfNeeded();
 
-		updateView(widget, rect, true);
+		IntRect contentsRect = intersection(rect, IntRect(IntPoint(), view->visibleContentRect().size()));
+		contentsRect.move(view->scrollOffset());
+		if (!IntRect(IntPoint(), view->contentsSize()).contains(contentsRect))
+			ctx.fillRect(rect, view->baseBackgroundColor(), ColorSpaceDeviceRGB);
 
-		if(renderBenchmark) blit += currentTime() - start; //
-    }
+		ctx.save();
+		ctx.translate(-view->scrollX(), -view->scrollY());
+		backingStore->paint(&ctx, contentsRect);
+		ctx.restore();
 
-    if(renderBenchmark)
-	{
-		D(bug("WebViewPrivate::onExpose(%d,%d,%d,%d)\n  Layout: %f ms\n  Paint: %f ms\n  Inspector: %f ms\n  Blit: %f ms\n->Total: %f ms\n\n",
-			rect.x(), rect.y(), rect.width(), rect.height(),
-			layout*1000,
-			paint*1000,
-			inspector*1000,
-			blit*1000,
-			(layout + paint + blit + inspector)*1000
-			));
+		view->paintScrollbars(&ctx, rect);
 	}
+	else
+#endif
+	frame->view()->paint(&ctx, rect);
 
-	return rect;
+#if USE(ACCELERATED_COMPOSITING)
+	// The composited layers were left out of the page and go over it.
+	m_acceleratedCompositingContext->paintLayers(ctx, rect);
+#endif
 }
 
 static cairo_status_t writeFunction(void* output, const unsigned char* data, unsigned int length)
@@ -865,11 +888,17 @@ bool WebViewPrivate::screenshot(int &requested_width, int& requested_height, Vec
 
 					frame->view()->updateLayoutAndStyleIfNeededRecursive();
 					
+					// Composited layers are painted in place along with the page.
+					PaintBehavior paintBehavior = frame->view()->paintBehavior();
+					frame->view()->setPaintBehavior(paintBehavior | PaintBehaviorFlattenCompositingLayers);
+
 					ctx.save();
 					ctx.scale(FloatSize(scale_ratio, scale_ratio));
 					frame->view()->paintContents(&ctx, rect);
 					ctx.restore();
 
+					frame->view()->setPaintBehavior(paintBehavior);
+
 					cairo_surface_write_to_png_stream(surface, writeFunction, imageData);
 
 					return true;
@@ -909,9 +938,14 @@ bool WebViewPrivate::screenshot(String& path)
 
 					frame->view()->updateLayoutAndStyleIfNeededRecursive();
 					
+					PaintBehavior paintBehavior = frame->view()->paintBehavior();
+					frame->view()->setPaintBehavior(paintBehavior | PaintBehaviorFlattenCompositingLayers);
+
 					ctx.save();
 					frame->view()->paintContents(&ctx, rect);
-					ctx.restore();					
+					ctx.restore();
+
+					frame->view()->setPaintBehavior(paintBehavior);
 				    
 					cairo_surface_write_to_png(surface, path.utf8().data());
 
@@ -1217,6 +1251,7 @@ bool WebViewPrivate::onKeyDown(BalEventKey event)
 				pageCache()->setCapacity(savedPageCacheCapacity);
 				fontCache()->purgeInactiveFontData();
 				memoryCache()->pruneToPercentage(0.01f);
+				styleSheetContentsCache().clear();
 				gcController().garbageCollectNow();
 				WTF::releaseFastMallocFreeMemory(); // Does nothing with SYSTEM_MALLOC
 
@@ -1513,11 +1548,28 @@ void WebViewPrivate::scrollBackingStore(WebCore::FrameView* view, int dx, int dy
 		D(bug("  dirtyRegion [%d, %d, %d, %d]\n", m_webView->dirtyRegion().x, m_webView->dirtyRegion().y, m_webView->dirtyRegion().w, m_webView->dirtyRegion().h));
 	}
 
-	m_backingStoreDirtyRegion.move(dx, dy);
-	for(size_t i = 0; i < m_dirtyRegions.size(); i++)
+	m_damage.translate(IntSize(dx, dy));
+
+#if USE(TILED_BACKING_STORE)
+	// Pre-render the tiles in the direction the view is scrolling to.
+	if (TiledBackingStore* backingStore = view->frame().tiledBackingStore())
 	{
-		m_dirtyRegions[i].move(dx, dy);
+		backingStore->setTrajectoryVector(FloatPoint(-dx, -dy));
+		m_scrollEndTimer.startOneShot(0.25);
 	}
+#endif
+
+#if USE(ACCELERATED_COMPOSITING)
+	// The blit moves the composited layers with the page, but fixed ones stay
+	// where they were: both copies are painted again.
+	if (!m_acceleratedCompositingContext->compositedArea().isEmpty())
+	{
+		IntRect compositedArea = m_acceleratedCompositingContext->compositedArea();
+		m_webView->addToDirtyRegion(compositedArea);
+		compositedArea.move(dx, dy);
+		m_webView->addToDirtyRegion(compositedArea);
+	}
+#endif
 
     BalWidget* widget = m_webView->viewWindow();
     if (!widget || !widget->window)
@@ -1613,6 +1665,17 @@ void WebViewPrivate::closeWindowTimerFired(WebCore::Timer<WebViewPrivate>*)
     closeWindow();
 }
 
+#if USE(TILED_BACKING_STORE)
+void WebViewPrivate::scrollEndTimerFired(WebCore::Timer<WebViewPrivate>*)
+{
+	Frame* frame = core(m_webView->mainFrame());
+	if (!frame || !frame->tiledBackingStore())
+		return;
+	frame->tiledBackingStore()->setTrajectoryVector(FloatPoint());
+	frame->tiledBackingStore()->coverWithTilesIfNeeded();
+}
+#endif
+
 void WebViewPrivate::closeWindow()
 {
 	BalWidget* widget = m_webView->viewWindow();
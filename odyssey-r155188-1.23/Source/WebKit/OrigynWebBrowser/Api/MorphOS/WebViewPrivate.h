@@ -35,11 +35,15 @@
 #include "Frame.h"
 #include "BALBase.h"
 #include "cairo.h"
+#include "DamageTracker.h"
 #include "WebNotificationDelegate.h"
 #include "WebResourceLoadDelegate.h"
 #include "JSActionDelegate.h"
 #include "WebFrameLoadDelegate.h"
 #include "WTFString.h"
+#if USE(ACCELERATED_COMPOSITING)
+#include "AcceleratedCompositingContext.h"
+#endif
 
 class MorphOSWebNotificationDelegate : public WebNotificationDelegate
 {
@@ -179,57 +183,25 @@ public:
 		*/
     }
 
-    bool shouldCoalesce(WebCore::IntRect rect)
-    {
-	const size_t cRectThreshold = 10;
-	const float cWastedSpaceThreshold = 0.75f;
-	size_t count = m_dirtyRegions.size();
-	bool useUnionedRect = (count <= 1) || (count > cRectThreshold);
-	if (!useUnionedRect)
-	{
-	    // Attempt to guess whether or not we should use the unioned rect or the individual rects.
-	    // We do this by computing the percentage of "wasted space" in the union.  If that wasted space
-	    // is too large, then we will do individual rect painting instead.
-	    float unionPixels = (rect.width() * rect.height());
-	    float singlePixels = 0;
-	    for (size_t i = 0; i < count; ++i)
-		singlePixels += m_dirtyRegions[i].width() * m_dirtyRegions[i].height();
-	    float wastedSpace = 1 - (singlePixels / unionPixels);
-	    if (wastedSpace <= cWastedSpaceThreshold)
-		useUnionedRect = true;
-	}
-	return useUnionedRect;
-    }
-    
     void clearDirtyRegion()
     {
-	m_dirtyRegions.clear();
-        m_backingStoreDirtyRegion.setX(0);
-        m_backingStoreDirtyRegion.setY(0);
-        m_backingStoreDirtyRegion.setWidth(0);
-        m_backingStoreDirtyRegion.setHeight(0);
+        m_damage.clear();
     }
 
     BalRectangle dirtyRegion()
     {
-        BalRectangle rect = {m_backingStoreDirtyRegion.x(), m_backingStoreDirtyRegion.y(), m_backingStoreDirtyRegion.width(), m_backingStoreDirtyRegion.height()};
+        WebCore::IntRect bounds = m_damage.bounds();
+        BalRectangle rect = {bounds.x(), bounds.y(), bounds.width(), bounds.height()};
         return rect;
     }
 
     void addToDirtyRegion(const BalRectangle& dirtyRect)
     {
-        m_backingStoreDirtyRegion.unite(dirtyRect);
-	if(m_dirtyRegions.size() > 10)
-	{
-	    m_dirtyRegions.clear();
-	    m_dirtyRegions.append(m_backingStoreDirtyRegion);
-	}
-	else
-	{
-	    m_dirtyRegions.append(dirtyRect);
-	}
+        m_damage.add(dirtyRect);
     }
 
+    const WebViewPaintStatistics& lastPaintStatistics() const { return m_paintStatistics; }
+
     BalRectangle onExpose(BalEventExpose event);
     bool onKeyDown(BalEventKey event);
     bool onKeyUp(BalEventKey event);
@@ -263,21 +235,37 @@ public:
     
     bool screenshot(int &requested_width, int& requested_height, WTF::Vector<char> *imageData);
     bool screenshot(WTF::String& path);
+
+#if USE(ACCELERATED_COMPOSITING)
+    void setRootGraphicsLayer(WebCore::GraphicsLayer* layer) { m_acceleratedCompositingContext->setRootCompositingLayer(layer); }
+    void scheduleCompositingLayerFlush() { m_acceleratedCompositingContext->scheduleLayerFlush(); }
+#endif
     
  private:
+    void paintFrame(WebCore::Frame*, WebCore::GraphicsContext&, const WebCore::IntRect&);
     void updateView(BalWidget *widget, WebCore::IntRect rect, bool sync);
     void closeWindowTimerFired(WebCore::Timer<WebViewPrivate>*);
     void closeWindow();
+#if USE(TILED_BACKING_STORE)
+    void scrollEndTimerFired(WebCore::Timer<WebViewPrivate>*);
+#endif
     
     WebCore::IntRect m_rect;
     WebView *m_webView;
     bool isInitialized;
     
-    WTF::Vector<WebCore::IntRect> m_dirtyRegions;
-    WebCore::IntPoint m_backingStoreSize;
-    WebCore::IntRect m_backingStoreDirtyRegion;
+    WebCore::DamageTracker m_damage;
+    WebViewPaintStatistics m_paintStatistics;
 
     WebCore::Timer<WebViewPrivate> m_closeWindowTimer;
+#if USE(TILED_BACKING_STORE)
+    // Resets the tiles' trajectory once scrolling stops, so that they cover
+    // the area around the view again instead of the area ahead of it.
+    WebCore::Timer<WebViewPrivate> m_scrollEndTimer;
+#endif
+#if USE(ACCELERATED_COMPOSITING)
+    OwnPtr<AcceleratedCompositingContext> m_acceleratedCompositingContext;
+#endif
 
 };
 
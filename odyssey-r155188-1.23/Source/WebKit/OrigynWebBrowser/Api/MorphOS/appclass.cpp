@@ -71,6 +71,11 @@
 #include "FileIO.h"
 #include "HTMLCollection.h"
 #include "HTMLInputElement.h"
+#include "HTMLParserThread.h"
+#include "ImageDecodingThreadPool.h"
+#if USE(TILED_BACKING_STORE)
+#include "TileRasterizerThreadPool.h"
+#endif
 #include "ContextMenu.h"
 #include "ContextMenuController.h"
 #include "PluginDatabase.h"
@@ -1066,6 +1071,21 @@ void FreeWebKitLeakedObjects()
 	/* Seriously, sigh */
 	JSDOMWindow::commonVM()->heap.blockAllocator().quitFreeingThread();
 
+#if ENABLE(THREADED_HTML_PARSER)
+	/* The parser thread is a child process too, it must be gone before we are */
+	HTMLParserThread::shutdown();
+#endif
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+	/* Same for the image decoding threads */
+	ImageDecodingThreadPool::shutdown();
+#endif
+
+#if USE(TILED_BACKING_STORE)
+	/* And the tile rasterizing threads */
+	TileRasterizerThreadPool::shutdown();
+#endif
+
 	/* Yup, built as an indestructible singleton, sigh. ;) */
 	cookieManager().destroy();
 
@@ -139,6 +139,9 @@
 #define WebKitFrameFlatteningEnabledPreferenceKey "WebKitFrameSetFlatteningEnabled"
 #define WebKitWebGLEnabledPreferenceKey "WebKitWebGLEnabled"
 #define WebKitAcceleratedCompositingEnabledPreferenceKey "WebKitAcceleratedCompositingEnabled"
+#define WebKitTiledBackingStoreEnabledPreferenceKey "WebKitTiledBackingStoreEnabled"
+#define WebKitLayerDisplayListCachingEnabledPreferenceKey "WebKitLayerDisplayListCachingEnabled"
+#define WebKitAsynchronousImageDecodingEnabledPreferenceKey "WebKitAsynchronousImageDecodingEnabled"
 #define WebKitShowDebugBordersPreferenceKey "WebKitShowDebugBorders"
 #define WebKitShowRepaintCounterPreferenceKey "WebKitShowRepaintCounter"
 #define WebKitMemoryLimitPreferenceKey "WebKitMemoryLimit"
@@ -156,3 +159,4 @@
 #define WebKitShouldInvertColorsPreferenceKey "WebKitShouldInvertColors"
 #define WebKitMediaPlaybackRequiresUserGesturePreferenceKey "WebKitMediaPlaybackRequiresUserGesture"
 #define WebKitMediaPlaybackAllowsInlinePreferenceKey "WebKitMediaPlaybackAllowsInline"
+#define WebKitThreadedHTMLParserEnabledPreferenceKey "WebKitThreadedHTMLParserEnabled"
@@ -213,15 +213,19 @@ void WebPreferences::initializeDefaultSettings()
     m_privatePrefs[WebKitDNSPrefetchingEnabledPreferenceKey] = "0";
     m_privatePrefs[WebKitMemoryInfoEnabledPreferenceKey] = "0";
     m_privatePrefs[WebKitHyperlinkAuditingEnabledPreferenceKey] = "1";
-#if ENABLE(3D_RENDERING)
-    m_privatePrefs[WebKitAcceleratedCompositingEnabledPreferenceKey] = "1";
-#else
-    m_privatePrefs[WebKitAcceleratedCompositingEnabledPreferenceKey] = "0";
-#endif
+    m_privatePrefs[WebKitAcceleratedCompositingEnabledPreferenceKey] = "0"; // FALSE
+    m_privatePrefs[WebKitTiledBackingStoreEnabledPreferenceKey] = "0"; // FALSE
+    m_privatePrefs[WebKitLayerDisplayListCachingEnabledPreferenceKey] = "1"; // TRUE
+    m_privatePrefs[WebKitAsynchronousImageDecodingEnabledPreferenceKey] = "1"; // TRUE
     m_privatePrefs[WebKitShowDebugBordersPreferenceKey] = "0"; // FALSE
     m_privatePrefs[WebKitMemoryLimitPreferenceKey] = "0";
     m_privatePrefs[WebKitAllowScriptsToCloseWindowsPreferenceKey] = "1"; // TRUE
     m_privatePrefs[WebKitSpatialNavigationEnabledPreferenceKey] = "0"; // FALSE
+#if ENABLE(THREADED_HTML_PARSER)
+    m_privatePrefs[WebKitThreadedHTMLParserEnabledPreferenceKey] = "1"; // TRUE
+#else
+    m_privatePrefs[WebKitThreadedHTMLParserEnabledPreferenceKey] = "0"; // FALSE
+#endif
 
     m_privatePrefs[WebKitHixie76WebSocketProtocolEnabledPreferenceKey] = "0";
     m_privatePrefs[WebKitShouldInvertColorsPreferenceKey] = "0";
@@ -1102,6 +1106,36 @@ bool WebPreferences::acceleratedCompositingEnabled()
     return boolValueForKey(WebKitAcceleratedCompositingEnabledPreferenceKey);
 }
 
+void WebPreferences::setTiledBackingStoreEnabled(bool enable)
+{
+    setBoolValue(WebKitTiledBackingStoreEnabledPreferenceKey, enable);
+}
+
+bool WebPreferences::tiledBackingStoreEnabled()
+{
+    return boolValueForKey(WebKitTiledBackingStoreEnabledPreferenceKey);
+}
+
+void WebPreferences::setLayerDisplayListCachingEnabled(bool enable)
+{
+    setBoolValue(WebKitLayerDisplayListCachingEnabledPreferenceKey, enable);
+}
+
+bool WebPreferences::layerDisplayListCachingEnabled()
+{
+    return boolValueForKey(WebKitLayerDisplayListCachingEnabledPreferenceKey);
+}
+
+void WebPreferences::setAsynchronousImageDecodingEnabled(bool enable)
+{
+    setBoolValue(WebKitAsynchronousImageDecodingEnabledPreferenceKey, enable);
+}
+
+bool WebPreferences::asynchronousImageDecodingEnabled()
+{
+    return boolValueForKey(WebKitAsynchronousImageDecodingEnabledPreferenceKey);
+}
+
 void WebPreferences::setLocalStorageEnabled(bool enabled)
 {
     setBoolValue(WebKitLocalStorageEnabledPreferenceKey, enabled);
@@ -1198,6 +1232,16 @@ bool WebPreferences::mediaPlaybackAllowsInline()
 	return boolValueForKey(WebKitMediaPlaybackAllowsInlinePreferenceKey);
 }
 
+void WebPreferences::setThreadedHTMLParserEnabled(bool enabled)
+{
+	setBoolValue(WebKitThreadedHTMLParserEnabledPreferenceKey, enabled);
+}
+
+bool WebPreferences::threadedHTMLParserEnabled()
+{
+	return boolValueForKey(WebKitThreadedHTMLParserEnabledPreferenceKey);
+}
+
 
 void WebPreferences::setShouldDisplaySubtitles(bool enabled)
 {
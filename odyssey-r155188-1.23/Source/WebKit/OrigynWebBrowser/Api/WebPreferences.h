@@ -724,7 +724,11 @@ public:
     bool webGLEnabled();
 
     /*
-     * Enable or disable accelerated compositing
+     * Enable or disable accelerated compositing, off by default. Layers are
+     * composited in software, and fixed position elements get layers too.
+     * While a page has composited layers, the page below them is painted
+     * from the tiled backing store, even when tiledBackingStoreEnabled() is
+     * off, so that animating a layer does not repaint the page.
      */
     void setAcceleratedCompositingEnabled(bool);
 
@@ -733,6 +737,36 @@ public:
      */
     bool acceleratedCompositingEnabled();
 
+    /*
+     * Enable or disable painting the view from tiles rendered ahead of scrolling
+     */
+    void setTiledBackingStoreEnabled(bool);
+
+    /*
+     * Return whether the tiled backing store is enabled
+     */
+    bool tiledBackingStoreEnabled();
+
+    /*
+     * Enable or disable repainting transformed layers from recorded display lists
+     */
+    void setLayerDisplayListCachingEnabled(bool);
+
+    /*
+     * Return whether transformed layers are repainted from recorded display lists
+     */
+    bool layerDisplayListCachingEnabled();
+
+    /*
+     * Enable or disable decoding large images on background threads
+     */
+    void setAsynchronousImageDecodingEnabled(bool);
+
+    /*
+     * Return whether large images are decoded on background threads
+     */
+    bool asynchronousImageDecodingEnabled();
+
     // WebPreferences
 
     // This method accesses a different preference key than developerExtrasEnabled.
@@ -750,6 +784,13 @@ public:
 	virtual bool mediaPlaybackAllowsInline();
 	virtual void setMediaPlaybackAllowsInline(bool);
 
+    /**
+     * Tokenize, preload scan and XSS filter pages on the HTML parser thread.
+     * about:blank, javascript: and data: documents are always parsed on the main thread.
+     */
+	virtual bool threadedHTMLParserEnabled();
+	virtual void setThreadedHTMLParserEnabled(bool);
+
     /**
      * get the topic to notify a change on webPreference
      */
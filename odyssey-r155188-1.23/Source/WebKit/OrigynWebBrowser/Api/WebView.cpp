@@ -88,6 +88,9 @@
 #include <AXObjectCache.h>
 #endif
 #include <BackForwardController.h>
+#include <BitmapImage.h>
+#include <CachedImage.h>
+#include <CachedResourceLoader.h>
 #include <Chrome.h>
 #include <ContextMenu.h>
 #include <ContextMenuController.h>
@@ -97,6 +100,7 @@
 #include <Database.h>
 #include <DatabaseManager.h>
 #endif
+#include <DocumentStyleSheetCollection.h>
 #include <DragController.h>
 #include <DragSession.h>
 #include <DragData.h>
@@ -146,6 +150,7 @@
 #include <SecurityPolicy.h>
 #include <Settings.h>
 #include <SimpleFontData.h>
+#include <StyleSheetContentsCache.h>
 #include <TypingCommand.h>
 #include <WindowsKeyboardCodes.h>
 
@@ -156,6 +161,8 @@
 #include <CString.h>
 #include <WTFString.h>
 #include <InitializeThreading.h>
+#include <JSDOMWindow.h>
+#include <HeapStatistics.h>
 
 #include <wtf/unicode/Encoding.h>
 #include <wtf/HashSet.h>
@@ -686,6 +693,18 @@ void WebView::repaint(const WebCore::IntRect& windowRect, bool contentChanged, b
     d->repaint(windowRect, contentChanged, immediate, repaintContentOnly);
 }
 
+#if USE(ACCELERATED_COMPOSITING)
+void WebView::setRootGraphicsLayer(WebCore::GraphicsLayer* layer)
+{
+    d->setRootGraphicsLayer(layer);
+}
+
+void WebView::scheduleCompositingLayerFlush()
+{
+    d->scheduleCompositingLayerFlush();
+}
+#endif
+
 void WebView::deleteBackingStore()
 {
     //D(bug("WebView::deleteBackingStore\n"));
@@ -716,6 +735,85 @@ void WebView::clearDirtyRegion()
     d->clearDirtyRegion();
 }
 
+const WebViewPaintStatistics& WebView::lastPaintStatistics()
+{
+    return d->lastPaintStatistics();
+}
+
+std::vector<WebViewImageStatistics> WebView::imageStatistics()
+{
+    std::vector<WebViewImageStatistics> statistics;
+    if (!m_page)
+        return statistics;
+
+    for (Frame* frame = &m_page->mainFrame(); frame; frame = frame->tree().traverseNext()) {
+        Document* document = frame->document();
+        if (!document)
+            continue;
+        const CachedResourceLoader::DocumentResourceMap& resources = document->cachedResourceLoader()->allCachedResources();
+        for (CachedResourceLoader::DocumentResourceMap::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+            CachedResource* resource = it->value.get();
+            if (!resource || resource->type() != CachedResource::ImageResource)
+                continue;
+            CachedImage* cachedImage = static_cast<CachedImage*>(resource);
+            if (!cachedImage->hasImage() || !cachedImage->image()->isBitmapImage())
+                continue;
+            BitmapImage* image = static_cast<BitmapImage*>(cachedImage->image());
+
+            WebViewImageStatistics entry;
+            entry.url = resource->url().string().utf8().data();
+            entry.width = image->size().width();
+            entry.height = image->size().height();
+            entry.animates = image->canAnimate();
+            entry.decodedSize = image->decodedSize();
+            entry.timeToFirstPixels = image->timeToFirstPixels();
+            entry.frameDecodeWallTime = image->frameDecodeWallTime();
+            statistics.push_back(entry);
+        }
+    }
+    return statistics;
+}
+
+static void addStyleSheetStatistics(WebViewStyleSheetStatistics& statistics, const SharedStyleSheetStatistics& reused)
+{
+    statistics.reusedSheets += reused.sheets;
+    statistics.reusedBytes += reused.bytes;
+    statistics.savedParseTime += reused.parseTime;
+}
+
+WebViewStyleSheetStatistics WebView::styleSheetStatistics()
+{
+    WebViewStyleSheetStatistics statistics;
+    if (!m_page)
+        return statistics;
+
+    for (Frame* frame = &m_page->mainFrame(); frame; frame = frame->tree().traverseNext()) {
+        if (Document* document = frame->document())
+            addStyleSheetStatistics(statistics, document->styleSheetCollection()->reusedParsedStyleSheets());
+    }
+    return statistics;
+}
+
+WebViewStyleSheetStatistics WebView::sharedStyleSheetStatistics()
+{
+    WebViewStyleSheetStatistics statistics;
+    addStyleSheetStatistics(statistics, styleSheetContentsCache().statistics());
+    return statistics;
+}
+
+double WebView::parserMainThreadTime()
+{
+    double time = 0;
+    if (!m_page)
+        return time;
+
+    for (Frame* frame = &m_page->mainFrame(); frame; frame = frame->tree().traverseNext()) {
+        if (Document* document = frame->document())
+            time += document->parserMainThreadTime();
+    }
+    return time;
+}
+
 void WebView::scrollBackingStore(FrameView* frameView, int dx, int dy, const BalRectangle& scrollViewRect, const BalRectangle& clipRect)
 {
     //D(bug("WebView::scrollBackingStore\n"));
@@ -2765,6 +2863,23 @@ void WebView::notifyPreferencesChanged(WebPreferences* preferences)
 
     enabled = preferences->acceleratedCompositingEnabled();
     settings->setAcceleratedCompositingEnabled(enabled);
+#if USE(TEXTURE_MAPPER)
+    // Fixed position elements are moved by the compositor when scrolling.
+    settings->setAcceleratedCompositingForFixedPositionEnabled(enabled);
+#endif
+
+#if USE(TILED_BACKING_STORE)
+    enabled = preferences->tiledBackingStoreEnabled();
+    settings->setTiledBackingStoreEnabled(enabled);
+#endif
+
+    enabled = preferences->layerDisplayListCachingEnabled();
+    settings->setLayerDisplayListCachingEnabled(enabled);
+
+#if ENABLE(THREADED_IMAGE_DECODING)
+    enabled = preferences->asynchronousImageDecodingEnabled();
+    settings->setAsynchronousImageDecodingEnabled(enabled);
+#endif
 
     enabled = preferences->showDebugBorders();
     settings->setShowDebugBorders(enabled);
@@ -2806,6 +2921,11 @@ void WebView::notifyPreferencesChanged(WebPreferences* preferences)
     enabled = preferences->mediaPlaybackAllowsInline();
     settings->setMediaPlaybackAllowsInline(enabled);
 
+#if ENABLE(THREADED_HTML_PARSER)
+    enabled = preferences->threadedHTMLParserEnabled();
+    settings->setThreadedHTMLParser(enabled);
+#endif
+
 #if ENABLE(FULLSCREEN_API)
 	settings->setFullScreenEnabled(false);
 #endif
@@ -3138,6 +3258,23 @@ void WebView::setJavaScriptURLsAreAllowed(bool areAllowed)
   //    m_page->setJavaScriptURLsAreAllowed(areAllowed);
 }
 
+void WebView::setJavaScriptAllocationSamplingInterval(size_t samplingInterval)
+{
+    JSC::VM* vm = JSDOMWindow::commonVM();
+    JSC::JSLockHolder lock(vm);
+    vm->heap.allocationSampler().setSamplingInterval(samplingInterval);
+}
+
+bool WebView::writeJavaScriptAllocationSamples(const char* path)
+{
+    if (!path)
+        return false;
+
+    JSC::VM* vm = JSDOMWindow::commonVM();
+    JSC::JSLockHolder lock(vm);
+    return JSC::HeapStatistics::writeAllocationSamples(&vm->heap, path);
+}
+
 void WebView::resize(BalRectangle r)
 {
     d->resize(r);
@@ -47,6 +47,7 @@
 //#include "SuspendableTimer.h"
 #include "WebDragData.h"
 #include <string>
+#include <vector>
 
 class DOMDocument;
 class DOMNode;
@@ -85,6 +86,7 @@ namespace WebCore {
     class Application;
 	class Element;
     class FrameView;
+    class GraphicsLayer;
     class Image;
     class IntPoint;
     class IntRect;
@@ -137,6 +139,84 @@ enum ScrollDirection {
     Right
 };
 
+/**
+  * What one expose of the view painted, and how long each step took, in seconds.
+  * Damaged rects and area are counted before the rects are merged for painting.
+  */
+struct WebViewPaintStatistics {
+    WebViewPaintStatistics()
+        : frameNumber(0)
+        , damageBounds()
+        , damagedRects(0)
+        , damagedArea(0)
+        , paintedRects(0)
+        , paintedArea(0)
+        , layoutTime(0)
+        , paintTime(0)
+        , blitTime(0)
+    {
+    }
+
+    double totalTime() const { return layoutTime + paintTime + blitTime; }
+
+    unsigned frameNumber;
+    BalRectangle damageBounds;
+    unsigned damagedRects;
+    unsigned damagedArea;
+    unsigned paintedRects;
+    unsigned paintedArea;
+    double layoutTime;
+    double paintTime;
+    double blitTime;
+};
+
+/**
+  * How an image of the loaded documents decoded, in seconds.
+  * timeToFirstPixels runs from the first data handed to the image's first
+  * decoder to the first rows it wrote, 0 until then.
+  * animates tells whether it is an animation that is still playing.
+  * decodedSize is the memory its decoded frames hold now, in bytes.
+  * frameDecodeWallTime is the wall-clock time spent decoding all of its
+  * frames so far, on the main thread and the image decoding threads.
+  */
+struct WebViewImageStatistics {
+    WebViewImageStatistics()
+        : width(0)
+        , height(0)
+        , animates(false)
+        , decodedSize(0)
+        , timeToFirstPixels(0)
+        , frameDecodeWallTime(0)
+    {
+    }
+
+    std::string url;
+    unsigned width;
+    unsigned height;
+    bool animates;
+    unsigned decodedSize;
+    double timeToFirstPixels;
+    double frameDecodeWallTime;
+};
+
+/**
+  * Parsed style sheets that documents took from the shared style sheet cache
+  * instead of parsing them again: how many, their size in bytes and the
+  * parsing time that saved, in seconds.
+  */
+struct WebViewStyleSheetStatistics {
+    WebViewStyleSheetStatistics()
+        : reusedSheets(0)
+        , reusedBytes(0)
+        , savedParseTime(0)
+    {
+    }
+
+    unsigned reusedSheets;
+    size_t reusedBytes;
+    double savedParseTime;
+};
+
 class MouseEventPrivate;
 
 class WEBKIT_OWB_API WebView : public SharedObject<WebView> {
@@ -1169,6 +1249,21 @@ public:
      */
     void setJavaScriptURLsAreAllowed(bool areAllowed);
 
+    /**
+     * sample JavaScript heap allocations roughly every samplingInterval bytes,
+     * 0 stops sampling and discards the samples taken so far
+     */
+    static void setJavaScriptAllocationSamplingInterval(size_t samplingInterval);
+
+    /**
+     * write the sampled allocations, as a JSON calling-context tree, to path.
+     * Each node has the bytes allocated beneath it and the live bytes, the
+     * part of them still alive after the last garbage collection. Live bytes
+     * are counted where the objects were allocated, not where they are retained.
+     * @result whether the file was written.
+     */
+    static bool writeJavaScriptAllocationSamples(const char* path);
+
     /**
      *  give on expose event to the webview
      */
@@ -1263,6 +1358,38 @@ public:
      */
     void clearDirtyRegion();
 
+    /**
+     *  lastPaintStatistics
+     *  What the last expose of the view painted and how long it took.
+     */
+    const WebViewPaintStatistics& lastPaintStatistics();
+
+    /**
+     *  imageStatistics
+     *  How the bitmap images of the documents in the view decoded so far.
+     */
+    std::vector<WebViewImageStatistics> imageStatistics();
+
+    /**
+     *  styleSheetStatistics
+     *  The parsed style sheets the documents in the view reused.
+     */
+    WebViewStyleSheetStatistics styleSheetStatistics();
+
+    /**
+     *  sharedStyleSheetStatistics
+     *  The parsed style sheets all documents reused since the process started.
+     */
+    static WebViewStyleSheetStatistics sharedStyleSheetStatistics();
+
+    /**
+     *  parserMainThreadTime
+     *  How long parsing the HTML of the documents in the view kept the main
+     *  thread busy, in seconds, scripts run by the parser included. Compare it
+     *  with the WebKitThreadedHTMLParserEnabled preference off and on.
+     */
+    double parserMainThreadTime();
+
 
     /**
      *  get frame rect 
@@ -1661,6 +1788,7 @@ private:
     bool active();
     
 protected:
+    friend class AcceleratedCompositingContext;
     friend class WebApplicationClient;
     friend class WebApplicationManager;
     friend class WebChromeClient;
@@ -1728,6 +1856,19 @@ protected:
      */
     void repaint(const WebCore::IntRect&, bool contentChanged, bool immediate = false, bool repaintContentOnly = false);
 
+#if USE(ACCELERATED_COMPOSITING)
+    /**
+     * setRootGraphicsLayer
+     * Composite the given layer tree over the page, or stop compositing with 0.
+     */
+    void setRootGraphicsLayer(WebCore::GraphicsLayer*);
+
+    /**
+     * scheduleCompositingLayerFlush
+     */
+    void scheduleCompositingLayerFlush();
+#endif
+
     /**
      * interpret KeyEvent 
      */
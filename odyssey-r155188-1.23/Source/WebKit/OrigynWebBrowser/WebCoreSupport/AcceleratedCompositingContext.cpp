@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include "AcceleratedCompositingContext.h"
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "Frame.h"
+#include "FrameView.h"
+#include "GraphicsContext.h"
+#include "GraphicsLayerTextureMapper.h"
+#include "Settings.h"
+#include "TextureMapperLayer.h"
+#include "TiledBackingStore.h"
+#include "WebFrame.h"
+#include "WebView.h"
+
+using namespace WebCore;
+
+// Layers with running animations are composited again at this interval.
+static const double animationFrameInterval = 1.0 / 60;
+
+AcceleratedCompositingContext::AcceleratedCompositingContext(WebView* webView)
+    : m_webView(webView)
+    , m_layerFlushTimer(this, &AcceleratedCompositingContext::layerFlushTimerFired)
+    , m_enabledTiledBackingStore(false)
+{
+}
+
+AcceleratedCompositingContext::~AcceleratedCompositingContext()
+{
+}
+
+void AcceleratedCompositingContext::setRootCompositingLayer(GraphicsLayer* graphicsLayer)
+{
+    if (!graphicsLayer) {
+        m_layerFlushTimer.stop();
+        m_rootLayer.clear();
+        m_textureMapper.clear();
+        setTiledBackingStoreNeeded(false);
+
+        // The page paints what the layers covered again.
+        m_webView->repaint(m_compositedArea, true);
+        m_compositedArea = IntRect();
+        return;
+    }
+
+    if (!m_rootLayer) {
+        // Only holds the layer tree of the compositor, which clips it to the view.
+        m_rootLayer = GraphicsLayer::create(0, this);
+        m_rootLayer->setDrawsContent(false);
+        m_rootLayer->setMasksToBounds(false);
+
+        m_textureMapper = TextureMapper::create(TextureMapper::SoftwareMode);
+        toTextureMapperLayer(m_rootLayer.get())->setTextureMapper(m_textureMapper.get());
+    }
+
+    m_rootLayer->removeAllChildren();
+    m_rootLayer->addChild(graphicsLayer);
+    setTiledBackingStoreNeeded(true);
+    scheduleLayerFlush();
+}
+
+void AcceleratedCompositingContext::setTiledBackingStoreNeeded(bool needed)
+{
+#if USE(TILED_BACKING_STORE)
+    Frame* frame = core(m_webView->mainFrame());
+    if (!frame)
+        return;
+
+    if (needed) {
+        if (frame->tiledBackingStore())
+            return;
+        frame->setTiledBackingStoreEnabled(true);
+        m_enabledTiledBackingStore = true;
+        return;
+    }
+
+    if (!m_enabledTiledBackingStore)
+        return;
+    m_enabledTiledBackingStore = false;
+    if (!frame->settings().tiledBackingStoreEnabled())
+        frame->setTiledBackingStoreEnabled(false);
+#else
+    UNUSED_PARAM(needed);
+#endif
+}
+
+void AcceleratedCompositingContext::scheduleLayerFlush()
+{
+    if (!m_rootLayer || m_layerFlushTimer.isActive())
+        return;
+    m_layerFlushTimer.startOneShot(0);
+}
+
+void AcceleratedCompositingContext::notifyFlushRequired(const GraphicsLayer*)
+{
+    scheduleLayerFlush();
+}
+
+bool AcceleratedCompositingContext::flushPendingLayerChanges()
+{
+    Frame* frame = core(m_webView->mainFrame());
+    if (!frame || !frame->view())
+        return false;
+
+    FrameView* view = frame->view();
+    view->updateLayoutAndStyleIfNeededRecursive();
+
+    // The layout may have left compositing mode.
+    if (!m_rootLayer)
+        return false;
+
+    m_rootLayer->flushCompositingStateForThisLayerOnly();
+    return view->flushCompositingStateIncludingSubframes();
+}
+
+void AcceleratedCompositingContext::layerFlushTimerFired(Timer<AcceleratedCompositingContext>*)
+{
+    if (!flushPendingLayerChanges()) {
+        // Some frame could not be laid out yet.
+        if (m_rootLayer)
+            m_layerFlushTimer.startOneShot(animationFrameInterval);
+        return;
+    }
+
+    TextureMapperLayer* rootLayer = toTextureMapperLayer(m_rootLayer.get());
+    rootLayer->applyAnimationsRecursively();
+
+    // Both where the layers were and where they are now are painted again:
+    // the page below them from the tiled backing store, the layers from their
+    // tiles. Neither is painted from the render tree unless it changed.
+    IntRect compositedArea = enclosingIntRect(rootLayer->paintedBoundsIncludingDescendants());
+    IntRect damage = unionRect(m_compositedArea, compositedArea);
+    m_compositedArea = compositedArea;
+    if (!damage.isEmpty())
+        m_webView->repaint(damage, true);
+
+    if (rootLayer->descendantsOrSelfHaveRunningAnimations())
+        m_layerFlushTimer.startOneShot(animationFrameInterval);
+}
+
+void AcceleratedCompositingContext::paintLayers(GraphicsContext& context, const IntRect& clipRect)
+{
+    if (!m_rootLayer || !clipRect.intersects(m_compositedArea))
+        return;
+
+    // The animated values were applied when the layers were flushed, so what
+    // is drawn matches the area that was invalidated.
+    m_textureMapper->setGraphicsContext(&context);
+    m_textureMapper->setImageInterpolationQuality(context.imageInterpolationQuality());
+    m_textureMapper->setTextDrawingMode(context.textDrawingMode());
+    m_textureMapper->beginPainting();
+    m_textureMapper->beginClip(TransformationMatrix(), clipRect);
+    toTextureMapperLayer(m_rootLayer.get())->paint();
+    m_textureMapper->endClip();
+    m_textureMapper->endPainting();
+    m_textureMapper->setGraphicsContext(0);
+}
+
+#endif // USE(ACCELERATED_COMPOSITING)
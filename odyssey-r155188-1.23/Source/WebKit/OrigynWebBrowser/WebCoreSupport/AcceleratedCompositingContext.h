@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2013 Fabien Coeurjoly. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef AcceleratedCompositingContext_h
+#define AcceleratedCompositingContext_h
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "GraphicsLayer.h"
+#include "GraphicsLayerClient.h"
+#include "IntRect.h"
+#include "TextureMapper.h"
+#include "Timer.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+
+class WebView;
+
+namespace WebCore {
+class GraphicsContext;
+}
+
+// Composites the layers the RenderLayerCompositor creates for transformed,
+// animated and fixed position elements over the rest of the page, on the CPU.
+//
+// Each layer keeps its content in TextureMapper tiles, which are Cairo image
+// surfaces painted when the layer tree is flushed. Moving a layer, changing
+// its transform or its opacity, and running animations of these properties
+// only composites the tiles again; the content of the layer is not painted.
+// The page below the layers is drawn from the tiled backing store while in
+// compositing mode, so such frames don't paint it again either.
+class AcceleratedCompositingContext : public WebCore::GraphicsLayerClient {
+    WTF_MAKE_NONCOPYABLE(AcceleratedCompositingContext); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<AcceleratedCompositingContext> create(WebView* webView)
+    {
+        return adoptPtr(new AcceleratedCompositingContext(webView));
+    }
+    virtual ~AcceleratedCompositingContext();
+
+    // Pass 0 to leave compositing mode.
+    void setRootCompositingLayer(WebCore::GraphicsLayer*);
+    bool enabled() const { return m_rootLayer; }
+
+    void scheduleLayerFlush();
+
+    // Draws the layers over the part of the view in |clipRect|, once the page
+    // below them has been painted into the context.
+    void paintLayers(WebCore::GraphicsContext&, const WebCore::IntRect& clipRect);
+
+    // The part of the view the layers covered when they were last flushed.
+    const WebCore::IntRect& compositedArea() const { return m_compositedArea; }
+
+private:
+    explicit AcceleratedCompositingContext(WebView*);
+
+    void layerFlushTimerFired(WebCore::Timer<AcceleratedCompositingContext>*);
+    bool flushPendingLayerChanges();
+    void setTiledBackingStoreNeeded(bool);
+
+    // GraphicsLayerClient
+    virtual void notifyAnimationStarted(const WebCore::GraphicsLayer*, double) { }
+    virtual void notifyFlushRequired(const WebCore::GraphicsLayer*);
+    virtual void paintContents(const WebCore::GraphicsLayer*, WebCore::GraphicsContext&, WebCore::GraphicsLayerPaintingPhase, const WebCore::IntRect&) { }
+
+    WebView* m_webView;
+    OwnPtr<WebCore::GraphicsLayer> m_rootLayer;
+    OwnPtr<WebCore::TextureMapper> m_textureMapper;
+    WebCore::IntRect m_compositedArea;
+    WebCore::Timer<AcceleratedCompositingContext> m_layerFlushTimer;
+    bool m_enabledTiledBackingStore; // Whether compositing turned the store on, rather than the settings.
+};
+
+#endif // USE(ACCELERATED_COMPOSITING)
+
+#endif // AcceleratedCompositingContext_h
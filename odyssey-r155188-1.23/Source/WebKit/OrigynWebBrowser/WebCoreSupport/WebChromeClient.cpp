@@ -423,6 +423,22 @@ void WebChromeClient::scroll(const IntSize& delta, const IntRect& scrollViewRect
     m_webView->scrollBackingStore(core(m_webView->topLevelFrame())->view(), delta.width(), delta.height(), scrollViewRect, clipRect);
 }
 
+#if USE(TILED_BACKING_STORE)
+void WebChromeClient::delegatedScrollRequested(const IntPoint&)
+{
+    // The view scrolls itself and never delegates scrolling to us.
+    ASSERT_NOT_REACHED();
+}
+
+IntRect WebChromeClient::visibleRectForTiledBackingStore() const
+{
+    Frame* frame = core(m_webView->topLevelFrame());
+    if (!frame || !frame->view())
+        return IntRect();
+    return frame->view()->visibleContentRect();
+}
+#endif
+
 IntRect WebChromeClient::rootViewToScreen(const IntRect& rect) const
 {
     return rect;
@@ -646,14 +662,22 @@ void WebChromeClient::scrollbarsModeDidChange() const
 #if USE(ACCELERATED_COMPOSITING)
 void WebChromeClient::scheduleCompositingLayerFlush()
 {
+    m_webView->scheduleCompositingLayerFlush();
 }
 
 void WebChromeClient::attachRootGraphicsLayer(WebCore::Frame* frame, WebCore::GraphicsLayer* layer)
 {
+    m_webView->setRootGraphicsLayer(layer);
 }
 
 void WebChromeClient::setNeedsOneShotDrawingSynchronization()
 {
+    // The layers are composited in the same expose as the page below them.
+}
+
+ChromeClient::CompositingTriggerFlags WebChromeClient::allowedCompositingTriggers() const
+{
+    return ThreeDTransformTrigger | AnimationTrigger | AnimatedOpacityTrigger;
 }
 #endif
 
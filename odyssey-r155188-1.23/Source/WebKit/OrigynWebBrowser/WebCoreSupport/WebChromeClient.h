@@ -109,6 +109,10 @@ public:
     virtual void invalidateContentsAndRootView(const WebCore::IntRect&, bool);
     virtual void invalidateContentsForSlowScroll(const WebCore::IntRect&, bool);
     virtual void scroll(const WebCore::IntSize& scrollDelta, const WebCore::IntRect& rectToScroll, const WebCore::IntRect& clipRect);
+#if USE(TILED_BACKING_STORE)
+    virtual void delegatedScrollRequested(const WebCore::IntPoint&);
+    virtual WebCore::IntRect visibleRectForTiledBackingStore() const;
+#endif
     
     virtual WebCore::IntPoint screenToRootView(const WebCore::IntPoint& p) const ;
     virtual WebCore::IntRect rootViewToScreen(const WebCore::IntRect& r) const;
@@ -166,6 +170,9 @@ public:
     // Sets a flag to specify that the view needs to be updated, so we need
     // to do an eager layout before the drawing.
     virtual void scheduleCompositingLayerFlush();
+    // Layers are composited in software: only those for 3D transforms and
+    // for animations of transforms and opacity are worth their memory.
+    virtual CompositingTriggerFlags allowedCompositingTriggers() const;
 #endif
 
     virtual void scrollRectIntoView(const WebCore::IntRect&) const {}
@@ -120,6 +120,10 @@ if(ENABLE_TILED_BACKING_STORE)
     add_definitions(-DENABLE_TILED_BACKING_STORE=1)
 endif(ENABLE_TILED_BACKING_STORE)
 
+if(ENABLE_ACCELERATED_COMPOSITING)
+    add_definitions(-DENABLE_ACCELERATED_COMPOSITING=1)
+endif(ENABLE_ACCELERATED_COMPOSITING)
+
 
 
 if(ENABLE_FULLSCREEN_API)
@@ -233,6 +233,12 @@ if(ENABLE_INSPECTOR)
     )
 endif(ENABLE_INSPECTOR)
 
+if(ENABLE_ACCELERATED_COMPOSITING)
+    list(APPEND WEBCORE_INCLUDE_DIRS
+        ${OWB_SOURCE_DIR}/Source/WebCore/platform/graphics/texmap
+    )
+endif(ENABLE_ACCELERATED_COMPOSITING)
+
 if(ENABLE_JIT_JSC OR ENABLE_JIT_REGEXP)
     list(APPEND JAVASCRIPTCORE_INCLUDE_DIRS
         ${OWB_SOURCE_DIR}/Source/JavaScriptCore/assembler